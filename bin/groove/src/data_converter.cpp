@@ -89,19 +89,22 @@ convert_json_input(const ModelConfig &modelConfig, const std::filesystem::path &
     //
     switch (modelConfig.keyType) {
         case groove_data::DataKeyType::KEY_CATEGORY: {
-            auto createFrameResult = groove_data::CategoryFrame::create(table, keyFieldIndex, valueColumns);
+            auto createFrameResult = groove_data::CategoryFrame::create(table, keyFieldIndex, valueColumns,
+                groove_data::KeyOrdering::ORDERING_SORT);
             if (createFrameResult.isStatus())
                 return createFrameResult.getStatus();
             return std::static_pointer_cast<groove_data::BaseFrame>(createFrameResult.getResult());
         }
         case groove_data::DataKeyType::KEY_DOUBLE: {
-            auto createFrameResult = groove_data::DoubleFrame::create(table, keyFieldIndex, valueColumns);
+            auto createFrameResult = groove_data::DoubleFrame::create(table, keyFieldIndex, valueColumns,
+                groove_data::KeyOrdering::ORDERING_SORT);
             if (createFrameResult.isStatus())
                 return createFrameResult.getStatus();
             return std::static_pointer_cast<groove_data::BaseFrame>(createFrameResult.getResult());
         }
         case groove_data::DataKeyType::KEY_INT64: {
-            auto createFrameResult = groove_data::Int64Frame::create(table, keyFieldIndex, valueColumns);
+            auto createFrameResult = groove_data::Int64Frame::create(table, keyFieldIndex, valueColumns,
+                groove_data::KeyOrdering::ORDERING_SORT);
             if (createFrameResult.isStatus())
                 return createFrameResult.getStatus();
             return std::static_pointer_cast<groove_data::BaseFrame>(createFrameResult.getResult());
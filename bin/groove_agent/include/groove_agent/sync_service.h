@@ -80,7 +80,6 @@ private:
     std::shared_ptr<groove_model::GrooveModel> m_model;
     absl::flat_hash_map<std::string,groove_model::ColumnDef>::const_iterator m_currColumn;
     std::forward_list<std::shared_ptr<groove_data::BaseFrame>> m_frames;
-    std::shared_ptr<const arrow::Buffer> m_buffer;
     groove_sync::DataFrame m_outgoing;
 
     bool startNextColumn();
@@ -6,6 +6,7 @@
 #include <groove_data/category_frame.h>
 #include <groove_data/double_frame.h>
 #include <groove_data/int64_frame.h>
+#include <groove_data/table_utils.h>
 #include <groove_model/groove_database.h>
 #include <tempo_config/config_serde.h>
 #include <tempo_config/parse_config.h>
@@ -236,48 +237,57 @@ MountService::PutData(
     //
     auto keyFieldIndex = request->key_index();
 
+    // the request is owned by grpc and is only valid until the reactor finishes, so the frame
+    // bytes are copied into a shared string which the decoded frame keeps alive. the frame keys
+    // come from the client, so they are validated rather than trusted to be sorted and unique.
     std::shared_ptr<groove_data::BaseFrame> frame;
     switch (request->frame_case()) {
         case groove_mount::PutDataRequest::kCat: {
-            auto makeTableResult = groove_data::make_table(std::make_shared<const std::string>(request->cat()));
+            auto makeTableResult = groove_data::make_table(
+                std::make_shared<const std::string>(request->cat()));
             if (makeTableResult.isStatus()) {
                 reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to parse category frame"));
                 return reactor;
             }
             auto table = makeTableResult.getResult();
-            auto createFrameResult = groove_data::CategoryFrame::create(table, keyFieldIndex, valueColumns);
+            auto createFrameResult = groove_data::CategoryFrame::create(table, keyFieldIndex, valueColumns,
+                groove_data::KeyOrdering::ORDERING_VALIDATE);
             if (createFrameResult.isStatus()) {
-                reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to parse category frame"));
+                reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid category frame"));
                 return reactor;
             }
             frame = createFrameResult.getResult();
             break;
         }
         case groove_mount::PutDataRequest::kDbl: {
-            auto makeTableResult = groove_data::make_table(std::make_shared<const std::string>(request->dbl()));
+            auto makeTableResult = groove_data::make_table(
+                std::make_shared<const std::string>(request->dbl()));
             if (makeTableResult.isStatus()) {
                 reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to parse double frame"));
                 return reactor;
             }
             auto table = makeTableResult.getResult();
-            auto createFrameResult = groove_data::DoubleFrame::create(table, keyFieldIndex, valueColumns);
+            auto createFrameResult = groove_data::DoubleFrame::create(table, keyFieldIndex, valueColumns,
+                groove_data::KeyOrdering::ORDERING_VALIDATE);
             if (createFrameResult.isStatus()) {
-                reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to parse double frame"));
+                reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid double frame"));
                 return reactor;
             }
             frame = createFrameResult.getResult();
             break;
         }
         case groove_mount::PutDataRequest::kI64: {
-            auto makeTableResult = groove_data::make_table(std::make_shared<const std::string>(request->i64()));
+            auto makeTableResult = groove_data::make_table(
+                std::make_shared<const std::string>(request->i64()));
             if (makeTableResult.isStatus()) {
                 reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to parse int64 frame"));
                 return reactor;
             }
             auto table = makeTableResult.getResult();
-            auto createFrameResult = groove_data::Int64Frame::create(table, keyFieldIndex, valueColumns);
+            auto createFrameResult = groove_data::Int64Frame::create(table, keyFieldIndex, valueColumns,
+                groove_data::KeyOrdering::ORDERING_VALIDATE);
             if (createFrameResult.isStatus()) {
-                reactor->Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to parse int64 frame"));
+                reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid int64 frame"));
                 return reactor;
             }
             frame = createFrameResult.getResult();
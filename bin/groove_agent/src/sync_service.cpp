@@ -1,5 +1,6 @@
 
 #include <groove_agent/sync_service.h>
+#include <groove_data/table_utils.h>
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
 #include <groove_model/page_traits.h>
@@ -577,34 +578,6 @@ DataFrameStream::startNextColumn()
     return true;
 }
 
-std::shared_ptr<const arrow::Buffer> make_buffer_from_frame(std::shared_ptr<groove_data::BaseFrame> frame)
-{
-    auto table = frame->getUnderlyingTable();
-    auto schema = table->schema();
-
-    auto createBufResult = arrow::io::BufferOutputStream::Create();
-    if (!createBufResult.ok())
-        return {};
-    auto stream = *createBufResult;
-
-    auto makeWriterResult = arrow::ipc::MakeStreamWriter(stream, schema);
-    if (!makeWriterResult.ok())
-        return {};
-    auto writer = *makeWriterResult;
-
-    arrow::Status status;
-    status = writer->WriteTable(*table);
-    if (!status.ok())
-        return {};
-    status = writer->Close();
-    if (!status.ok())
-        return {};
-    auto finishStreamResult = stream->Finish();
-    if (!finishStreamResult.ok())
-        return {};
-    return *finishStreamResult;
-}
-
 bool
 DataFrameStream::startNextFrame()
 {
@@ -637,29 +610,26 @@ DataFrameStream::startNextFrame()
         valueField->set_fid_index(vector->getFidFieldIndex());
     }
 
-    // serialize the frame
-    m_buffer = make_buffer_from_frame(frame);
-    if (m_buffer == nullptr) {
-        Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to create buffer"));
-        return false;
-    }
-
-    // NOTE: we hold buffer reference for lifetime of this string so its ok to not copy
-    std::string frameBytes((const char *) m_buffer->data(), m_buffer->size());
-
+    // serialize the frame directly into the outgoing message
+    std::string *frameBytes;
     switch (frame->getFrameType()) {
         case groove_data::DataFrameType::FRAME_TYPE_CATEGORY:
-            m_outgoing.set_cat(std::move(frameBytes));
+            frameBytes = m_outgoing.mutable_cat();
             break;
         case groove_data::DataFrameType::FRAME_TYPE_DOUBLE:
-            m_outgoing.set_dbl(std::move(frameBytes));
+            frameBytes = m_outgoing.mutable_dbl();
             break;
         case groove_data::DataFrameType::FRAME_TYPE_INT64:
-            m_outgoing.set_i64(std::move(frameBytes));
+            frameBytes = m_outgoing.mutable_i64();
             break;
         default:
             TU_UNREACHABLE();
     }
+    auto writeStatus = groove_data::write_table(frame->getUnderlyingTable(), frameBytes);
+    if (writeStatus.notOk()) {
+        Finish(grpc::Status(grpc::StatusCode::INTERNAL, "failed to create buffer"));
+        return false;
+    }
 
     StartWrite(&m_outgoing);
     return true;
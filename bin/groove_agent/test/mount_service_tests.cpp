@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <grpcpp/grpcpp.h>
+
+#include <groove_agent/mount_service.h>
+#include <groove_agent/storage_supervisor.h>
+#include <groove_data/table_utils.h>
+#include <groove_model/groove_database.h>
+#include <groove_model/schema_column.h>
+#include <groove_model/schema_model.h>
+#include <groove_model/schema_state.h>
+#include <tempo_utils/tempdir_maker.h>
+
+class MountServiceTest : public ::testing::Test {
+protected:
+    std::filesystem::path dbPath;
+    std::shared_ptr<groove_model::GrooveDatabase> db;
+    std::unique_ptr<StorageSupervisor> supervisor;
+    std::unique_ptr<MountService> mountService;
+    std::unique_ptr<grpc::Server> server;
+    std::unique_ptr<groove_mount::MountService::Stub> stub;
+    tempo_utils::Url datasetUrl;
+
+    void SetUp() override
+    {
+        tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+        ASSERT_TRUE (tempdirMaker.isValid());
+        dbPath = tempdirMaker.getTempdir();
+
+        using namespace groove_model;
+        DatabaseOptions options;
+        options.modelsDirectory = dbPath;
+        db = std::make_shared<groove_model::GrooveDatabase>(options);
+        ASSERT_TRUE (db->configure().isOk());
+        supervisor = std::make_unique<StorageSupervisor>(db.get());
+
+        auto createCollectionResult = supervisor->createEphemeralCollection("test");
+        ASSERT_TRUE (createCollectionResult.isResult());
+        auto collectionUrl = createCollectionResult.getResult()->getCollectionUrl();
+
+        SchemaState state;
+
+        SchemaModel *model;
+        TU_ASSIGN_OR_RAISE (model, state.putModel("foo",
+            ModelKeyType::Double, ModelKeyCollation::Indexed));
+
+        SchemaColumn *column;
+        TU_ASSIGN_OR_RAISE (column, state.appendColumn("foo1",
+            ColumnValueType::Double, ColumnValueFidelity::OnlyValidValue));
+
+        TU_RAISE_IF_NOT_OK (model->appendColumn(column));
+
+        auto toSchemaResult = state.toSchema();
+        ASSERT_TRUE (toSchemaResult.isResult());
+        datasetUrl = collectionUrl.traverse(tempo_utils::UrlPathPart("test"));
+        ASSERT_TRUE (supervisor->createDataset(datasetUrl, toSchemaResult.getResult()).isResult());
+
+        // serve the mount service in process, so requests do not need a listening port
+        mountService = std::make_unique<MountService>(
+            tempo_utils::Url::fromString("unix:///mount.sock"), supervisor.get(), "test");
+        grpc::ServerBuilder builder;
+        builder.RegisterService(mountService.get());
+        server = builder.BuildAndStart();
+        ASSERT_TRUE (server != nullptr);
+        stub = groove_mount::MountService::NewStub(server->InProcessChannel(grpc::ChannelArguments()));
+    }
+
+    void TearDown() override
+    {
+        if (server != nullptr) {
+            server->Shutdown();
+        }
+        std::filesystem::remove_all(dbPath);
+    }
+
+    groove_mount::PutDataRequest makeRequest(const std::vector<double> &keys)
+    {
+        auto schema = arrow::schema({
+            arrow::field("", arrow::float64()),
+            arrow::field("foo1", arrow::float64()),
+            arrow::field("", arrow::boolean())});
+
+        arrow::DoubleBuilder keyBuilder;
+        arrow::DoubleBuilder valBuilder;
+        arrow::BooleanBuilder fidBuilder;
+        for (auto key : keys) {
+            TU_ASSERT (keyBuilder.Append(key).ok());
+            TU_ASSERT (valBuilder.Append(key * 2).ok());
+            TU_ASSERT (fidBuilder.Append(false).ok());
+        }
+        auto table = arrow::Table::Make(schema,
+            {*keyBuilder.Finish(), *valBuilder.Finish(), *fidBuilder.Finish()}, keys.size());
+
+        groove_mount::PutDataRequest request;
+        request.set_dataset_uri(datasetUrl.toString());
+        request.set_model_id("foo");
+        request.set_key_index(0);
+        auto *valueField = request.add_value_fields();
+        valueField->set_val_index(1);
+        valueField->set_fid_index(2);
+        TU_ASSERT (groove_data::write_table(table, request.mutable_dbl()).isOk());
+        return request;
+    }
+};
+
+TEST_F(MountServiceTest, PutDataWithOrderedKeys)
+{
+    auto request = makeRequest({0, 1, 2});
+
+    grpc::ClientContext context;
+    groove_mount::PutDataResult result;
+    auto status = stub->PutData(&context, request, &result);
+    ASSERT_TRUE (status.ok()) << status.error_message();
+    ASSERT_EQ (0, result.failed_vectors_size());
+}
+
+TEST_F(MountServiceTest, PutDataRejectsUnorderedKeys)
+{
+    auto request = makeRequest({2, 0, 1});
+
+    grpc::ClientContext context;
+    groove_mount::PutDataResult result;
+    auto status = stub->PutData(&context, request, &result);
+    ASSERT_EQ (grpc::StatusCode::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST_F(MountServiceTest, PutDataRejectsDuplicateKeys)
+{
+    auto request = makeRequest({0, 1, 1});
+
+    grpc::ClientContext context;
+    groove_mount::PutDataResult result;
+    auto status = stub->PutData(&context, request, &result);
+    ASSERT_EQ (grpc::StatusCode::INVALID_ARGUMENT, status.error_code());
+}
@@ -3,11 +3,14 @@
 
 #include <arrow/array.h>
 #include <arrow/chunked_array.h>
+#include <arrow/memory_pool.h>
+#include <arrow/result.h>
 
 #include <tempo_utils/integer_types.h>
 #include <tempo_utils/log_stream.h>
 
 #include "data_types.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -69,22 +72,37 @@ namespace groove_data {
         Category &value)
     {
         for (const auto &chunk : chunkedArray->chunks()) {
-            auto larray = std::static_pointer_cast<arrow::ListArray>(chunk);
-            if (index < larray->length()) {
-                auto sarray = std::static_pointer_cast<arrow::StringArray>(larray->values());
-                auto offset = larray->value_offset(index);
-                auto length = larray->value_length(index);
-                std::vector<std::string> path;
-                for (int i = 0; i < length; i++) {
-                    path.push_back(std::string(sarray->Value(offset + i)));
-                }
-                value = Category(path);
+            if (index < chunk->length()) {
+                value = ArraySpan<Category>::fromArray(*chunk, 0).at(index);
                 return true;
             }
-            index -= larray->length();
+            index -= chunk->length();
         }
         return false;
     };
+
+    /**
+     * Returns true if type is a category key type, either list<utf8> or a list of dictionary
+     * encoded segments list<dictionary<int32,utf8>>.
+     *
+     * @param type
+     * @return
+     */
+    bool is_category_datatype(const std::shared_ptr<arrow::DataType> &type);
+
+    /**
+     * Dictionary encodes the segments of a list<utf8> category array. All chunks share a single
+     * dictionary which is sorted and flagged as ordered, so within the array segment codes compare
+     * the same way as the segments they encode. If the array is already dictionary encoded then
+     * it is returned unchanged.
+     *
+     * @param chunkedArray
+     * @param pool
+     * @return
+     */
+    arrow::Result<std::shared_ptr<arrow::ChunkedArray>> dictionary_encode_categories(
+        std::shared_ptr<arrow::ChunkedArray> chunkedArray,
+        arrow::MemoryPool *pool = arrow::default_memory_pool());
 }
 
 #endif // GROOVE_DATA_ARRAY_UTILS_H
\ No newline at end of file
@@ -1,25 +1,81 @@
 #ifndef GROOVE_DATA_CATEGORY_BUILDER_H
 #define GROOVE_DATA_CATEGORY_BUILDER_H
 
+#include <span>
+#include <string_view>
+
 #include <arrow/builder.h>
 
 #include "category.h"
+#include "compact_category.h"
+#include "data_types.h"
 
 namespace groove_data {
 
     class CategoryBuilder {
 
     public:
-        CategoryBuilder();
+        explicit CategoryBuilder(
+            CategoryEncoding encoding = CategoryEncoding::ENCODING_PLAIN,
+            arrow::MemoryPool *pool = arrow::system_memory_pool());
+
+        CategoryEncoding getEncoding() const;
+
+        arrow::Status Reserve(tu_int64 numCategories, tu_int64 numSegments, tu_int64 numBytes);
+
+        arrow::Status Append(const Category &category);
+        arrow::Status Append(const CompactCategory &category);
+
+        /**
+         * Appends many categories at once. Category i consists of the segments in the range
+         * [categoryOffsets[i], categoryOffsets[i + 1]), so categoryOffsets holds one more entry
+         * than the number of categories appended. Capacity for all categories and segments is
+         * reserved before any data is copied.
+         *
+         * @param segments
+         * @param categoryOffsets
+         * @return
+         */
+        arrow::Status AppendValues(
+            std::span<const std::string_view> segments,
+            std::span<const tu_int32> categoryOffsets);
+
+        /**
+         * Appends many categories at once, where segment j is the byte range of data starting at
+         * segmentOffsets[j] with length segmentLengths[j]. Categories are delimited by
+         * categoryOffsets as in the string_view overload. Returns Invalid if any segment does
+         * not lie within data.
+         *
+         * @param data
+         * @param segmentOffsets
+         * @param segmentLengths
+         * @param categoryOffsets
+         * @return
+         */
+        arrow::Status AppendValues(
+            std::string_view data,
+            std::span<const tu_int32> segmentOffsets,
+            std::span<const tu_int32> segmentLengths,
+            std::span<const tu_int32> categoryOffsets);
 
-        arrow::Status Append(const Category category);
         arrow::Result<std::shared_ptr<arrow::Array>> Finish();
 
-        static std::shared_ptr<arrow::DataType> makeDatatype();
+        static std::shared_ptr<arrow::DataType> makeDatatype(
+            CategoryEncoding encoding = CategoryEncoding::ENCODING_PLAIN);
 
     private:
+        CategoryEncoding m_encoding;
+        arrow::MemoryPool *m_pool;
         std::shared_ptr<arrow::StringBuilder> m_str;
         std::unique_ptr<arrow::ListBuilder> m_cat;
+        std::vector<std::string_view> m_segments;
+        std::string m_scratch;
+
+        template<typename SegmentAt>
+        arrow::Status appendBulk(
+            tu_int64 numSegments,
+            std::span<const tu_int32> categoryOffsets,
+            SegmentAt segmentAt);
     };
 
 }
@@ -7,6 +7,7 @@
 #include "base_frame.h"
 #include "base_vector.h"
 #include "data_types.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -23,9 +24,11 @@ namespace groove_data {
         CategoryInt64DatumIterator();
         CategoryInt64DatumIterator(std::shared_ptr<const CategoryInt64Vector> vector);
         bool getNext(CategoryInt64Datum &datum) override;
+        int getNextBatch(CategoryInt64Datum *batch, int batchSize);
 
     private:
         std::shared_ptr<const CategoryInt64Vector> m_vector;
+        int m_chunk;
         tu_int64 m_curr;
     };
 
@@ -35,6 +38,7 @@ namespace groove_data {
         DataKeyType getKeyType() const override;
         DataValueType getValueType() const override;
 
+        const VectorView<Category, tu_int64> &getView() const;
         CategoryInt64Datum getDatum(int index) const;
         Option<CategoryInt64Datum> getSmallest() const;
         Option<CategoryInt64Datum> getLargest() const;
@@ -49,6 +53,8 @@ namespace groove_data {
 
     private:
         CategoryInt64Vector(std::shared_ptr<arrow::Table> table, int keyColumn, int valColumn, int fidColumn);
+
+        VectorView<Category, tu_int64> m_view;
     };
 }
 
@@ -7,6 +7,7 @@
 #include "base_frame.h"
 #include "base_vector.h"
 #include "data_types.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -23,9 +24,11 @@ namespace groove_data {
         CategoryStringDatumIterator();
         CategoryStringDatumIterator(std::shared_ptr<const CategoryStringVector> vector);
         bool getNext(CategoryStringDatum &datum) override;
+        int getNextBatch(CategoryStringDatum *batch, int batchSize);
 
     private:
         std::shared_ptr<const CategoryStringVector> m_vector;
+        int m_chunk;
         tu_int64 m_curr;
     };
 
@@ -35,6 +38,7 @@ namespace groove_data {
         DataKeyType getKeyType() const override;
         DataValueType getValueType() const override;
 
+        const VectorView<Category, std::string> &getView() const;
         CategoryStringDatum getDatum(int index) const;
         Option<CategoryStringDatum> getSmallest() const;
         Option<CategoryStringDatum> getLargest() const;
@@ -49,6 +53,8 @@ namespace groove_data {
 
     private:
         CategoryStringVector(std::shared_ptr<arrow::Table> table, int keyColumn, int valColumn, int fidColumn);
+
+        VectorView<Category, std::string> m_view;
     };
 }
 
@@ -0,0 +1,89 @@
+#ifndef GROOVE_DATA_COMPACT_CATEGORY_H
+#define GROOVE_DATA_COMPACT_CATEGORY_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tempo_utils/integer_types.h>
+
+#include "category.h"
+
+namespace groove_data {
+
+    /**
+     * Bump allocator for the encoded bytes of CompactCategory instances. Memory is released only
+     * when the arena is destroyed, so the arena must outlive every category allocated from it.
+     */
+    class CategoryArena {
+
+    public:
+        explicit CategoryArena(tu_uint32 blockSize = 64 * 1024);
+
+        std::string_view allocate(std::string_view bytes);
+        tu_uint64 getAllocatedSize() const;
+
+    private:
+        tu_uint32 m_blockSize;
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        char *m_curr;
+        tu_uint32 m_remaining;
+        tu_uint64 m_allocated;
+    };
+
+    /**
+     * A Category stored as a single contiguous buffer in an order-preserving encoding, such that
+     * comparing the encoded bytes with memcmp gives the same ordering as Category::compare. Each
+     * segment is written verbatim and terminated with a 0x00 byte; 0x00 and 0x01 bytes occurring
+     * in a segment are escaped as 0x01 0x01 and 0x01 0x02 respectively. The first 8 bytes of the
+     * encoding are cached as a big-endian integer prefix, so most comparisons are decided without
+     * touching the buffer.
+     */
+    class CompactCategory {
+
+    public:
+        CompactCategory();
+        explicit CompactCategory(const Category &category);
+        CompactCategory(const Category &category, CategoryArena *arena);
+
+        bool isEmpty() const;
+        int size() const;
+        std::string_view getBytes() const;
+        tu_uint64 getPrefix() const;
+
+        void decodeSegments(std::vector<std::string_view> &segments, std::string &scratch) const;
+        Category toCategory() const;
+        std::string toString(std::string_view separator = "/") const;
+
+        bool operator<(const CompactCategory &other) const;
+        bool operator<=(const CompactCategory &other) const;
+        bool operator>(const CompactCategory &other) const;
+        bool operator>=(const CompactCategory &other) const;
+        bool operator==(const CompactCategory &other) const;
+        bool operator!=(const CompactCategory &other) const;
+        int compare(const CompactCategory &other) const;
+
+        static void encodeSegment(std::string_view segment, std::string &bytes);
+        static CompactCategory fromSegments(
+            const std::vector<std::string_view> &segments,
+            CategoryArena *arena = nullptr);
+        static CompactCategory fromBytes(std::string_view bytes, CategoryArena *arena = nullptr);
+
+        template <typename H>
+        friend H AbslHashValue(H h, const CompactCategory &category) {
+            auto bytes = category.getBytes();
+            return H::combine_contiguous(std::move(h), bytes.data(), bytes.size());
+        }
+
+    private:
+        std::shared_ptr<const std::string> m_storage;
+        std::string_view m_bytes;
+        tu_uint64 m_prefix;
+
+        CompactCategory(std::string &&bytes);
+        CompactCategory(std::string_view bytes, CategoryArena *arena);
+    };
+}
+
+#endif // GROOVE_DATA_COMPACT_CATEGORY_H
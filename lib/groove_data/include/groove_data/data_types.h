@@ -30,6 +30,17 @@ namespace groove_data {
         COLLATION_INDEXED,          // data is sorted and all keys are unique
     };
 
+    enum class KeyOrdering {
+        ORDERING_UNCHECKED,         // keys are assumed to be sorted and unique without checking
+        ORDERING_VALIDATE,          // keys must be sorted and unique, otherwise the frame is rejected
+        ORDERING_SORT,              // unsorted keys are sorted, duplicate keys are resolved last write wins
+    };
+
+    enum class CategoryEncoding {
+        ENCODING_PLAIN,             // segments are stored as list<utf8>
+        ENCODING_DICTIONARY,        // segments are stored as list<dictionary<int32,utf8>>
+    };
+
     enum class DatumFidelity {
         INVALID,
         FIDELITY_UNKNOWN,           // unknown fidelity. it is an error  to send this over the wire
@@ -118,22 +129,11 @@ namespace groove_data {
     inline int
     search_indexed_vector(std::shared_ptr<VectorType> vector, const KeyType &key)
     {
-        const tu_int64 size = vector->getSize();
-        tu_int64 l = 0;
-        tu_int64 r = size - 1;
-
-        while (l != r) {
-            const tu_int64 m = std::ceil(static_cast<double>(l + r) / 2.0);
-            const auto t = vector->getDatum(m);
-            if (t.key > key) {
-                r = m - 1;
-            } else {
-                l = m;
-            }
-        }
-
-        const auto t = vector->getDatum(l);
-        return t.key == key? l : -1;
+        const auto &view = vector->getView();
+        const tu_int64 index = view.lowerBound(key);
+        if (index < view.getSize() && view.compareKey(index, key) == 0)
+            return index;
+        return -1;
     }
 
     /**
@@ -153,29 +153,10 @@ namespace groove_data {
     inline int
     find_vector_lower_bound(std::shared_ptr<VectorType> vector, const KeyType &key, bool &found)
     {
-        const tu_int64 size = vector->getSize();
-        tu_int64 l = 0;
-        tu_int64 r = size - 1;
-
-        found = false;
-        while (l < r) {
-            const tu_int64 m = std::floor(static_cast<double>(l + r) / 2.0);
-            const auto t = vector->getDatum(m);
-            if (t.key < key) {
-                l = m + 1;
-            } else {
-                r = m;
-            }
-        }
-
-        if (l < size) {
-            const auto t = vector->getDatum(l);
-            if (t.key == key) {
-                found = true;
-            }
-        }
-
-        return l;
+        const auto &view = vector->getView();
+        const tu_int64 index = view.lowerBound(key);
+        found = index < view.getSize() && view.compareKey(index, key) == 0;
+        return index;
     }
 
     /**
@@ -195,29 +176,10 @@ namespace groove_data {
     inline int
     find_vector_upper_bound(std::shared_ptr<VectorType> vector, const KeyType &key, bool &found)
     {
-        const tu_int64 size = vector->getSize();
-        tu_int64 l = 0;
-        tu_int64 r = size;
-
-        found = false;
-        while (l < r) {
-            const tu_int64 m = std::floor(static_cast<double>(l + r) / 2.0);
-            const auto t = vector->getDatum(m);
-            if (t.key > key) {
-                r = m;
-            } else {
-                l = m + 1;
-            }
-        }
-
-        if (r > 0) {
-            const auto t = vector->getDatum(r - 1);
-            if (t.key == key) {
-                found = true;
-            }
-        }
-
-        return r - 1;
+        const auto &view = vector->getView();
+        const tu_int64 index = view.upperBound(key);
+        found = index > 0 && view.compareKey(index - 1, key) == 0;
+        return index - 1;
     }
 
     /**
@@ -280,7 +242,7 @@ namespace groove_data {
         }
 
         bool found;
-        int index = groove_data::find_vector_lower_bound(vector, range.start.getValue(), found);
+        int index = groove_data::find_vector_lower_bound(vector, range.end.getValue(), found);
         if (!found && index == 0)
             return -1;
 
@@ -6,6 +6,7 @@
 
 #include "base_frame.h"
 #include "base_vector.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -22,9 +23,11 @@ namespace groove_data {
         DoubleDoubleDatumIterator();
         DoubleDoubleDatumIterator(std::shared_ptr<const DoubleDoubleVector> vector);
         bool getNext(DoubleDoubleDatum &datum) override;
+        int getNextBatch(DoubleDoubleDatum *batch, int batchSize);
 
     private:
         std::shared_ptr<const DoubleDoubleVector> m_vector;
+        int m_chunk;
         tu_int64 m_curr;
     };
 
@@ -34,6 +37,7 @@ namespace groove_data {
         DataKeyType getKeyType() const override;
         DataValueType getValueType() const override;
 
+        const VectorView<double, double> &getView() const;
         DoubleDoubleDatum getDatum(int index) const;
         Option<DoubleDoubleDatum> getSmallest() const;
         Option<DoubleDoubleDatum> getLargest() const;
@@ -48,6 +52,8 @@ namespace groove_data {
 
     private:
         DoubleDoubleVector(std::shared_ptr<arrow::Table> table, int keyColumn, int valColumn, int fidColumn);
+
+        VectorView<double, double> m_view;
     };
 }
 
@@ -6,6 +6,7 @@
 
 #include "base_frame.h"
 #include "base_vector.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -22,9 +23,11 @@ namespace groove_data {
         DoubleInt64DatumIterator();
         DoubleInt64DatumIterator(std::shared_ptr<const DoubleInt64Vector> vector);
         bool getNext(DoubleInt64Datum &datum) override;
+        int getNextBatch(DoubleInt64Datum *batch, int batchSize);
 
     private:
         std::shared_ptr<const DoubleInt64Vector> m_vector;
+        int m_chunk;
         tu_int64 m_curr;
     };
 
@@ -34,6 +37,7 @@ namespace groove_data {
         DataKeyType getKeyType() const override;
         DataValueType getValueType() const override;
 
+        const VectorView<double, tu_int64> &getView() const;
         DoubleInt64Datum getDatum(int index) const;
         Option<DoubleInt64Datum> getSmallest() const;
         Option<DoubleInt64Datum> getLargest() const;
@@ -48,6 +52,8 @@ namespace groove_data {
 
     private:
         DoubleInt64Vector(std::shared_ptr<arrow::Table> table, int keyColumn, int valColumn, int fidColumn);
+
+        VectorView<double, tu_int64> m_view;
     };
 }
 
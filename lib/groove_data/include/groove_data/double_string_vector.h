@@ -6,6 +6,7 @@
 
 #include "base_frame.h"
 #include "base_vector.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -22,9 +23,11 @@ namespace groove_data {
         DoubleStringDatumIterator();
         DoubleStringDatumIterator(std::shared_ptr<const DoubleStringVector> vector);
         bool getNext(DoubleStringDatum &datum) override;
+        int getNextBatch(DoubleStringDatum *batch, int batchSize);
 
     private:
         std::shared_ptr<const DoubleStringVector> m_vector;
+        int m_chunk;
         tu_int64 m_curr;
     };
 
@@ -34,6 +37,7 @@ namespace groove_data {
         DataKeyType getKeyType() const override;
         DataValueType getValueType() const override;
 
+        const VectorView<double, std::string> &getView() const;
         DoubleStringDatum getDatum(int index) const;
         Option<DoubleStringDatum> getSmallest() const;
         Option<DoubleStringDatum> getLargest() const;
@@ -48,6 +52,8 @@ namespace groove_data {
 
     private:
         DoubleStringVector(std::shared_ptr<arrow::Table> table, int keyColumn, int valColumn, int fidColumn);
+
+        VectorView<double, std::string> m_view;
     };
 }
 
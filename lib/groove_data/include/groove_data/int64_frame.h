@@ -23,7 +23,8 @@ namespace groove_data {
         create(
             std::shared_ptr<arrow::Table> table,
             int keyFieldIndex,
-            const std::vector<std::pair<int,int>> &valueColumns);
+            const std::vector<std::pair<int,int>> &valueColumns,
+            KeyOrdering ordering = KeyOrdering::ORDERING_VALIDATE);
 
     private:
         int m_keyFieldIndex;
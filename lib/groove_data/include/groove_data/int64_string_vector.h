@@ -7,6 +7,7 @@
 #include "base_frame.h"
 #include "base_vector.h"
 #include "data_types.h"
+#include "vector_view_template.h"
 
 namespace groove_data {
 
@@ -23,9 +24,11 @@ namespace groove_data {
         Int64StringDatumIterator();
         Int64StringDatumIterator(std::shared_ptr<const Int64StringVector> vector);
         bool getNext(Int64StringDatum &datum) override;
+        int getNextBatch(Int64StringDatum *batch, int batchSize);
 
     private:
         std::shared_ptr<const Int64StringVector> m_vector;
+        int m_chunk;
         tu_int64 m_curr;
     };
 
@@ -35,6 +38,7 @@ namespace groove_data {
         DataKeyType getKeyType() const override;
         DataValueType getValueType() const override;
 
+        const VectorView<tu_int64, std::string> &getView() const;
         Int64StringDatum getDatum(int index) const;
         Option<Int64StringDatum> getSmallest() const;
         Option<Int64StringDatum> getLargest() const;
@@ -49,6 +53,8 @@ namespace groove_data {
 
     private:
         Int64StringVector(std::shared_ptr<arrow::Table> table, int keyColumn, int valColumn, int fidColumn);
+
+        VectorView<tu_int64, std::string> m_view;
     };
 }
 
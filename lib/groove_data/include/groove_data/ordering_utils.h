@@ -0,0 +1,43 @@
+#ifndef GROOVE_DATA_ORDERING_UTILS_H
+#define GROOVE_DATA_ORDERING_UTILS_H
+
+#include <arrow/chunked_array.h>
+#include <arrow/table.h>
+
+#include "data_result.h"
+#include "data_types.h"
+
+namespace groove_data {
+
+    /**
+     * Returns true if the keys are strictly increasing, which means they are both sorted and
+     * unique. Numeric keys are checked in a single branch-free pass over each chunk, and a NaN
+     * key is never considered ordered.
+     *
+     * @param keys
+     * @param keyType
+     * @return
+     */
+    bool keys_are_ordered(const arrow::ChunkedArray &keys, DataKeyType keyType);
+
+    /**
+     * Applies the key ordering policy to the table. With ORDERING_UNCHECKED the table is returned
+     * as-is. With ORDERING_VALIDATE the table is returned as-is if its keys are ordered, otherwise
+     * an error is returned. With ORDERING_SORT a table with unordered keys is sorted by key and
+     * rows with duplicate keys are dropped except for the last row in table order. The argsort and
+     * the take across columns are both spread over multiple threads.
+     *
+     * @param table
+     * @param keyFieldIndex
+     * @param keyType
+     * @param ordering
+     * @return
+     */
+    tempo_utils::Result<std::shared_ptr<arrow::Table>> apply_key_ordering(
+        std::shared_ptr<arrow::Table> table,
+        int keyFieldIndex,
+        DataKeyType keyType,
+        KeyOrdering ordering);
+}
+
+#endif // GROOVE_DATA_ORDERING_UTILS_H
@@ -0,0 +1,158 @@
+#ifndef GROOVE_DATA_SEARCH_UTILS_H
+#define GROOVE_DATA_SEARCH_UTILS_H
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <tempo_utils/integer_types.h>
+
+namespace groove_data {
+
+    namespace internal {
+
+        /**
+         * number of elements remaining at which the binary search switches to a linear scan. this
+         * is one 64 byte cache line of 8 byte keys.
+         */
+        constexpr tu_int64 kLinearSearchThreshold = 8;
+
+        /**
+         * returns the number of elements in keys[0..size) which are less than key (or less than or
+         * equal to key if Inclusive is true). because the keys are sorted this is the offset of the
+         * bound within the span. the comparisons are accumulated rather than branched on, and when
+         * AVX2 is available four keys are compared per instruction.
+         */
+        template<bool Inclusive>
+        inline tu_int64
+        count_less(const tu_int64 *keys, tu_int64 size, tu_int64 key)
+        {
+            tu_int64 count = 0;
+            tu_int64 i = 0;
+#if defined(__AVX2__)
+            const __m256i needle = _mm256_set1_epi64x(key);
+            for (; i + 4 <= size; i += 4) {
+                auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+                // block < needle, or !(block > needle) for the inclusive bound
+                __m256i mask;
+                if constexpr (Inclusive) {
+                    mask = _mm256_cmpgt_epi64(block, needle);
+                    count += 4 - __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+                } else {
+                    mask = _mm256_cmpgt_epi64(needle, block);
+                    count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+                }
+            }
+#endif
+            for (; i < size; i++) {
+                if constexpr (Inclusive) {
+                    count += keys[i] <= key;
+                } else {
+                    count += keys[i] < key;
+                }
+            }
+            return count;
+        }
+
+        template<bool Inclusive>
+        inline tu_int64
+        count_less(const double *keys, tu_int64 size, double key)
+        {
+            tu_int64 count = 0;
+            tu_int64 i = 0;
+#if defined(__AVX2__)
+            const __m256d needle = _mm256_set1_pd(key);
+            for (; i + 4 <= size; i += 4) {
+                auto block = _mm256_loadu_pd(keys + i);
+                __m256d mask;
+                if constexpr (Inclusive) {
+                    mask = _mm256_cmp_pd(block, needle, _CMP_LE_OQ);
+                } else {
+                    mask = _mm256_cmp_pd(block, needle, _CMP_LT_OQ);
+                }
+                count += __builtin_popcount(_mm256_movemask_pd(mask));
+            }
+#endif
+            for (; i < size; i++) {
+                if constexpr (Inclusive) {
+                    count += keys[i] <= key;
+                } else {
+                    count += keys[i] < key;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * branch-free binary search over sorted keys. on each step the base pointer is advanced
+         * with a conditional move instead of a branch, and the two candidate midpoints of the next
+         * step are prefetched so the memory latency overlaps the current comparison. once the
+         * remaining range fits in a cache line the search finishes with a linear scan.
+         */
+        template<typename KeyType, bool Inclusive>
+        inline tu_int64
+        search_bound(const KeyType *keys, tu_int64 size, KeyType key)
+        {
+            const KeyType *base = keys;
+            tu_int64 n = size;
+            while (n > kLinearSearchThreshold) {
+                const tu_int64 half = n / 2;
+                __builtin_prefetch(base + half / 2);
+                __builtin_prefetch(base + half + half / 2);
+                bool advance;
+                if constexpr (Inclusive) {
+                    advance = base[half] <= key;
+                } else {
+                    advance = base[half] < key;
+                }
+                base = advance? base + half : base;
+                n -= half;
+            }
+            return (base - keys) + count_less<Inclusive>(base, n, key);
+        }
+    }
+
+    /**
+     * returns the index of the first element in the sorted keys which is not less than key. if
+     * all elements are less than key then size is returned.
+     *
+     * @param keys
+     * @param size
+     * @param key
+     * @return
+     */
+    inline tu_int64
+    search_lower_bound(const tu_int64 *keys, tu_int64 size, tu_int64 key)
+    {
+        return internal::search_bound<tu_int64,false>(keys, size, key);
+    }
+
+    inline tu_int64
+    search_lower_bound(const double *keys, tu_int64 size, double key)
+    {
+        return internal::search_bound<double,false>(keys, size, key);
+    }
+
+    /**
+     * returns the index of the first element in the sorted keys which is greater than key. if
+     * no element is greater than key then size is returned.
+     *
+     * @param keys
+     * @param size
+     * @param key
+     * @return
+     */
+    inline tu_int64
+    search_upper_bound(const tu_int64 *keys, tu_int64 size, tu_int64 key)
+    {
+        return internal::search_bound<tu_int64,true>(keys, size, key);
+    }
+
+    inline tu_int64
+    search_upper_bound(const double *keys, tu_int64 size, double key)
+    {
+        return internal::search_bound<double,true>(keys, size, key);
+    }
+}
+
+#endif // GROOVE_DATA_SEARCH_UTILS_H
@@ -10,11 +10,34 @@
 
 namespace groove_data {
 
+    /**
+     * Decodes the IPC stream in the buffer into a table. The arrays of the table reference the
+     * buffer contents in place, and hold a reference to the buffer for as long as they are alive.
+     *
+     * @param buffer
+     * @return
+     */
     tempo_utils::Result<std::shared_ptr<arrow::Table>> make_table(std::shared_ptr<arrow::Buffer> buffer);
 
+    /**
+     * Decodes the IPC stream in the string into a table without copying the string contents.
+     *
+     * @param bytes
+     * @return
+     */
     tempo_utils::Result<std::shared_ptr<arrow::Table>> make_table(std::shared_ptr<const std::string> bytes);
 
     tempo_utils::Result<std::shared_ptr<const arrow::Buffer>> make_buffer(std::shared_ptr<const arrow::Table> table);
+
+    /**
+     * Encodes the table as an IPC stream directly into the string, replacing its contents. This
+     * allows a protobuf bytes field to be filled without an intermediate buffer.
+     *
+     * @param table
+     * @param bytes
+     * @return
+     */
+    tempo_utils::Status write_table(std::shared_ptr<const arrow::Table> table, std::string *bytes);
 }
 
 #endif // GROOVE_DATA_TABLE_UTILS_H
\ No newline at end of file
@@ -0,0 +1,570 @@
+#ifndef GROOVE_DATA_VECTOR_VIEW_TEMPLATE_H
+#define GROOVE_DATA_VECTOR_VIEW_TEMPLATE_H
+
+#include <algorithm>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/chunked_array.h>
+#include <arrow/table.h>
+#include <arrow/util/bit_util.h>
+#include <arrow/util/bitmap_ops.h>
+
+#include <tempo_utils/integer_types.h>
+#include <tempo_utils/logging.h>
+
+#include "category.h"
+#include "compact_category.h"
+#include "data_types.h"
+#include "search_utils.h"
+
+namespace groove_data {
+
+    /**
+     * Raw typed access to a contiguous run of elements in an arrow array. The span does not own
+     * the underlying memory, so it is only valid as long as the array it was created from.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    struct ArraySpan;
+
+    template<>
+    struct ArraySpan<tu_int64> {
+        const tu_int64 *values = nullptr;
+
+        tu_int64 at(tu_int64 index) const { return values[index]; };
+        int compare(tu_int64 index, tu_int64 key) const { return (values[index] > key) - (values[index] < key); };
+        tu_int64 lowerBound(tu_int64 length, tu_int64 key) const { return search_lower_bound(values, length, key); };
+        tu_int64 upperBound(tu_int64 length, tu_int64 key) const { return search_upper_bound(values, length, key); };
+
+        static ArraySpan<tu_int64> fromArray(const arrow::Array &array, tu_int64 offset)
+        {
+            const auto &int64Array = static_cast<const arrow::Int64Array &>(array);
+            return {int64Array.raw_values() + offset};
+        };
+    };
+
+    template<>
+    struct ArraySpan<double> {
+        const double *values = nullptr;
+
+        double at(tu_int64 index) const { return values[index]; };
+        int compare(tu_int64 index, double key) const { return (values[index] > key) - (values[index] < key); };
+        tu_int64 lowerBound(tu_int64 length, double key) const { return search_lower_bound(values, length, key); };
+        tu_int64 upperBound(tu_int64 length, double key) const { return search_upper_bound(values, length, key); };
+
+        static ArraySpan<double> fromArray(const arrow::Array &array, tu_int64 offset)
+        {
+            const auto &doubleArray = static_cast<const arrow::DoubleArray &>(array);
+            return {doubleArray.raw_values() + offset};
+        };
+    };
+
+    /**
+     * Fidelity of a contiguous run of rows. The common valid/missing split is carried by the
+     * validity bitmap of the value column, where a null value means FIDELITY_MISSING. The full
+     * DatumFidelity enum is carried by an optional int8 fidelity column holding enum codes, which
+     * takes precedence over the bitmap. A boolean fidelity column carries no information and is
+     * ignored. allValid is set when every row in the run is FIDELITY_VALID, in which case at()
+     * does not touch either buffer.
+     */
+    struct FidelitySpan {
+        const tu_uint8 *validity = nullptr;
+        tu_int64 bitOffset = 0;
+        const tu_int8 *codes = nullptr;
+        bool allValid = true;
+
+        DatumFidelity at(tu_int64 index) const
+        {
+            if (allValid)
+                return DatumFidelity::FIDELITY_VALID;
+            if (codes != nullptr)
+                return static_cast<DatumFidelity>(codes[index]);
+            return arrow::bit_util::GetBit(validity, bitOffset + index)?
+                DatumFidelity::FIDELITY_VALID : DatumFidelity::FIDELITY_MISSING;
+        };
+
+        static FidelitySpan fromArrays(
+            const arrow::Array &valArray,
+            tu_int64 valOffset,
+            const arrow::Array *fidArray,
+            tu_int64 fidOffset,
+            tu_int64 length)
+        {
+            FidelitySpan span;
+            if (fidArray != nullptr && fidArray->type_id() == arrow::Type::INT8) {
+                span.codes = static_cast<const arrow::Int8Array *>(fidArray)->raw_values() + fidOffset;
+                tu_int64 notValid = 0;
+                for (tu_int64 i = 0; i < length; i++) {
+                    notValid += span.codes[i] != static_cast<tu_int8>(DatumFidelity::FIDELITY_VALID);
+                }
+                span.allValid = notValid == 0;
+                return span;
+            }
+            if (valArray.null_count() == 0)
+                return span;
+            span.validity = valArray.null_bitmap_data();
+            span.bitOffset = valArray.offset() + valOffset;
+            span.allValid = arrow::internal::CountSetBits(span.validity, span.bitOffset, length) == length;
+            return span;
+        };
+    };
+
+    template<>
+    struct ArraySpan<std::string> {
+        const tu_int32 *offsets = nullptr;
+        const tu_uint8 *data = nullptr;
+
+        std::string_view view(tu_int64 index) const
+        {
+            auto start = offsets[index];
+            return std::string_view(reinterpret_cast<const char *>(data + start), offsets[index + 1] - start);
+        };
+        std::string at(tu_int64 index) const { return std::string(view(index)); };
+
+        static ArraySpan<std::string> fromArray(const arrow::Array &array, tu_int64 offset)
+        {
+            const auto &stringArray = static_cast<const arrow::StringArray &>(array);
+            auto valueData = stringArray.value_data();
+            return {stringArray.raw_value_offsets() + offset, valueData? valueData->data() : nullptr};
+        };
+    };
+
+    /**
+     * Raw access to a category array. Segments are either stored inline as list<utf8>, or
+     * dictionary encoded as list<dictionary<int32,utf8>> in which case segments holds the
+     * dictionary and codes holds the dictionary code of each segment.
+     */
+    template<>
+    struct ArraySpan<Category> {
+        const tu_int32 *offsets = nullptr;
+        ArraySpan<std::string> segments;
+        const tu_int32 *codes = nullptr;
+        tu_int32 dictionarySize = 0;
+        bool ordered = false;
+
+        int size(tu_int64 index) const { return offsets[index + 1] - offsets[index]; };
+        std::string_view segment(tu_int32 i) const
+        {
+            return codes != nullptr? segments.view(codes[i]) : segments.view(i);
+        };
+        Category at(tu_int64 index) const
+        {
+            std::vector<std::shared_ptr<const std::string>> path;
+            for (auto i = offsets[index]; i < offsets[index + 1]; i++) {
+                path.push_back(std::make_shared<const std::string>(segment(i)));
+            }
+            return Category(path);
+        };
+
+        CompactCategory toCompact(tu_int64 index, CategoryArena *arena = nullptr) const
+        {
+            std::vector<std::string_view> path;
+            for (auto i = offsets[index]; i < offsets[index + 1]; i++) {
+                path.push_back(segment(i));
+            }
+            return CompactCategory::fromSegments(path, arena);
+        };
+
+        /**
+         * Compares the category at the specified index with key segment by segment, directly
+         * against the string data of the array, so no Category is constructed. Returns a value
+         * less than, equal to, or greater than zero with the same meaning as Category::compare.
+         *
+         * @param index
+         * @param key
+         * @return
+         */
+        int compare(tu_int64 index, const Category &key) const
+        {
+            auto curr = offsets[index];
+            const auto end = offsets[index + 1];
+            for (auto iterator = key.cbegin(); iterator != key.cend(); iterator++, curr++) {
+                if (curr == end)
+                    return -1;
+                const auto &part = *iterator;
+                auto cmp = segment(curr).compare(std::string_view(part->data(), part->size()));
+                if (cmp != 0)
+                    return cmp < 0? -1 : 1;
+            }
+            return curr == end? 0 : 1;
+        };
+
+        /**
+         * Compares the category at index with the category at otherIndex in other. If both spans
+         * share the same ordered dictionary then segments are compared on their codes, otherwise
+         * segments are compared on their string data.
+         *
+         * @param index
+         * @param other
+         * @param otherIndex
+         * @return
+         */
+        int compare(tu_int64 index, const ArraySpan<Category> &other, tu_int64 otherIndex) const
+        {
+            auto curr = offsets[index];
+            const auto end = offsets[index + 1];
+            auto otherCurr = other.offsets[otherIndex];
+            const auto otherEnd = other.offsets[otherIndex + 1];
+            const bool sharedCodes = hasOrderedCodes() && other.hasOrderedCodes()
+                && segments.offsets == other.segments.offsets;
+            for (; otherCurr != otherEnd; curr++, otherCurr++) {
+                if (curr == end)
+                    return -1;
+                int cmp;
+                if (sharedCodes) {
+                    cmp = (codes[curr] > other.codes[otherCurr]) - (codes[curr] < other.codes[otherCurr]);
+                } else {
+                    cmp = segment(curr).compare(other.segment(otherCurr));
+                }
+                if (cmp != 0)
+                    return cmp < 0? -1 : 1;
+            }
+            return curr == end? 0 : 1;
+        };
+
+        /**
+         * Returns true if keys can be compared on dictionary codes, which requires the dictionary
+         * to be sorted.
+         *
+         * @return
+         */
+        bool hasOrderedCodes() const { return codes != nullptr && ordered; };
+
+        /**
+         * Translates key into the code space of an ordered dictionary. A segment present in the
+         * dictionary with code c is encoded as 2c, and a segment which is absent is encoded as
+         * 2c-1 where c is the code of the first larger segment, so it sorts between its neighbors.
+         *
+         * @param key
+         * @param encoded
+         */
+        void encodeKey(const Category &key, std::vector<tu_int64> &encoded) const
+        {
+            encoded.clear();
+            for (auto iterator = key.cbegin(); iterator != key.cend(); iterator++) {
+                const auto &part = *iterator;
+                std::string_view target(part->data(), part->size());
+                tu_int32 l = 0;
+                tu_int32 r = dictionarySize;
+                while (l < r) {
+                    const tu_int32 m = l + (r - l) / 2;
+                    if (segments.view(m) < target) {
+                        l = m + 1;
+                    } else {
+                        r = m;
+                    }
+                }
+                bool found = l < dictionarySize && segments.view(l) == target;
+                encoded.push_back(found? 2 * tu_int64(l) : 2 * tu_int64(l) - 1);
+            }
+        };
+
+        /**
+         * Compares the category at the specified index with a key encoded by encodeKey, using
+         * only integer comparisons.
+         *
+         * @param index
+         * @param encoded
+         * @return
+         */
+        int compareEncoded(tu_int64 index, const std::vector<tu_int64> &encoded) const
+        {
+            auto curr = offsets[index];
+            const auto end = offsets[index + 1];
+            for (auto part : encoded) {
+                if (curr == end)
+                    return -1;
+                const tu_int64 code = 2 * tu_int64(codes[curr++]);
+                if (code != part)
+                    return code < part? -1 : 1;
+            }
+            return curr == end? 0 : 1;
+        };
+
+        tu_int64 lowerBound(tu_int64 length, const Category &key) const
+        {
+            std::vector<tu_int64> encoded;
+            if (hasOrderedCodes()) {
+                encodeKey(key, encoded);
+            }
+            tu_int64 l = 0;
+            tu_int64 r = length;
+            while (l < r) {
+                const tu_int64 m = l + (r - l) / 2;
+                int cmp = hasOrderedCodes()? compareEncoded(m, encoded) : compare(m, key);
+                if (cmp < 0) {
+                    l = m + 1;
+                } else {
+                    r = m;
+                }
+            }
+            return l;
+        };
+        tu_int64 upperBound(tu_int64 length, const Category &key) const
+        {
+            std::vector<tu_int64> encoded;
+            if (hasOrderedCodes()) {
+                encodeKey(key, encoded);
+            }
+            tu_int64 l = 0;
+            tu_int64 r = length;
+            while (l < r) {
+                const tu_int64 m = l + (r - l) / 2;
+                int cmp = hasOrderedCodes()? compareEncoded(m, encoded) : compare(m, key);
+                if (cmp > 0) {
+                    r = m;
+                } else {
+                    l = m + 1;
+                }
+            }
+            return l;
+        };
+
+        static ArraySpan<Category> fromArray(const arrow::Array &array, tu_int64 offset)
+        {
+            const auto &listArray = static_cast<const arrow::ListArray &>(array);
+            auto values = listArray.values();
+            if (values->type_id() != arrow::Type::DICTIONARY)
+                return {listArray.raw_value_offsets() + offset, ArraySpan<std::string>::fromArray(*values, 0)};
+
+            const auto &dictArray = static_cast<const arrow::DictionaryArray &>(*values);
+            const auto &dictType = static_cast<const arrow::DictionaryType &>(*dictArray.type());
+            auto indices = std::static_pointer_cast<arrow::Int32Array>(dictArray.indices());
+            auto dictionary = dictArray.dictionary();
+            ArraySpan<Category> span;
+            span.offsets = listArray.raw_value_offsets() + offset;
+            span.segments = ArraySpan<std::string>::fromArray(*dictionary, 0);
+            span.codes = indices->raw_values();
+            span.dictionarySize = dictionary->length();
+            // the ordered flag comes from the file or page, so it is only trusted if the dictionary is sorted
+            span.ordered = dictType.ordered() && isSortedDictionary(span.segments, span.dictionarySize);
+            return span;
+        };
+
+        /**
+         * Returns true if the dictionary segments are strictly increasing, which is required for
+         * codes to compare in the same order as the segments they encode.
+         *
+         * @param segments
+         * @param dictionarySize
+         * @return
+         */
+        static bool isSortedDictionary(const ArraySpan<std::string> &segments, tu_int32 dictionarySize)
+        {
+            for (tu_int32 i = 1; i < dictionarySize; i++) {
+                if (!(segments.view(i - 1) < segments.view(i)))
+                    return false;
+            }
+            return true;
+        };
+    };
+
+    /**
+     * A typed view over the key, value, and fidelity columns of a vector table. The chunks of each
+     * column are resolved into raw spans once when the view is constructed, and a prefix table of
+     * chunk offsets is maintained so that an absolute row index can be mapped to its chunk without
+     * walking the chunk list. If the columns of the table are not chunked identically then the view
+     * is split at every chunk boundary of every column, so each chunk of the view is contiguous in
+     * all of the columns.
+     *
+     * @tparam KeyType
+     * @tparam ValueType
+     */
+    template<typename KeyType, typename ValueType>
+    class VectorView {
+
+    public:
+        struct Chunk {
+            tu_int64 length;
+            ArraySpan<KeyType> keys;
+            ArraySpan<ValueType> values;
+            FidelitySpan fidelity;
+        };
+
+        VectorView() : m_offsets({0}), m_allValid(true) {};
+
+        VectorView(
+            std::shared_ptr<arrow::Table> table,
+            int keyFieldIndex,
+            int valFieldIndex,
+            int fidFieldIndex)
+            : m_offsets({0}),
+              m_allValid(true)
+        {
+            TU_ASSERT (table != nullptr);
+            auto remaining = table->num_rows();
+            if (remaining == 0)
+                return;
+
+            const auto &keyChunks = table->column(keyFieldIndex)->chunks();
+            const auto &valChunks = table->column(valFieldIndex)->chunks();
+            const arrow::ArrayVector *fidChunks = nullptr;
+            if (fidFieldIndex >= 0) {
+                fidChunks = &table->column(fidFieldIndex)->chunks();
+            }
+
+            int keyChunk = 0, valChunk = 0, fidChunk = 0;
+            tu_int64 keyOffset = 0, valOffset = 0, fidOffset = 0;
+
+            while (remaining > 0) {
+                skipExhaustedChunks(keyChunks, keyChunk, keyOffset);
+                skipExhaustedChunks(valChunks, valChunk, valOffset);
+                tu_int64 length = std::min(
+                    keyChunks[keyChunk]->length() - keyOffset,
+                    valChunks[valChunk]->length() - valOffset);
+                if (fidChunks != nullptr) {
+                    skipExhaustedChunks(*fidChunks, fidChunk, fidOffset);
+                    length = std::min(length, (*fidChunks)[fidChunk]->length() - fidOffset);
+                }
+                length = std::min(length, remaining);
+
+                Chunk chunk;
+                chunk.length = length;
+                chunk.keys = ArraySpan<KeyType>::fromArray(*keyChunks[keyChunk], keyOffset);
+                chunk.values = ArraySpan<ValueType>::fromArray(*valChunks[valChunk], valOffset);
+                chunk.fidelity = FidelitySpan::fromArrays(*valChunks[valChunk], valOffset,
+                    fidChunks != nullptr? (*fidChunks)[fidChunk].get() : nullptr, fidOffset, length);
+                m_allValid = m_allValid && chunk.fidelity.allValid;
+                m_chunks.push_back(chunk);
+                m_offsets.push_back(m_offsets.back() + length);
+
+                keyOffset += length;
+                valOffset += length;
+                fidOffset += length;
+                remaining -= length;
+            }
+        };
+
+        tu_int64 getSize() const { return m_offsets.back(); };
+        int numChunks() const { return m_chunks.size(); };
+        const Chunk &getChunk(int chunkIndex) const { return m_chunks.at(chunkIndex); };
+        tu_int64 getChunkOffset(int chunkIndex) const { return m_offsets.at(chunkIndex); };
+
+        /**
+         * Returns true if every row in the view is FIDELITY_VALID, in which case callers can skip
+         * fidelity checks entirely.
+         *
+         * @return
+         */
+        bool isAllValid() const { return m_allValid; };
+
+        /**
+         * Returns the index of the chunk containing the row at the specified absolute index. The
+         * index must be within the bounds of the view.
+         *
+         * @param index
+         * @return
+         */
+        int findChunk(tu_int64 index) const
+        {
+            TU_ASSERT (0 <= index && index < getSize());
+            auto iterator = std::upper_bound(m_offsets.cbegin(), m_offsets.cend(), index);
+            return std::distance(m_offsets.cbegin(), iterator) - 1;
+        };
+
+        KeyType getKey(tu_int64 index) const
+        {
+            auto chunkIndex = findChunk(index);
+            return m_chunks[chunkIndex].keys.at(index - m_offsets[chunkIndex]);
+        };
+
+        /**
+         * Compares the key of the row at the specified index with key, without materializing the
+         * row key. Returns a value less than, equal to, or greater than zero.
+         *
+         * @param index
+         * @param key
+         * @return
+         */
+        int compareKey(tu_int64 index, const KeyType &key) const
+        {
+            auto chunkIndex = findChunk(index);
+            return m_chunks[chunkIndex].keys.compare(index - m_offsets[chunkIndex], key);
+        };
+
+        ValueType getValue(tu_int64 index) const
+        {
+            auto chunkIndex = findChunk(index);
+            return m_chunks[chunkIndex].values.at(index - m_offsets[chunkIndex]);
+        };
+
+        DatumFidelity getFidelity(tu_int64 index) const
+        {
+            if (m_allValid)
+                return DatumFidelity::FIDELITY_VALID;
+            auto chunkIndex = findChunk(index);
+            return m_chunks[chunkIndex].fidelity.at(index - m_offsets[chunkIndex]);
+        };
+
+        /**
+         * Returns the index of the first row whose key is not less than the specified key, or the
+         * size of the view if all keys are less than the specified key.
+         *
+         * @param key
+         * @return
+         */
+        tu_int64 lowerBound(const KeyType &key) const
+        {
+            // find the first chunk whose largest key is not less than key
+            int lo = 0;
+            int hi = m_chunks.size();
+            while (lo < hi) {
+                const int mid = lo + (hi - lo) / 2;
+                const auto &chunk = m_chunks[mid];
+                if (chunk.keys.compare(chunk.length - 1, key) < 0) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (lo == static_cast<int>(m_chunks.size()))
+                return getSize();
+            const auto &chunk = m_chunks[lo];
+            return m_offsets[lo] + chunk.keys.lowerBound(chunk.length, key);
+        };
+
+        /**
+         * Returns the index of the first row whose key is greater than the specified key, or the
+         * size of the view if no key is greater than the specified key.
+         *
+         * @param key
+         * @return
+         */
+        tu_int64 upperBound(const KeyType &key) const
+        {
+            // find the first chunk whose largest key is greater than key
+            int lo = 0;
+            int hi = m_chunks.size();
+            while (lo < hi) {
+                const int mid = lo + (hi - lo) / 2;
+                const auto &chunk = m_chunks[mid];
+                if (chunk.keys.compare(chunk.length - 1, key) > 0) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            if (lo == static_cast<int>(m_chunks.size()))
+                return getSize();
+            const auto &chunk = m_chunks[lo];
+            return m_offsets[lo] + chunk.keys.upperBound(chunk.length, key);
+        };
+
+    private:
+        std::vector<Chunk> m_chunks;
+        std::vector<tu_int64> m_offsets;
+        bool m_allValid;
+
+        static void skipExhaustedChunks(const arrow::ArrayVector &chunks, int &chunkIndex, tu_int64 &chunkOffset)
+        {
+            while (chunks[chunkIndex]->length() == chunkOffset) {
+                chunkIndex++;
+                chunkOffset = 0;
+            }
+        };
+    };
+}
+
+#endif // GROOVE_DATA_VECTOR_VIEW_TEMPLATE_H
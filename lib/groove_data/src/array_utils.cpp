@@ -1,2 +1,104 @@
 
-#include <groove_data/array_utils.h>
\ No newline at end of file
+#include <absl/container/flat_hash_map.h>
+#include <arrow/array/builder_binary.h>
+#include <arrow/array/builder_primitive.h>
+
+#include <groove_data/array_utils.h>
+#include <groove_data/category_builder.h>
+
+bool
+groove_data::is_category_datatype(const std::shared_ptr<arrow::DataType> &type)
+{
+    if (type == nullptr || type->id() != arrow::Type::LIST)
+        return false;
+    auto valueType = std::static_pointer_cast<arrow::ListType>(type)->value_type();
+    switch (valueType->id()) {
+        case arrow::Type::STRING:
+            return true;
+        case arrow::Type::DICTIONARY: {
+            auto dictType = std::static_pointer_cast<arrow::DictionaryType>(valueType);
+            return dictType->index_type()->id() == arrow::Type::INT32
+                && dictType->value_type()->id() == arrow::Type::STRING;
+        }
+        default:
+            return false;
+    }
+}
+
+arrow::Result<std::shared_ptr<arrow::ChunkedArray>>
+groove_data::dictionary_encode_categories(
+    std::shared_ptr<arrow::ChunkedArray> chunkedArray,
+    arrow::MemoryPool *pool)
+{
+    TU_ASSERT (chunkedArray != nullptr);
+
+    auto type = chunkedArray->type();
+    if (!is_category_datatype(type))
+        return arrow::Status::TypeError("expected category array");
+    if (std::static_pointer_cast<arrow::ListType>(type)->value_type()->id() == arrow::Type::DICTIONARY)
+        return chunkedArray;
+
+    // collect the distinct segments of every chunk
+    absl::flat_hash_map<std::string_view,tu_int32> codes;
+    std::vector<std::string_view> distinct;
+    tu_int64 distinctSize = 0;
+    for (const auto &chunk : chunkedArray->chunks()) {
+        auto listArray = std::static_pointer_cast<arrow::ListArray>(chunk);
+        auto segments = std::static_pointer_cast<arrow::StringArray>(listArray->values());
+        for (tu_int64 i = 0; i < segments->length(); i++) {
+            auto segment = segments->GetView(i);
+            if (codes.try_emplace(segment, 0).second) {
+                distinct.push_back(segment);
+                distinctSize += segment.size();
+            }
+        }
+    }
+
+    // sort the dictionary so that codes preserve the segment order
+    std::sort(distinct.begin(), distinct.end());
+    arrow::StringBuilder dictionaryBuilder(pool);
+    auto status = dictionaryBuilder.Reserve(distinct.size());
+    if (!status.ok())
+        return status;
+    status = dictionaryBuilder.ReserveData(distinctSize);
+    if (!status.ok())
+        return status;
+    for (tu_int32 code = 0; code < static_cast<tu_int32>(distinct.size()); code++) {
+        codes[distinct[code]] = code;
+        dictionaryBuilder.UnsafeAppend(distinct[code]);
+    }
+    auto finishDictionaryResult = dictionaryBuilder.Finish();
+    if (!finishDictionaryResult.ok())
+        return finishDictionaryResult.status();
+    auto dictionary = *finishDictionaryResult;
+
+    auto dictType = arrow::dictionary(arrow::int32(), arrow::utf8(), true);
+    auto listType = CategoryBuilder::makeDatatype(CategoryEncoding::ENCODING_DICTIONARY);
+
+    // replace the segments of each chunk with their codes, reusing the list offsets as-is
+    arrow::ArrayVector encodedChunks;
+    for (const auto &chunk : chunkedArray->chunks()) {
+        auto listArray = std::static_pointer_cast<arrow::ListArray>(chunk);
+        auto segments = std::static_pointer_cast<arrow::StringArray>(listArray->values());
+
+        arrow::Int32Builder indicesBuilder(pool);
+        status = indicesBuilder.Reserve(segments->length());
+        if (!status.ok())
+            return status;
+        for (tu_int64 i = 0; i < segments->length(); i++) {
+            indicesBuilder.UnsafeAppend(codes.at(segments->GetView(i)));
+        }
+        auto finishIndicesResult = indicesBuilder.Finish();
+        if (!finishIndicesResult.ok())
+            return finishIndicesResult.status();
+
+        auto makeValuesResult = arrow::DictionaryArray::FromArrays(dictType, *finishIndicesResult, dictionary);
+        if (!makeValuesResult.ok())
+            return makeValuesResult.status();
+        encodedChunks.push_back(std::make_shared<arrow::ListArray>(listType, listArray->length(),
+            listArray->value_offsets(), *makeValuesResult, listArray->null_bitmap(),
+            listArray->null_count(), listArray->offset()));
+    }
+
+    return arrow::ChunkedArray::Make(encodedChunks, listType);
+}
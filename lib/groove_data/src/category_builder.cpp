@@ -1,37 +1,163 @@
 
+#include <arrow/chunked_array.h>
+
+#include <groove_data/array_utils.h>
 #include <groove_data/category_builder.h>
 #include <tempo_utils/log_stream.h>
 
-groove_data::CategoryBuilder::CategoryBuilder()
+groove_data::CategoryBuilder::CategoryBuilder(CategoryEncoding encoding, arrow::MemoryPool *pool)
+    : m_encoding(encoding),
+      m_pool(pool)
+{
+    TU_ASSERT (m_pool != nullptr);
+    m_str = std::make_shared<arrow::StringBuilder>(m_pool);
+    m_cat = std::make_unique<arrow::ListBuilder>(m_pool, m_str);
+}
+
+groove_data::CategoryEncoding
+groove_data::CategoryBuilder::getEncoding() const
 {
-    m_str = std::make_shared<arrow::StringBuilder>();
-    m_cat = std::make_unique<arrow::ListBuilder>(arrow::system_memory_pool(), m_str);
+    return m_encoding;
+}
+
+arrow::Status
+groove_data::CategoryBuilder::Reserve(tu_int64 numCategories, tu_int64 numSegments, tu_int64 numBytes)
+{
+    auto status = m_cat->Reserve(numCategories);
+    if (!status.ok())
+        return status;
+    status = m_str->Reserve(numSegments);
+    if (!status.ok())
+        return status;
+    return m_str->ReserveData(numBytes);
 }
 
 arrow::Status
-groove_data::CategoryBuilder::Append(const Category category)
+groove_data::CategoryBuilder::Append(const Category &category)
 {
     TU_ASSERT (!category.isEmpty());
 
     auto status = m_cat->Append();
     if (!status.ok())
         return status;
-    std::vector<const char *> offsets;
     for (auto iterator = category.cbegin(); iterator != category.cend(); iterator++) {
-        auto part = *iterator;
-        offsets.push_back(part->c_str());
+        const auto &part = *iterator;
+        status = m_str->Append(part->data(), part->size());
+        if (!status.ok())
+            return status;
+    }
+    return arrow::Status::OK();
+}
+
+arrow::Status
+groove_data::CategoryBuilder::Append(const CompactCategory &category)
+{
+    TU_ASSERT (!category.isEmpty());
+
+    auto status = m_cat->Append();
+    if (!status.ok())
+        return status;
+    category.decodeSegments(m_segments, m_scratch);
+    for (const auto &segment : m_segments) {
+        status = m_str->Append(segment);
+        if (!status.ok())
+            return status;
     }
-    return m_str->AppendValues(offsets.data(), offsets.size());
+    return arrow::Status::OK();
+}
+
+template<typename SegmentAt>
+arrow::Status
+groove_data::CategoryBuilder::appendBulk(
+    tu_int64 numSegments,
+    std::span<const tu_int32> categoryOffsets,
+    SegmentAt segmentAt)
+{
+    if (categoryOffsets.empty())
+        return arrow::Status::OK();
+    const tu_int64 numCategories = categoryOffsets.size() - 1;
+    if (categoryOffsets.front() < 0 || categoryOffsets.back() > numSegments)
+        return arrow::Status::IndexError("category offsets are out of range");
+
+    // validate the offsets and size the string data before anything is appended
+    tu_int64 numBytes = 0;
+    for (tu_int64 i = 0; i < numCategories; i++) {
+        if (categoryOffsets[i + 1] <= categoryOffsets[i])
+            return arrow::Status::Invalid("category offsets must be strictly increasing");
+    }
+    for (auto j = categoryOffsets.front(); j < categoryOffsets.back(); j++) {
+        numBytes += segmentAt(j).size();
+    }
+
+    auto status = Reserve(numCategories, categoryOffsets.back() - categoryOffsets.front(), numBytes);
+    if (!status.ok())
+        return status;
+    for (tu_int64 i = 0; i < numCategories; i++) {
+        status = m_cat->Append();
+        if (!status.ok())
+            return status;
+        for (auto j = categoryOffsets[i]; j < categoryOffsets[i + 1]; j++) {
+            m_str->UnsafeAppend(segmentAt(j));
+        }
+    }
+    return arrow::Status::OK();
+}
+
+arrow::Status
+groove_data::CategoryBuilder::AppendValues(
+    std::span<const std::string_view> segments,
+    std::span<const tu_int32> categoryOffsets)
+{
+    return appendBulk(segments.size(), categoryOffsets, [&](tu_int32 j) { return segments[j]; });
+}
+
+arrow::Status
+groove_data::CategoryBuilder::AppendValues(
+    std::string_view data,
+    std::span<const tu_int32> segmentOffsets,
+    std::span<const tu_int32> segmentLengths,
+    std::span<const tu_int32> categoryOffsets)
+{
+    if (segmentOffsets.size() != segmentLengths.size())
+        return arrow::Status::Invalid("segment offsets and lengths must be the same size");
+    // the offsets and lengths may come from untrusted input, so every segment is checked
+    // against the data before any view of it is made
+    const auto dataSize = static_cast<tu_int64>(data.size());
+    for (size_t j = 0; j < segmentOffsets.size(); j++) {
+        tu_int64 offset = segmentOffsets[j];
+        tu_int64 length = segmentLengths[j];
+        if (offset < 0 || length < 0 || offset > dataSize || length > dataSize - offset)
+            return arrow::Status::Invalid("segment ", j, " is out of range of the data");
+    }
+    return appendBulk(segmentOffsets.size(), categoryOffsets, [&](tu_int32 j) {
+        return data.substr(segmentOffsets[j], segmentLengths[j]);
+    });
 }
 
 arrow::Result<std::shared_ptr<arrow::Array>>
 groove_data::CategoryBuilder::Finish()
 {
-    return m_cat->Finish();
+    auto finishResult = m_cat->Finish();
+    if (!finishResult.ok() || m_encoding == CategoryEncoding::ENCODING_PLAIN)
+        return finishResult;
+
+    // segments are collected as plain strings and then encoded in one pass, which lets the
+    // dictionary be sorted so that codes compare in the same order as their segments
+    auto chunkedArray = std::make_shared<arrow::ChunkedArray>(*finishResult);
+    auto encodeResult = dictionary_encode_categories(chunkedArray, m_pool);
+    if (!encodeResult.ok())
+        return encodeResult.status();
+    return (*encodeResult)->chunk(0);
 }
 
 std::shared_ptr<arrow::DataType>
-groove_data::CategoryBuilder::makeDatatype()
+groove_data::CategoryBuilder::makeDatatype(CategoryEncoding encoding)
 {
-    return arrow::list(arrow::utf8());
+    switch (encoding) {
+        case CategoryEncoding::ENCODING_DICTIONARY:
+            return arrow::list(arrow::dictionary(arrow::int32(), arrow::utf8(), true));
+        case CategoryEncoding::ENCODING_PLAIN:
+        default:
+            return arrow::list(arrow::utf8());
+    }
 }
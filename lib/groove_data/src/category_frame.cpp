@@ -8,6 +8,7 @@
 #include <groove_data/category_int64_vector.h>
 #include <groove_data/category_string_vector.h>
 #include <groove_data/data_types.h>
+#include <groove_data/ordering_utils.h>
 #include <tempo_utils/logging.h>
 
 groove_data::CategoryFrame::CategoryFrame(std::shared_ptr<arrow::Table> table, int keyFieldIndex)
@@ -65,7 +66,8 @@ tempo_utils::Result<std::shared_ptr<groove_data::CategoryFrame>>
 groove_data::CategoryFrame::create(
     std::shared_ptr<arrow::Table> table,
     int keyFieldIndex,
-    const std::vector<std::pair<int,int>> &valueColumns)
+    const std::vector<std::pair<int,int>> &valueColumns,
+    KeyOrdering ordering)
 {
     if (!table)
         return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid table");
@@ -74,11 +76,16 @@ groove_data::CategoryFrame::create(
     if (schema->num_fields() <= keyFieldIndex)
         return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid key field");
     auto keyField = table->schema()->field(keyFieldIndex);
-    if (!keyField->type()->Equals(arrow::list(arrow::utf8())))
+    if (!is_category_datatype(keyField->type()))
         return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid key field");
     if (valueColumns.empty())
         return DataStatus::forCondition(DataCondition::kDataInvariant, "no columns");
 
+    auto applyOrderingResult = apply_key_ordering(table, keyFieldIndex, DataKeyType::KEY_CATEGORY, ordering);
+    if (applyOrderingResult.isStatus())
+        return applyOrderingResult.getStatus();
+    table = applyOrderingResult.getResult();
+
     auto frame = std::shared_ptr<CategoryFrame>(new CategoryFrame(table, keyFieldIndex));
 
     absl::flat_hash_set<std::string> columnIdsSeen;
@@ -100,7 +107,8 @@ groove_data::CategoryFrame::create(
             if (numFields <= fidFieldIndex || fidFieldIndex == keyFieldIndex)
                 return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid fid field index");
             auto fidField = schema->field(fidFieldIndex);
-            if (fidField->type()->id() != arrow::Type::BOOL)
+            auto fidType = fidField->type()->id();
+            if (fidType != arrow::Type::BOOL && fidType != arrow::Type::INT8)
                 return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid fid field index");
         }
 
@@ -2,18 +2,19 @@
 #include <arrow/array.h>
 #include <arrow/chunked_array.h>
 
-#include <groove_data/array_utils.h>
 #include <groove_data/category_int64_vector.h>
 #include <groove_data/data_types.h>
 #include <tempo_utils/logging.h>
 
 groove_data::CategoryInt64DatumIterator::CategoryInt64DatumIterator()
-    : m_curr(-1)
+    : m_chunk(-1),
+      m_curr(-1)
 {
 }
 
 groove_data::CategoryInt64DatumIterator::CategoryInt64DatumIterator(std::shared_ptr<const CategoryInt64Vector> vector)
     : m_vector(vector),
+      m_chunk(0),
       m_curr(0)
 {
     TU_ASSERT (m_vector != nullptr);
@@ -22,10 +23,47 @@ groove_data::CategoryInt64DatumIterator::CategoryInt64DatumIterator(std::shared_
 bool
 groove_data::CategoryInt64DatumIterator::getNext(CategoryInt64Datum &datum)
 {
-    if (!m_vector || m_vector->getSize() <= m_curr)
+    if (!m_vector)
         return false;
-    datum = m_vector->getDatum(m_curr++);
-    return true;
+    const auto &view = m_vector->getView();
+    while (m_chunk < view.numChunks()) {
+        const auto &chunk = view.getChunk(m_chunk);
+        if (m_curr < chunk.length) {
+            datum.key = chunk.keys.at(m_curr);
+            datum.value = chunk.values.at(m_curr);
+            datum.fidelity = chunk.fidelity.at(m_curr);
+            m_curr++;
+            return true;
+        }
+        m_chunk++;
+        m_curr = 0;
+    }
+    return false;
+}
+
+int
+groove_data::CategoryInt64DatumIterator::getNextBatch(CategoryInt64Datum *batch, int batchSize)
+{
+    if (!m_vector)
+        return 0;
+    const auto &view = m_vector->getView();
+    int count = 0;
+    while (count < batchSize && m_chunk < view.numChunks()) {
+        const auto &chunk = view.getChunk(m_chunk);
+        auto size = std::min<tu_int64>(chunk.length - m_curr, batchSize - count);
+        for (tu_int64 i = m_curr; i < m_curr + size; i++) {
+            auto &datum = batch[count++];
+            datum.key = chunk.keys.at(i);
+            datum.value = chunk.values.at(i);
+            datum.fidelity = chunk.fidelity.at(i);
+        }
+        m_curr += size;
+        if (m_curr == chunk.length) {
+            m_chunk++;
+            m_curr = 0;
+        }
+    }
+    return count;
 }
 
 groove_data::CategoryInt64Vector::CategoryInt64Vector(
@@ -33,7 +71,8 @@ groove_data::CategoryInt64Vector::CategoryInt64Vector(
     int keyColumn,
     int valColumn,
     int fidColumn)
-    : BaseVector(table, keyColumn, valColumn, fidColumn)
+    : BaseVector(table, keyColumn, valColumn, fidColumn),
+      m_view(table, keyColumn, valColumn, fidColumn)
 {
 }
 
@@ -55,21 +94,25 @@ groove_data::CategoryInt64Vector::getValueType() const
     return DataValueType::VALUE_TYPE_INT64;
 }
 
+const groove_data::VectorView<groove_data::Category, tu_int64> &
+groove_data::CategoryInt64Vector::getView() const
+{
+    return m_view;
+}
+
 groove_data::CategoryInt64Datum
 groove_data::CategoryInt64Vector::getDatum(int index) const
 {
     CategoryInt64Datum datum = {{}, 0, DatumFidelity::FIDELITY_INVALID};
 
-    auto table = getTable();
-    if (table->num_rows() <= index)
-        return datum;
-    auto keyArray = table->column(getKeyFieldIndex());
-    auto valArray = table->column(getValFieldIndex());
-    if (!groove_data::get_category_datum(keyArray, index, datum.key))
-        return datum;
-    if (!groove_data::get_int64_datum(valArray, index, datum.value))
+    if (index < 0 || m_view.getSize() <= index)
         return datum;
-    datum.fidelity = DatumFidelity::FIDELITY_VALID;
+    auto chunkIndex = m_view.findChunk(index);
+    const auto &chunk = m_view.getChunk(chunkIndex);
+    auto offset = index - m_view.getChunkOffset(chunkIndex);
+    datum.key = chunk.keys.at(offset);
+    datum.value = chunk.values.at(offset);
+    datum.fidelity = chunk.fidelity.at(offset);
     return datum;
 }
 
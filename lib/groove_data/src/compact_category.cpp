@@ -0,0 +1,291 @@
+#include <cstring>
+
+#include <absl/strings/str_cat.h>
+
+#include <groove_data/compact_category.h>
+#include <tempo_utils/log_stream.h>
+
+groove_data::CategoryArena::CategoryArena(tu_uint32 blockSize)
+    : m_blockSize(blockSize),
+      m_curr(nullptr),
+      m_remaining(0),
+      m_allocated(0)
+{
+    TU_ASSERT (m_blockSize > 0);
+}
+
+std::string_view
+groove_data::CategoryArena::allocate(std::string_view bytes)
+{
+    if (bytes.empty())
+        return {};
+
+    // if the bytes are larger than a block then give them a dedicated block, otherwise
+    // start a new block when the current one is exhausted
+    if (bytes.size() > m_remaining) {
+        if (bytes.size() > m_blockSize) {
+            auto block = std::make_unique<char[]>(bytes.size());
+            std::memcpy(block.get(), bytes.data(), bytes.size());
+            std::string_view allocated(block.get(), bytes.size());
+            m_blocks.push_back(std::move(block));
+            m_allocated += bytes.size();
+            return allocated;
+        }
+        m_blocks.push_back(std::make_unique<char[]>(m_blockSize));
+        m_curr = m_blocks.back().get();
+        m_remaining = m_blockSize;
+        m_allocated += m_blockSize;
+    }
+
+    std::memcpy(m_curr, bytes.data(), bytes.size());
+    std::string_view allocated(m_curr, bytes.size());
+    m_curr += bytes.size();
+    m_remaining -= bytes.size();
+    return allocated;
+}
+
+tu_uint64
+groove_data::CategoryArena::getAllocatedSize() const
+{
+    return m_allocated;
+}
+
+static tu_uint64
+make_prefix(std::string_view bytes)
+{
+    tu_uint64 prefix = 0;
+    for (int i = 0; i < 8; i++) {
+        prefix <<= 8;
+        if (i < static_cast<int>(bytes.size())) {
+            prefix |= static_cast<tu_uint8>(bytes[i]);
+        }
+    }
+    return prefix;
+}
+
+groove_data::CompactCategory::CompactCategory()
+    : m_prefix(0)
+{
+}
+
+groove_data::CompactCategory::CompactCategory(const Category &category)
+    : CompactCategory(category, nullptr)
+{
+}
+
+groove_data::CompactCategory::CompactCategory(const Category &category, CategoryArena *arena)
+    : m_prefix(0)
+{
+    std::string bytes;
+    for (auto iterator = category.cbegin(); iterator != category.cend(); iterator++) {
+        const auto &part = *iterator;
+        encodeSegment(std::string_view(part->data(), part->size()), bytes);
+    }
+    *this = arena != nullptr? CompactCategory(bytes, arena) : CompactCategory(std::move(bytes));
+}
+
+groove_data::CompactCategory::CompactCategory(std::string &&bytes)
+    : m_storage(std::make_shared<const std::string>(std::move(bytes)))
+{
+    m_bytes = *m_storage;
+    m_prefix = make_prefix(m_bytes);
+}
+
+groove_data::CompactCategory::CompactCategory(std::string_view bytes, CategoryArena *arena)
+{
+    TU_ASSERT (arena != nullptr);
+    m_bytes = arena->allocate(bytes);
+    m_prefix = make_prefix(m_bytes);
+}
+
+bool
+groove_data::CompactCategory::isEmpty() const
+{
+    return m_bytes.empty();
+}
+
+int
+groove_data::CompactCategory::size() const
+{
+    // 0x00 never occurs in an encoded segment, so each one terminates a segment
+    int size = 0;
+    for (auto c : m_bytes) {
+        if (c == '\x00')
+            size++;
+    }
+    return size;
+}
+
+std::string_view
+groove_data::CompactCategory::getBytes() const
+{
+    return m_bytes;
+}
+
+tu_uint64
+groove_data::CompactCategory::getPrefix() const
+{
+    return m_prefix;
+}
+
+/**
+ * Decodes the segments of the category into segments. Segments which contain no escaped bytes
+ * are returned as views into the encoded buffer without copying; otherwise the segment is
+ * unescaped into scratch and the view refers to scratch, so scratch must not be modified while
+ * the views are in use.
+ *
+ * @param segments
+ * @param scratch
+ */
+void
+groove_data::CompactCategory::decodeSegments(std::vector<std::string_view> &segments, std::string &scratch) const
+{
+    segments.clear();
+    scratch.clear();
+    // reserve enough space up front so views into scratch are not invalidated by reallocation
+    scratch.reserve(m_bytes.size());
+
+    std::size_t start = 0;
+    while (start < m_bytes.size()) {
+        auto end = m_bytes.find('\x00', start);
+        TU_ASSERT (end != std::string_view::npos);
+        auto segment = m_bytes.substr(start, end - start);
+        if (segment.find('\x01') == std::string_view::npos) {
+            segments.push_back(segment);
+        } else {
+            auto offset = scratch.size();
+            for (std::size_t i = 0; i < segment.size(); i++) {
+                if (segment[i] == '\x01') {
+                    i++;
+                    TU_ASSERT (i < segment.size());
+                    scratch.push_back(segment[i] == '\x01'? '\x00' : '\x01');
+                } else {
+                    scratch.push_back(segment[i]);
+                }
+            }
+            segments.push_back(std::string_view(scratch.data() + offset, scratch.size() - offset));
+        }
+        start = end + 1;
+    }
+}
+
+groove_data::Category
+groove_data::CompactCategory::toCategory() const
+{
+    std::vector<std::string_view> segments;
+    std::string scratch;
+    decodeSegments(segments, scratch);
+
+    std::vector<std::shared_ptr<const std::string>> path;
+    for (const auto &segment : segments) {
+        path.push_back(std::make_shared<const std::string>(segment));
+    }
+    return Category(path);
+}
+
+std::string
+groove_data::CompactCategory::toString(std::string_view separator) const
+{
+    std::vector<std::string_view> segments;
+    std::string scratch;
+    decodeSegments(segments, scratch);
+
+    std::string s;
+    for (auto iterator = segments.cbegin(); iterator != segments.cend(); iterator++) {
+        if (iterator != segments.cbegin()) {
+            absl::StrAppend(&s, separator);
+        }
+        absl::StrAppend(&s, *iterator);
+    }
+    return s;
+}
+
+bool
+groove_data::CompactCategory::operator<(const CompactCategory &other) const
+{
+    return compare(other) < 0;
+}
+
+bool
+groove_data::CompactCategory::operator<=(const CompactCategory &other) const
+{
+    return compare(other) <= 0;
+}
+
+bool
+groove_data::CompactCategory::operator>(const CompactCategory &other) const
+{
+    return compare(other) > 0;
+}
+
+bool
+groove_data::CompactCategory::operator>=(const CompactCategory &other) const
+{
+    return compare(other) >= 0;
+}
+
+bool
+groove_data::CompactCategory::operator==(const CompactCategory &other) const
+{
+    return m_prefix == other.m_prefix && m_bytes == other.m_bytes;
+}
+
+bool
+groove_data::CompactCategory::operator!=(const CompactCategory &other) const
+{
+    return !(*this == other);
+}
+
+int
+groove_data::CompactCategory::compare(const CompactCategory &other) const
+{
+    // the prefix is zero-padded, and 0x00 is the smallest byte, so if the prefixes differ then
+    // their order is the order of the full encodings
+    if (m_prefix != other.m_prefix)
+        return m_prefix < other.m_prefix? -1 : 1;
+    if (m_bytes.size() <= 8 && other.m_bytes.size() <= 8 && m_bytes.size() == other.m_bytes.size())
+        return 0;
+    auto cmp = m_bytes.compare(other.m_bytes);
+    return cmp < 0? -1 : cmp > 0? 1 : 0;
+}
+
+void
+groove_data::CompactCategory::encodeSegment(std::string_view segment, std::string &bytes)
+{
+    for (auto c : segment) {
+        switch (c) {
+            case '\x00':
+                bytes.push_back('\x01');
+                bytes.push_back('\x01');
+                break;
+            case '\x01':
+                bytes.push_back('\x01');
+                bytes.push_back('\x02');
+                break;
+            default:
+                bytes.push_back(c);
+                break;
+        }
+    }
+    bytes.push_back('\x00');
+}
+
+groove_data::CompactCategory
+groove_data::CompactCategory::fromSegments(const std::vector<std::string_view> &segments, CategoryArena *arena)
+{
+    std::string bytes;
+    for (const auto &segment : segments) {
+        encodeSegment(segment, bytes);
+    }
+    if (arena != nullptr)
+        return CompactCategory(std::string_view(bytes), arena);
+    return CompactCategory(std::move(bytes));
+}
+
+groove_data::CompactCategory
+groove_data::CompactCategory::fromBytes(std::string_view bytes, CategoryArena *arena)
+{
+    if (arena != nullptr)
+        return CompactCategory(bytes, arena);
+    return CompactCategory(std::string(bytes));
+}
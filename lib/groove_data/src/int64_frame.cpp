@@ -8,6 +8,7 @@
 #include <groove_data/int64_int64_vector.h>
 #include <groove_data/int64_string_vector.h>
 #include <groove_data/data_types.h>
+#include <groove_data/ordering_utils.h>
 #include <tempo_utils/logging.h>
 
 groove_data::Int64Frame::Int64Frame(std::shared_ptr<arrow::Table> table, int keyFieldIndex)
@@ -65,7 +66,8 @@ tempo_utils::Result<std::shared_ptr<groove_data::Int64Frame>>
 groove_data::Int64Frame::create(
     std::shared_ptr<arrow::Table> table,
     int keyFieldIndex,
-    const std::vector<std::pair<int,int>> &valueColumns)
+    const std::vector<std::pair<int,int>> &valueColumns,
+    KeyOrdering ordering)
 {
     if (!table)
         return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid table");
@@ -79,6 +81,11 @@ groove_data::Int64Frame::create(
     if (valueColumns.empty())
         return DataStatus::forCondition(DataCondition::kDataInvariant, "no columns");
 
+    auto applyOrderingResult = apply_key_ordering(table, keyFieldIndex, DataKeyType::KEY_INT64, ordering);
+    if (applyOrderingResult.isStatus())
+        return applyOrderingResult.getStatus();
+    table = applyOrderingResult.getResult();
+
     auto frame = std::shared_ptr<Int64Frame>(new Int64Frame(table, keyFieldIndex));
 
     absl::flat_hash_set<std::string> columnIdsSeen;
@@ -100,7 +107,8 @@ groove_data::Int64Frame::create(
             if (numFields <= fidFieldIndex || fidFieldIndex == keyFieldIndex)
                 return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid fid field index");
             auto fidField = schema->field(fidFieldIndex);
-            if (fidField->type()->id() != arrow::Type::BOOL)
+            auto fidType = fidField->type()->id();
+            if (fidType != arrow::Type::BOOL && fidType != arrow::Type::INT8)
                 return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid fid field index");
         }
 
@@ -0,0 +1,297 @@
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <arrow/array/concatenate.h>
+#include <arrow/builder.h>
+#include <arrow/compute/api_vector.h>
+
+#include <groove_data/ordering_utils.h>
+#include <groove_data/vector_view_template.h>
+
+// below this many rows per thread the sort and take run on the calling thread
+constexpr tu_int64 kMinRowsPerThread = 64 * 1024;
+
+static int
+num_threads_for(tu_int64 numRows)
+{
+    auto hardwareThreads = std::max<tu_int64>(1, std::thread::hardware_concurrency());
+    return std::clamp<tu_int64>(numRows / kMinRowsPerThread, 1, hardwareThreads);
+}
+
+template<typename T>
+static bool
+numeric_keys_are_ordered(const arrow::ChunkedArray &keys)
+{
+    bool hasPrev = false;
+    T prev = 0;
+    for (const auto &chunk : keys.chunks()) {
+        const tu_int64 length = chunk->length();
+        if (length == 0)
+            continue;
+        const T *values = groove_data::ArraySpan<T>::fromArray(*chunk, 0).values;
+        if (hasPrev && !(prev < values[0]))
+            return false;
+        // count violations rather than returning early so the loop has no branches and vectorizes
+        tu_int64 unordered = 0;
+        for (tu_int64 i = 1; i < length; i++) {
+            unordered += !(values[i - 1] < values[i]);
+        }
+        if (unordered > 0)
+            return false;
+        prev = values[length - 1];
+        hasPrev = true;
+    }
+    return true;
+}
+
+static bool
+category_keys_are_ordered(const arrow::ChunkedArray &keys)
+{
+    bool hasPrev = false;
+    groove_data::ArraySpan<groove_data::Category> prev;
+    tu_int64 prevIndex = 0;
+    for (const auto &chunk : keys.chunks()) {
+        const tu_int64 length = chunk->length();
+        if (length == 0)
+            continue;
+        auto span = groove_data::ArraySpan<groove_data::Category>::fromArray(*chunk, 0);
+        if (hasPrev && prev.compare(prevIndex, span, 0) >= 0)
+            return false;
+        for (tu_int64 i = 1; i < length; i++) {
+            if (span.compare(i - 1, span, i) >= 0)
+                return false;
+        }
+        prev = span;
+        prevIndex = length - 1;
+        hasPrev = true;
+    }
+    return true;
+}
+
+bool
+groove_data::keys_are_ordered(const arrow::ChunkedArray &keys, DataKeyType keyType)
+{
+    switch (keyType) {
+        case DataKeyType::KEY_INT64:
+            return numeric_keys_are_ordered<tu_int64>(keys);
+        case DataKeyType::KEY_DOUBLE:
+            return numeric_keys_are_ordered<double>(keys);
+        case DataKeyType::KEY_CATEGORY:
+            return category_keys_are_ordered(keys);
+        default:
+            return false;
+    }
+}
+
+/**
+ * Sorts indices using cmp. The indices are split into one range per thread which are sorted
+ * concurrently, then adjacent ranges are merged pairwise, each round of merges also running
+ * concurrently, until a single sorted range remains.
+ */
+template<typename Compare>
+static void
+parallel_sort(std::vector<tu_int64> &indices, Compare cmp)
+{
+    const tu_int64 size = indices.size();
+    const int numThreads = num_threads_for(size);
+    if (numThreads == 1) {
+        std::sort(indices.begin(), indices.end(), cmp);
+        return;
+    }
+
+    std::vector<tu_int64> bounds;
+    for (int i = 0; i <= numThreads; i++) {
+        bounds.push_back(size * i / numThreads);
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; i++) {
+        threads.emplace_back([&, i] {
+            std::sort(indices.begin() + bounds[i], indices.begin() + bounds[i + 1], cmp);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    while (bounds.size() > 2) {
+        threads.clear();
+        std::vector<tu_int64> merged;
+        for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            auto first = bounds[i], middle = bounds[i + 1], last = bounds[i + 2];
+            threads.emplace_back([&, first, middle, last] {
+                std::inplace_merge(indices.begin() + first, indices.begin() + middle, indices.begin() + last, cmp);
+            });
+            merged.push_back(first);
+        }
+        // an odd range out is carried into the next round unmerged
+        if (bounds.size() % 2 == 0) {
+            merged.push_back(bounds[bounds.size() - 2]);
+        }
+        merged.push_back(bounds.back());
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        bounds = std::move(merged);
+    }
+}
+
+/**
+ * Returns the indices of the rows which remain after sorting by key and dropping every row whose
+ * key is equal to the key of a later row. keyCompare(a, b) compares the keys of rows a and b.
+ */
+template<typename KeyCompare>
+static std::vector<tu_int64>
+sorted_unique_indices(tu_int64 numRows, KeyCompare keyCompare)
+{
+    std::vector<tu_int64> indices(numRows);
+    for (tu_int64 i = 0; i < numRows; i++) {
+        indices[i] = i;
+    }
+
+    // ties are broken on the row index, so rows with equal keys stay in table order
+    parallel_sort(indices, [&](tu_int64 a, tu_int64 b) {
+        int cmp = keyCompare(a, b);
+        return cmp < 0 || (cmp == 0 && a < b);
+    });
+
+    // keep only the last row of each run of equal keys
+    tu_int64 numUnique = 0;
+    for (tu_int64 i = 0; i < numRows; i++) {
+        if (i + 1 == numRows || keyCompare(indices[i], indices[i + 1]) != 0) {
+            indices[numUnique++] = indices[i];
+        }
+    }
+    indices.resize(numUnique);
+    return indices;
+}
+
+template<typename T>
+static tempo_utils::Result<std::vector<tu_int64>>
+sort_numeric_keys(const arrow::ChunkedArray &keys)
+{
+    std::vector<T> values;
+    values.reserve(keys.length());
+    for (const auto &chunk : keys.chunks()) {
+        const T *chunkValues = groove_data::ArraySpan<T>::fromArray(*chunk, 0).values;
+        values.insert(values.end(), chunkValues, chunkValues + chunk->length());
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        for (auto value : values) {
+            if (std::isnan(value))
+                return groove_data::DataStatus::forCondition(
+                    groove_data::DataCondition::kDataInvariant, "NaN is not a valid key");
+        }
+    }
+    return sorted_unique_indices(values.size(), [&](tu_int64 a, tu_int64 b) {
+        return (values[a] > values[b]) - (values[a] < values[b]);
+    });
+}
+
+static tempo_utils::Result<std::vector<tu_int64>>
+sort_category_keys(const arrow::ChunkedArray &keys)
+{
+    std::shared_ptr<arrow::Array> array;
+    if (keys.num_chunks() == 1) {
+        array = keys.chunk(0);
+    } else {
+        auto concatenateResult = arrow::Concatenate(keys.chunks());
+        if (!concatenateResult.ok())
+            return groove_data::DataStatus::forCondition(
+                groove_data::DataCondition::kDataInvariant, "{}", concatenateResult.status().ToString());
+        array = *concatenateResult;
+    }
+    auto span = groove_data::ArraySpan<groove_data::Category>::fromArray(*array, 0);
+    return sorted_unique_indices(array->length(), [&](tu_int64 a, tu_int64 b) {
+        return span.compare(a, span, b);
+    });
+}
+
+static tempo_utils::Result<std::vector<tu_int64>>
+sort_keys(const arrow::ChunkedArray &keys, groove_data::DataKeyType keyType)
+{
+    switch (keyType) {
+        case groove_data::DataKeyType::KEY_INT64:
+            return sort_numeric_keys<tu_int64>(keys);
+        case groove_data::DataKeyType::KEY_DOUBLE:
+            return sort_numeric_keys<double>(keys);
+        case groove_data::DataKeyType::KEY_CATEGORY:
+            return sort_category_keys(keys);
+        default:
+            return groove_data::DataStatus::forCondition(
+                groove_data::DataCondition::kDataInvariant, "invalid key type");
+    }
+}
+
+/**
+ * Takes the rows at the specified indices from every column of the table. Each column is taken
+ * on its own thread when the table is large enough.
+ */
+static tempo_utils::Result<std::shared_ptr<arrow::Table>>
+take_rows(std::shared_ptr<arrow::Table> table, const std::vector<tu_int64> &indices)
+{
+    arrow::Int64Builder indicesBuilder;
+    auto status = indicesBuilder.AppendValues(indices);
+    if (!status.ok())
+        return groove_data::DataStatus::forCondition(
+            groove_data::DataCondition::kDataInvariant, "{}", status.ToString());
+    auto finishIndicesResult = indicesBuilder.Finish();
+    if (!finishIndicesResult.ok())
+        return groove_data::DataStatus::forCondition(
+            groove_data::DataCondition::kDataInvariant, "{}", finishIndicesResult.status().ToString());
+    arrow::Datum takeIndices(*finishIndicesResult);
+
+    const int numColumns = table->num_columns();
+    std::vector<arrow::Result<arrow::Datum>> takeResults(numColumns, arrow::Status::UnknownError("not taken"));
+    auto takeColumn = [&](int i) {
+        takeResults[i] = arrow::compute::Take(arrow::Datum(table->column(i)), takeIndices);
+    };
+
+    if (num_threads_for(table->num_rows()) == 1) {
+        for (int i = 0; i < numColumns; i++) {
+            takeColumn(i);
+        }
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numColumns; i++) {
+            threads.emplace_back(takeColumn, i);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    for (const auto &takeResult : takeResults) {
+        if (!takeResult.ok())
+            return groove_data::DataStatus::forCondition(
+                groove_data::DataCondition::kDataInvariant, "{}", takeResult.status().ToString());
+        columns.push_back(takeResult->chunked_array());
+    }
+    return arrow::Table::Make(table->schema(), columns, indices.size());
+}
+
+tempo_utils::Result<std::shared_ptr<arrow::Table>>
+groove_data::apply_key_ordering(
+    std::shared_ptr<arrow::Table> table,
+    int keyFieldIndex,
+    DataKeyType keyType,
+    KeyOrdering ordering)
+{
+    TU_ASSERT (table != nullptr);
+
+    if (ordering == KeyOrdering::ORDERING_UNCHECKED)
+        return table;
+    auto keys = table->column(keyFieldIndex);
+    if (keys_are_ordered(*keys, keyType))
+        return table;
+    if (ordering != KeyOrdering::ORDERING_SORT)
+        return DataStatus::forCondition(DataCondition::kDataInvariant, "keys are not sorted and unique");
+
+    auto sortKeysResult = sort_keys(*keys, keyType);
+    if (sortKeysResult.isStatus())
+        return sortKeysResult.getStatus();
+    return take_rows(table, sortKeysResult.getResult());
+}
@@ -4,7 +4,6 @@
 #include <arrow/ipc/message.h>
 #include <arrow/ipc/reader.h>
 #include <arrow/ipc/writer.h>
-#include <arrow/buffer_builder.h>
 
 #include <groove_data/table_utils.h>
 
@@ -28,36 +27,29 @@ groove_data::make_table(std::shared_ptr<arrow::Buffer> buffer)
     return *toTableResult;
 }
 
+/**
+ * Buffer which references the contents of a shared string, keeping the string alive for as long
+ * as the buffer (and any arrays decoded from it) is alive.
+ */
+class SharedBytesBuffer : public arrow::Buffer {
+public:
+    explicit SharedBytesBuffer(std::shared_ptr<const std::string> bytes)
+        : arrow::Buffer(std::string_view(*bytes)),
+          m_bytes(std::move(bytes))
+    {
+    }
+
+private:
+    std::shared_ptr<const std::string> m_bytes;
+};
+
 tempo_utils::Result<std::shared_ptr<arrow::Table>>
 groove_data::make_table(std::shared_ptr<const std::string> bytes)
 {
-    if (bytes->empty())
-        return DataStatus::forCondition(DataCondition::kDataInvariant, "invalid buffer");
-
-    // the arrow table needs a buffer to hold the data for the lifetime of the table
-    arrow::BufferBuilder builder;
-    arrow::Status status;
-    status = builder.Resize(bytes->size());
-    if (!status.ok())
-        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to resize buffer");
-    status = builder.Append(bytes->data(), bytes->size());
-    if (!status.ok())
-        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to resize buffer");
-    auto finishBufferResult = builder.Finish();
-    if (!finishBufferResult.ok())
-        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to finalize buffer");
-    std::shared_ptr<arrow::Buffer> buffer = *finishBufferResult;
+    TU_ASSERT (bytes != nullptr);
 
-    arrow::io::BufferReader bufferReader(buffer);
-    auto messageReader = arrow::ipc::MessageReader::Open(&bufferReader);
-    auto openStreamReaderResult = arrow::ipc::RecordBatchStreamReader::Open(std::move(messageReader));
-    if (!openStreamReaderResult.ok())
-        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to parse buffer");
-    auto streamReader = *openStreamReaderResult;
-    auto toTableResult = streamReader->ToTable();
-    if (!toTableResult.ok())
-        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to make table");
-    return *toTableResult;
+    // the table references the string contents directly rather than a copy of them
+    return make_table(std::make_shared<SharedBytesBuffer>(std::move(bytes)));
 }
 
 tempo_utils::Result<std::shared_ptr<const arrow::Buffer>>
@@ -87,3 +79,67 @@ groove_data::make_buffer(std::shared_ptr<const arrow::Table> table)
         return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to write table");
     return std::static_pointer_cast<const arrow::Buffer>(*finishStreamResult);
 }
+
+/**
+ * Output stream which appends everything written to it onto the end of a string.
+ */
+class StringOutputStream : public arrow::io::OutputStream {
+public:
+    explicit StringOutputStream(std::string *bytes)
+        : m_bytes(bytes),
+          m_closed(false)
+    {
+    }
+
+    arrow::Status Close() override
+    {
+        m_closed = true;
+        return arrow::Status::OK();
+    }
+
+    bool closed() const override
+    {
+        return m_closed;
+    }
+
+    arrow::Result<int64_t> Tell() const override
+    {
+        return static_cast<int64_t>(m_bytes->size());
+    }
+
+    arrow::Status Write(const void *data, int64_t nbytes) override
+    {
+        if (m_closed)
+            return arrow::Status::Invalid("stream is closed");
+        m_bytes->append(static_cast<const char *>(data), nbytes);
+        return arrow::Status::OK();
+    }
+
+private:
+    std::string *m_bytes;
+    bool m_closed;
+};
+
+tempo_utils::Status
+groove_data::write_table(std::shared_ptr<const arrow::Table> table, std::string *bytes)
+{
+    TU_ASSERT (table != nullptr);
+    TU_ASSERT (bytes != nullptr);
+
+    bytes->clear();
+    auto stream = std::make_shared<StringOutputStream>(bytes);
+
+    auto makeWriterResult = arrow::ipc::MakeStreamWriter(stream, table->schema());
+    if (!makeWriterResult.ok())
+        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to create stream writer");
+    auto writer = *makeWriterResult;
+
+    arrow::Status status;
+    status = writer->WriteTable(*table);
+    if (!status.ok())
+        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to write table");
+    status = writer->Close();
+    if (!status.ok())
+        return DataStatus::forCondition(DataCondition::kDataInvariant, "failed to write table");
+    return DataStatus::ok();
+}
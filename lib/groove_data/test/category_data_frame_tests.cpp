@@ -5,11 +5,13 @@
 #include <arrow/array/builder_binary.h>
 #include <arrow/array/builder_nested.h>
 
+#include <groove_data/array_utils.h>
 #include <groove_data/category_frame.h>
 #include <groove_data/category_double_vector.h>
 #include <groove_data/category_int64_vector.h>
 #include <groove_data/category_string_vector.h>
 #include <groove_data/category_builder.h>
+#include <groove_data/vector_view_template.h>
 
 class CategoryDataFrameTest : public ::testing::Test {
 protected:
@@ -210,4 +212,170 @@ TEST_F(CategoryDataFrameTest, TestDoubleStringIterateValues)
     ASSERT_EQ (datum.key, groove_data::Category({"b", "d", "e"}));
     ASSERT_EQ (datum.value, "twelve");
     ASSERT_FALSE (iterator.getNext(datum));
-}
\ No newline at end of file
+}
+
+TEST_F(CategoryDataFrameTest, TestSearchCategoryVector)
+{
+    auto vector = groove_data::CategoryDoubleVector::create(table, 0, 2);
+    ASSERT_EQ (groove_data::search_indexed_vector(vector, groove_data::Category({"a"})), 0);
+    ASSERT_EQ (groove_data::search_indexed_vector(vector, groove_data::Category({"b", "c"})), 1);
+    ASSERT_EQ (groove_data::search_indexed_vector(vector, groove_data::Category({"b", "d", "e"})), 2);
+    ASSERT_EQ (groove_data::search_indexed_vector(vector, groove_data::Category({"b"})), -1);
+    ASSERT_EQ (groove_data::search_indexed_vector(vector, groove_data::Category({"b", "d"})), -1);
+    ASSERT_EQ (groove_data::search_indexed_vector(vector, groove_data::Category({"c"})), -1);
+
+    const auto &view = vector->getView();
+    ASSERT_EQ (view.compareKey(1, groove_data::Category({"b"})), 1);
+    ASSERT_EQ (view.compareKey(1, groove_data::Category({"b", "c"})), 0);
+    ASSERT_EQ (view.compareKey(1, groove_data::Category({"b", "c", "a"})), -1);
+    ASSERT_EQ (view.compareKey(1, groove_data::Category({"b", "d"})), -1);
+}
+
+TEST_F(CategoryDataFrameTest, TestSliceCategoryVector)
+{
+    auto vector = groove_data::CategoryDoubleVector::create(table, 0, 2);
+    groove_data::CategoryRange range;
+    range.start = Option<groove_data::Category>(groove_data::Category({"b"}));
+    range.end = Option<groove_data::Category>(groove_data::Category({"b", "d", "e"}));
+    auto slice = vector->slice(range);
+    ASSERT_EQ (slice->getSize(), 1);
+    auto datum = slice->getDatum(0);
+    ASSERT_EQ (datum.key, groove_data::Category({"b", "c"}));
+    ASSERT_DOUBLE_EQ (datum.value, 8.0);
+
+    range.end_exclusive = false;
+    slice = vector->slice(range);
+    ASSERT_EQ (slice->getSize(), 2);
+}
+
+TEST_F(CategoryDataFrameTest, TestDictionaryEncodedKeys)
+{
+    auto keyColumn = table->column(0);
+    auto encodeResult = groove_data::dictionary_encode_categories(keyColumn);
+    ASSERT_TRUE (encodeResult.ok());
+    auto encodedColumn = *encodeResult;
+    ASSERT_TRUE (encodedColumn->type()->Equals(
+        groove_data::CategoryBuilder::makeDatatype(groove_data::CategoryEncoding::ENCODING_DICTIONARY)));
+
+    auto keyField = arrow::field("cat", encodedColumn->type());
+    auto setColumnResult = table->SetColumn(0, keyField, encodedColumn);
+    ASSERT_TRUE (setColumnResult.ok());
+    auto encodedTable = *setColumnResult;
+    ASSERT_TRUE (encodedTable->ValidateFull().ok());
+
+    auto createFrameResult = groove_data::CategoryFrame::create(encodedTable, 0, {{1,-1},{2,-1},{3,-1}});
+    ASSERT_TRUE (createFrameResult.isResult());
+    auto frame = createFrameResult.getResult();
+    ASSERT_EQ (frame->largestKey().getValue(), groove_data::Category({"b", "d", "e"}));
+
+    auto cati64 = std::static_pointer_cast<groove_data::CategoryInt64Vector>(frame->getVector("i64"));
+    auto datum = cati64->getDatum(1);
+    ASSERT_EQ (datum.key, groove_data::Category({"b", "c"}));
+    ASSERT_EQ (datum.value, 5);
+
+    // keys are searched on dictionary codes, including keys with segments missing from the dictionary
+    ASSERT_EQ (groove_data::search_indexed_vector(cati64, groove_data::Category({"b", "c"})), 1);
+    ASSERT_EQ (groove_data::search_indexed_vector(cati64, groove_data::Category({"b", "d", "e"})), 2);
+    ASSERT_EQ (groove_data::search_indexed_vector(cati64, groove_data::Category({"b", "cc"})), -1);
+    ASSERT_EQ (cati64->getView().lowerBound(groove_data::Category({"b", "cc"})), 2);
+    ASSERT_EQ (cati64->getView().lowerBound(groove_data::Category({"0"})), 0);
+    ASSERT_EQ (cati64->getView().upperBound(groove_data::Category({"b"})), 1);
+    ASSERT_EQ (cati64->getView().upperBound(groove_data::Category({"z"})), 3);
+}
+
+TEST_F(CategoryDataFrameTest, TestDictionaryEncodedBuilder)
+{
+    groove_data::CategoryBuilder keyBuilder(groove_data::CategoryEncoding::ENCODING_DICTIONARY);
+    ASSERT_TRUE (keyBuilder.Append(groove_data::Category({"x", "b"})).ok());
+    ASSERT_TRUE (keyBuilder.Append(groove_data::Category({"y", "a"})).ok());
+    auto buildKeyResult = keyBuilder.Finish();
+    ASSERT_TRUE (buildKeyResult.ok());
+    auto keyArray = *buildKeyResult;
+    ASSERT_TRUE (groove_data::is_category_datatype(keyArray->type()));
+
+    auto span = groove_data::ArraySpan<groove_data::Category>::fromArray(*keyArray, 0);
+    ASSERT_TRUE (span.hasOrderedCodes());
+    ASSERT_EQ (span.dictionarySize, 4);
+    ASSERT_EQ (span.at(0), groove_data::Category({"x", "b"}));
+    ASSERT_EQ (span.at(1), groove_data::Category({"y", "a"}));
+    ASSERT_LT (span.codes[3], span.codes[1]);
+}
+
+TEST_F(CategoryDataFrameTest, TestBulkAppendCategories)
+{
+    std::vector<std::string_view> segments = {"a", "b", "c", "b", "d", "e"};
+    std::vector<tu_int32> categoryOffsets = {0, 1, 3, 6};
+
+    groove_data::CategoryBuilder viewBuilder(
+        groove_data::CategoryEncoding::ENCODING_PLAIN, arrow::default_memory_pool());
+    ASSERT_TRUE (viewBuilder.AppendValues(segments, categoryOffsets).ok());
+    auto buildViewResult = viewBuilder.Finish();
+    ASSERT_TRUE (buildViewResult.ok());
+    ASSERT_TRUE ((*buildViewResult)->Equals(*table->column(0)->chunk(0)));
+
+    std::string data = "abcbde";
+    std::vector<tu_int32> segmentOffsets = {0, 1, 2, 3, 4, 5};
+    std::vector<tu_int32> segmentLengths = {1, 1, 1, 1, 1, 1};
+
+    groove_data::CategoryBuilder bufferBuilder;
+    ASSERT_TRUE (bufferBuilder.AppendValues(data, segmentOffsets, segmentLengths, categoryOffsets).ok());
+    auto buildBufferResult = bufferBuilder.Finish();
+    ASSERT_TRUE (buildBufferResult.ok());
+    ASSERT_TRUE ((*buildBufferResult)->Equals(*table->column(0)->chunk(0)));
+
+    std::vector<tu_int32> emptyCategoryOffsets = {0, 1, 1};
+    ASSERT_FALSE (bufferBuilder.AppendValues(segments, emptyCategoryOffsets).ok());
+}
+
+TEST_F(CategoryDataFrameTest, TestBulkAppendRejectsSegmentsOutsideData)
+{
+    std::string data = "abcbde";
+    std::vector<tu_int32> categoryOffsets = {0, 2};
+    groove_data::CategoryBuilder builder;
+
+    // a segment which runs past the end of the data
+    std::vector<tu_int32> segmentOffsets = {0, 5};
+    std::vector<tu_int32> segmentLengths = {1, 2};
+    ASSERT_TRUE (builder.AppendValues(data, segmentOffsets, segmentLengths, categoryOffsets).IsInvalid());
+
+    // a negative offset and a negative length
+    segmentOffsets = {-1, 0};
+    segmentLengths = {1, 1};
+    ASSERT_TRUE (builder.AppendValues(data, segmentOffsets, segmentLengths, categoryOffsets).IsInvalid());
+    segmentOffsets = {0, 1};
+    segmentLengths = {1, -1};
+    ASSERT_TRUE (builder.AppendValues(data, segmentOffsets, segmentLengths, categoryOffsets).IsInvalid());
+
+    // an offset past the end of the data, even with an empty segment
+    segmentOffsets = {0, 7};
+    segmentLengths = {1, 0};
+    ASSERT_TRUE (builder.AppendValues(data, segmentOffsets, segmentLengths, categoryOffsets).IsInvalid());
+
+    // nothing was appended by the rejected calls
+    auto finishResult = builder.Finish();
+    ASSERT_TRUE (finishResult.ok());
+    ASSERT_EQ (0, (*finishResult)->length());
+}
+
+TEST_F(CategoryDataFrameTest, TestUnsortedDictionaryIsNotTrusted)
+{
+    // the dictionary is flagged as ordered but is not sorted, as may happen in an untrusted file
+    arrow::StringBuilder dictionaryBuilder;
+    ASSERT_TRUE (dictionaryBuilder.AppendValues({"b", "a"}).ok());
+    auto dictionary = *dictionaryBuilder.Finish();
+    arrow::Int32Builder indicesBuilder;
+    ASSERT_TRUE (indicesBuilder.AppendValues({1, 0}).ok());
+    auto indices = *indicesBuilder.Finish();
+    auto dictType = arrow::dictionary(arrow::int32(), arrow::utf8(), /* ordered= */ true);
+    auto segments = *arrow::DictionaryArray::FromArrays(dictType, indices, dictionary);
+    arrow::Int32Builder offsetsBuilder;
+    ASSERT_TRUE (offsetsBuilder.AppendValues({0, 1, 2}).ok());
+    auto offsets = *offsetsBuilder.Finish();
+    auto keys = *arrow::ListArray::FromArrays(*offsets, *segments);
+
+    auto span = groove_data::ArraySpan<groove_data::Category>::fromArray(*keys, 0);
+    ASSERT_FALSE (span.hasOrderedCodes());
+    ASSERT_EQ (span.lowerBound(2, groove_data::Category({"a"})), 0);
+    ASSERT_EQ (span.lowerBound(2, groove_data::Category({"b"})), 1);
+    ASSERT_EQ (span.upperBound(2, groove_data::Category({"b"})), 2);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <groove_data/category_builder.h>
+#include <groove_data/compact_category.h>
+#include <groove_data/vector_view_template.h>
+
+static std::vector<groove_data::Category>
+make_categories()
+{
+    using namespace groove_data;
+    return {
+        Category(),
+        Category({""}),
+        Category({"", ""}),
+        Category({"a"}),
+        Category({"a", ""}),
+        Category({"a", "b"}),
+        Category({"aa"}),
+        Category({"ab"}),
+        Category({"b"}),
+        Category({std::string("a\0", 2)}),
+        Category({std::string("a\x01", 2)}),
+        Category({std::string("a\x02", 2)}),
+        Category({std::string("a\0b", 3), "c"}),
+        Category({"abcdefgh"}),
+        Category({"abcdefgh", "i"}),
+        Category({"abcdefghi"}),
+        Category({"\xff"}),
+    };
+}
+
+TEST(CompactCategory, OrderMatchesCategory)
+{
+    using namespace groove_data;
+    auto categories = make_categories();
+    for (const auto &lhs : categories) {
+        CompactCategory lcompact(lhs);
+        for (const auto &rhs : categories) {
+            CompactCategory rcompact(rhs);
+            ASSERT_EQ (lcompact.compare(rcompact), lhs.compare(rhs))
+                << lhs.toString() << " <=> " << rhs.toString();
+            auto cmp = lcompact.getBytes().compare(rcompact.getBytes());
+            ASSERT_EQ (cmp < 0? -1 : cmp > 0? 1 : 0, lhs.compare(rhs));
+        }
+    }
+}
+
+TEST(CompactCategory, DecodeRoundTrip)
+{
+    using namespace groove_data;
+    for (const auto &category : make_categories()) {
+        CompactCategory compact(category);
+        ASSERT_EQ (compact.size(), category.size());
+        ASSERT_EQ (compact.toCategory(), category);
+        ASSERT_EQ (CompactCategory::fromBytes(compact.getBytes()), compact);
+    }
+}
+
+TEST(CompactCategory, AllocateFromArena)
+{
+    using namespace groove_data;
+    CategoryArena arena(16);
+
+    CompactCategory small(Category({"a", "b"}), &arena);
+    ASSERT_EQ (arena.getAllocatedSize(), 16);
+    CompactCategory large(Category({"abcdefghijklmnopqrstuvwxyz"}), &arena);
+    ASSERT_EQ (arena.getAllocatedSize(), 16 + 27);
+    CompactCategory next(Category({"c"}), &arena);
+    ASSERT_EQ (arena.getAllocatedSize(), 16 + 27);
+
+    ASSERT_EQ (small.toCategory(), Category({"a", "b"}));
+    ASSERT_EQ (large.toCategory(), Category({"abcdefghijklmnopqrstuvwxyz"}));
+    ASSERT_EQ (next.toCategory(), Category({"c"}));
+    ASSERT_LT (small, next);
+}
+
+TEST(CompactCategory, AppendToBuilder)
+{
+    using namespace groove_data;
+    CategoryBuilder builder;
+    ASSERT_TRUE (builder.Append(CompactCategory(Category({"a", "b"}))).ok());
+    ASSERT_TRUE (builder.Append(CompactCategory(Category({std::string("c\0", 2)}))).ok());
+    auto finishResult = builder.Finish();
+    ASSERT_TRUE (finishResult.ok());
+
+    auto span = groove_data::ArraySpan<Category>::fromArray(**finishResult, 0);
+    ASSERT_EQ (span.at(0), Category({"a", "b"}));
+    ASSERT_EQ (span.at(1), Category({std::string("c\0", 2)}));
+    ASSERT_EQ (span.toCompact(1), CompactCategory(Category({std::string("c\0", 2)})));
+}
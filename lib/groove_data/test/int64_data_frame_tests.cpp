@@ -8,6 +8,7 @@
 #include <groove_data/int64_double_vector.h>
 #include <groove_data/int64_int64_vector.h>
 #include <groove_data/int64_string_vector.h>
+#include <groove_data/table_utils.h>
 
 class Int64DataFrameTest : public ::testing::Test {
 protected:
@@ -287,4 +288,116 @@ TEST_F(Int64DataFrameTest, TestInt64StringGetSlice)
     range.end_exclusive = false;
     auto slice = i64str->slice(range);
     ASSERT_EQ (slice->getSize(), 2);
-}
\ No newline at end of file
+}
+
+static std::shared_ptr<arrow::Table>
+make_unordered_table()
+{
+    auto keyField = arrow::field("", arrow::int64());
+    auto i64Field = arrow::field("i64", arrow::int64());
+    auto schema = arrow::schema({keyField, i64Field});
+
+    arrow::Int64Builder keyBuilder;
+    TU_ASSERT (keyBuilder.AppendValues({2, 0, 2, 1}).ok());
+    auto buildKeyResult = keyBuilder.Finish();
+    TU_ASSERT (buildKeyResult.ok());
+
+    arrow::Int64Builder i64Builder;
+    TU_ASSERT (i64Builder.AppendValues({1, 2, 3, 4}).ok());
+    auto buildI64Result = i64Builder.Finish();
+    TU_ASSERT (buildI64Result.ok());
+
+    return arrow::Table::Make(schema, {*buildKeyResult, *buildI64Result}, 4);
+}
+
+TEST_F(Int64DataFrameTest, TestRejectUnorderedKeys)
+{
+    auto createFrameResult = groove_data::Int64Frame::create(make_unordered_table(), 0, {{1,-1}});
+    ASSERT_TRUE (createFrameResult.isStatus());
+}
+
+TEST_F(Int64DataFrameTest, TestSortUnorderedKeys)
+{
+    auto createFrameResult = groove_data::Int64Frame::create(make_unordered_table(), 0, {{1,-1}},
+        groove_data::KeyOrdering::ORDERING_SORT);
+    ASSERT_TRUE (createFrameResult.isResult());
+    auto frame = createFrameResult.getResult();
+
+    auto vector = std::static_pointer_cast<groove_data::Int64Int64Vector>(frame->getVector("i64"));
+    ASSERT_EQ (vector->getSize(), 3);
+
+    // the duplicate key 2 keeps the value from the last row in the input
+    auto iterator = vector->iterator();
+    groove_data::Int64Int64Datum datum;
+    ASSERT_TRUE (iterator.getNext(datum));
+    ASSERT_EQ (datum.key, 0);
+    ASSERT_EQ (datum.value, 2);
+    ASSERT_TRUE (iterator.getNext(datum));
+    ASSERT_EQ (datum.key, 1);
+    ASSERT_EQ (datum.value, 4);
+    ASSERT_TRUE (iterator.getNext(datum));
+    ASSERT_EQ (datum.key, 2);
+    ASSERT_EQ (datum.value, 3);
+    ASSERT_FALSE (iterator.getNext(datum));
+}
+
+TEST_F(Int64DataFrameTest, TestTableRoundTripsThroughBytesInPlace)
+{
+    auto bytes = std::make_shared<std::string>();
+    ASSERT_TRUE (groove_data::write_table(table, bytes.get()).isOk());
+    ASSERT_FALSE (bytes->empty());
+
+    auto makeTableResult = groove_data::make_table(std::shared_ptr<const std::string>(bytes));
+    ASSERT_TRUE (makeTableResult.isResult());
+    auto decoded = makeTableResult.getResult();
+    ASSERT_TRUE (decoded->Equals(*table));
+
+    // the decoded values point into the string rather than into a copy of it
+    auto keys = decoded->column(0)->chunk(0)->data()->buffers[1];
+    ASSERT_GE (keys->data(), (const uint8_t *) bytes->data());
+    ASSERT_LT (keys->data(), (const uint8_t *) bytes->data() + bytes->size());
+}
+
+TEST_F(Int64DataFrameTest, TestSortLargeTableKeepsLastOfTies)
+{
+    // enough rows to take the multithreaded sort and take paths. every key appears in three rows,
+    // one in each block of kNumKeys rows, and the value of each row is its index in the table
+    constexpr tu_int64 kNumKeys = 100000;
+    constexpr tu_int64 kNumRows = 3 * kNumKeys;
+    auto keyOf = [](tu_int64 row) { return (row * 7919) % kNumKeys; };
+
+    arrow::ArrayVector keyChunks, i64Chunks;
+    for (tu_int64 start = 0; start < kNumRows; start += kNumRows / 2) {
+        arrow::Int64Builder keyBuilder;
+        arrow::Int64Builder i64Builder;
+        for (tu_int64 row = start; row < start + kNumRows / 2; row++) {
+            ASSERT_TRUE (keyBuilder.Append(keyOf(row)).ok());
+            ASSERT_TRUE (i64Builder.Append(row).ok());
+        }
+        keyChunks.push_back(*keyBuilder.Finish());
+        i64Chunks.push_back(*i64Builder.Finish());
+    }
+    auto unorderedSchema = arrow::schema({arrow::field("", arrow::int64()), arrow::field("i64", arrow::int64())});
+    auto unordered = arrow::Table::Make(unorderedSchema, {
+        std::make_shared<arrow::ChunkedArray>(keyChunks),
+        std::make_shared<arrow::ChunkedArray>(i64Chunks)});
+
+    auto createFrameResult = groove_data::Int64Frame::create(unordered, 0, {{1,-1}},
+        groove_data::KeyOrdering::ORDERING_SORT);
+    ASSERT_TRUE (createFrameResult.isResult());
+    auto frame = createFrameResult.getResult();
+
+    auto vector = std::static_pointer_cast<groove_data::Int64Int64Vector>(frame->getVector("i64"));
+    ASSERT_EQ (vector->getSize(), kNumKeys);
+
+    // ties are broken in table order, so each key keeps the row from the last block
+    auto iterator = vector->iterator();
+    groove_data::Int64Int64Datum datum;
+    for (tu_int64 key = 0; key < kNumKeys; key++) {
+        ASSERT_TRUE (iterator.getNext(datum));
+        ASSERT_EQ (datum.key, key);
+        ASSERT_GE (datum.value, 2 * kNumKeys);
+        ASSERT_EQ (keyOf(datum.value), key);
+    }
+    ASSERT_FALSE (iterator.getNext(datum));
+}
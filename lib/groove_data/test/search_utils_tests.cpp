@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <groove_data/search_utils.h>
+
+TEST(SearchUtils, TestInt64BoundsMatchStandardLibrary)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<tu_int64> dist(-50, 50);
+
+    for (int size = 0; size < 100; size++) {
+        std::vector<tu_int64> keys(size);
+        for (auto &key : keys) {
+            key = dist(rng);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        for (tu_int64 key = -52; key <= 52; key++) {
+            auto lower = std::lower_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin();
+            auto upper = std::upper_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin();
+            ASSERT_EQ (groove_data::search_lower_bound(keys.data(), size, key), lower);
+            ASSERT_EQ (groove_data::search_upper_bound(keys.data(), size, key), upper);
+        }
+    }
+}
+
+TEST(SearchUtils, TestDoubleBoundsMatchStandardLibrary)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> dist(-50, 50);
+
+    for (int size = 0; size < 100; size++) {
+        std::vector<double> keys(size);
+        for (auto &key : keys) {
+            key = dist(rng) / 2.0;
+        }
+        std::sort(keys.begin(), keys.end());
+
+        for (int i = -104; i <= 104; i++) {
+            double key = i / 4.0;
+            auto lower = std::lower_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin();
+            auto upper = std::upper_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin();
+            ASSERT_EQ (groove_data::search_lower_bound(keys.data(), size, key), lower);
+            ASSERT_EQ (groove_data::search_upper_bound(keys.data(), size, key), upper);
+        }
+    }
+}
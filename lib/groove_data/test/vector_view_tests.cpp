@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <arrow/table.h>
+#include <arrow/array/builder_primitive.h>
+
+#include <groove_data/int64_double_vector.h>
+
+class VectorViewTest : public ::testing::Test {
+protected:
+    std::shared_ptr<arrow::Table> table;
+
+    std::shared_ptr<arrow::Array> makeInt64Array(std::vector<tu_int64> values) {
+        arrow::Int64Builder builder;
+        TU_ASSERT (builder.AppendValues(values).ok());
+        auto buildResult = builder.Finish();
+        TU_ASSERT (buildResult.ok());
+        return *buildResult;
+    }
+
+    std::shared_ptr<arrow::Array> makeDoubleArray(std::vector<double> values) {
+        arrow::DoubleBuilder builder;
+        TU_ASSERT (builder.AppendValues(values).ok());
+        auto buildResult = builder.Finish();
+        TU_ASSERT (buildResult.ok());
+        return *buildResult;
+    }
+
+    std::shared_ptr<arrow::Array> makeBooleanArray(int length) {
+        arrow::BooleanBuilder builder;
+        TU_ASSERT (builder.AppendNulls(length).ok());
+        auto buildResult = builder.Finish();
+        TU_ASSERT (buildResult.ok());
+        return *buildResult;
+    }
+
+    void SetUp() override {
+        auto keyField = arrow::field("", arrow::int64());
+        auto dblField = arrow::field("dbl", arrow::float64());
+        auto fidField = arrow::field("", arrow::boolean());
+        auto schema = arrow::schema({keyField, dblField, fidField});
+
+        // each column is chunked differently, so the view must split at every chunk boundary
+        auto keyColumn = std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+            makeInt64Array({0, 1}),
+            makeInt64Array({2, 3, 4}),
+        });
+        auto dblColumn = std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+            makeDoubleArray({0.0}),
+            makeDoubleArray({}),
+            makeDoubleArray({1.0, 2.0, 3.0}),
+            makeDoubleArray({4.0}),
+        });
+        auto fidColumn = std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+            makeBooleanArray(5),
+        });
+
+        table = arrow::Table::Make(schema, {keyColumn, dblColumn, fidColumn});
+        TU_ASSERT (table->ValidateFull().ok());
+    }
+};
+
+TEST_F(VectorViewTest, TestResolveChunks)
+{
+    auto vector = groove_data::Int64DoubleVector::create(table, 0, 1, 2);
+    const auto &view = vector->getView();
+    ASSERT_EQ (view.getSize(), 5);
+    ASSERT_EQ (view.numChunks(), 4);
+    ASSERT_EQ (view.getChunkOffset(0), 0);
+    ASSERT_EQ (view.getChunkOffset(1), 1);
+    ASSERT_EQ (view.getChunkOffset(2), 2);
+    ASSERT_EQ (view.getChunkOffset(3), 4);
+    ASSERT_EQ (view.findChunk(0), 0);
+    ASSERT_EQ (view.findChunk(1), 1);
+    ASSERT_EQ (view.findChunk(3), 2);
+    ASSERT_EQ (view.findChunk(4), 3);
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ (view.getKey(i), i);
+        ASSERT_DOUBLE_EQ (view.getValue(i), static_cast<double>(i));
+    }
+}
+
+TEST_F(VectorViewTest, TestIterateChunkedVector)
+{
+    auto vector = groove_data::Int64DoubleVector::create(table, 0, 1, 2);
+    auto iterator = vector->iterator();
+    groove_data::Int64DoubleDatum datum;
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE (iterator.getNext(datum));
+        ASSERT_EQ (datum.key, i);
+        ASSERT_DOUBLE_EQ (datum.value, static_cast<double>(i));
+        ASSERT_EQ (datum.fidelity, groove_data::DatumFidelity::FIDELITY_VALID);
+    }
+    ASSERT_FALSE (iterator.getNext(datum));
+}
+
+TEST_F(VectorViewTest, TestSliceChunkedVector)
+{
+    auto vector = groove_data::Int64DoubleVector::create(table, 0, 1, 2);
+    groove_data::Int64Range range;
+    range.start = Option<tu_int64>(1);
+    range.end = Option<tu_int64>(4);
+    auto slice = vector->slice(range);
+    ASSERT_EQ (slice->getSize(), 3);
+
+    auto datum = slice->getDatum(0);
+    ASSERT_EQ (datum.key, 1);
+    ASSERT_DOUBLE_EQ (datum.value, 1.0);
+    datum = slice->getDatum(2);
+    ASSERT_EQ (datum.key, 3);
+    ASSERT_DOUBLE_EQ (datum.value, 3.0);
+    datum = slice->getDatum(3);
+    ASSERT_EQ (datum.fidelity, groove_data::DatumFidelity::FIDELITY_INVALID);
+}
+
+TEST_F(VectorViewTest, TestIterateChunkedVectorInBatches)
+{
+    auto vector = groove_data::Int64DoubleVector::create(table, 0, 1, 2);
+    auto iterator = vector->iterator();
+    groove_data::Int64DoubleDatum batch[3];
+
+    ASSERT_EQ (iterator.getNextBatch(batch, 3), 3);
+    ASSERT_EQ (batch[0].key, 0);
+    ASSERT_EQ (batch[1].key, 1);
+    ASSERT_EQ (batch[2].key, 2);
+    ASSERT_DOUBLE_EQ (batch[2].value, 2.0);
+    ASSERT_EQ (iterator.getNextBatch(batch, 3), 2);
+    ASSERT_EQ (batch[0].key, 3);
+    ASSERT_EQ (batch[1].key, 4);
+    ASSERT_DOUBLE_EQ (batch[1].value, 4.0);
+    ASSERT_EQ (iterator.getNextBatch(batch, 3), 0);
+}
+
+TEST_F(VectorViewTest, TestFidelityFromValueValidity)
+{
+    auto vector = groove_data::Int64DoubleVector::create(table, 0, 1, 2);
+    ASSERT_TRUE (vector->getView().isAllValid());
+
+    arrow::DoubleBuilder dblBuilder;
+    TU_ASSERT (dblBuilder.Append(0.0).ok());
+    TU_ASSERT (dblBuilder.AppendNull().ok());
+    TU_ASSERT (dblBuilder.Append(2.0).ok());
+    auto buildDblResult = dblBuilder.Finish();
+    TU_ASSERT (buildDblResult.ok());
+
+    auto schema = arrow::schema({arrow::field("", arrow::int64()), arrow::field("dbl", arrow::float64())});
+    auto sparse = arrow::Table::Make(schema, {makeInt64Array({0, 1, 2}), *buildDblResult});
+    auto sparseVector = groove_data::Int64DoubleVector::create(sparse, 0, 1);
+    const auto &view = sparseVector->getView();
+    ASSERT_FALSE (view.isAllValid());
+    ASSERT_EQ (view.getFidelity(0), groove_data::DatumFidelity::FIDELITY_VALID);
+    ASSERT_EQ (view.getFidelity(1), groove_data::DatumFidelity::FIDELITY_MISSING);
+    ASSERT_EQ (sparseVector->getDatum(2).fidelity, groove_data::DatumFidelity::FIDELITY_VALID);
+}
+
+TEST_F(VectorViewTest, TestFidelityFromCodes)
+{
+    arrow::Int8Builder fidBuilder;
+    TU_ASSERT (fidBuilder.Append(static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID)).ok());
+    TU_ASSERT (fidBuilder.Append(static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_APPROXIMATE)).ok());
+    auto buildFidResult = fidBuilder.Finish();
+    TU_ASSERT (buildFidResult.ok());
+
+    auto schema = arrow::schema({
+        arrow::field("", arrow::int64()),
+        arrow::field("dbl", arrow::float64()),
+        arrow::field("", arrow::int8()),
+    });
+    auto coded = arrow::Table::Make(schema, {makeInt64Array({0, 1}), makeDoubleArray({0.0, 1.0}), *buildFidResult});
+    auto vector = groove_data::Int64DoubleVector::create(coded, 0, 1, 2);
+    ASSERT_FALSE (vector->getView().isAllValid());
+
+    auto iterator = vector->iterator();
+    groove_data::Int64DoubleDatum datum;
+    ASSERT_TRUE (iterator.getNext(datum));
+    ASSERT_EQ (datum.fidelity, groove_data::DatumFidelity::FIDELITY_VALID);
+    ASSERT_TRUE (iterator.getNext(datum));
+    ASSERT_EQ (datum.fidelity, groove_data::DatumFidelity::FIDELITY_APPROXIMATE);
+    ASSERT_DOUBLE_EQ (datum.value, 1.0);
+}
@@ -56,6 +56,9 @@ namespace groove_io {
             GrooveIndex index,
             groove_model::GrooveSchema schema,
             tempo_utils::Slice content);
+
+        groove_model::PageId toIndexPageId(const groove_model::PageId &pageId) const;
+        groove_model::PageId fromIndexPageId(const groove_model::PageId &pageId) const;
     };
 
     class DatasetPage : public arrow::Buffer {
@@ -18,6 +18,8 @@ namespace groove_io {
         int maxFrameSize = 1024 * 1024;     // if frame is larger than maxFrameSize then split it into multiple frames
         int idealFrameSize = 65536;         // when splitting frames use idealFrameSize as the target size
         bool stripMetadata = true;          // if true then remove custom key-value metadata from frames
+        bool encodeCategoryKeys = false;    // if true then dictionary encode the segments of category keys
+        bool writeStatistics = true;        // if true then attach page statistics to the key and value fields
     };
 
     class DatasetWriter {
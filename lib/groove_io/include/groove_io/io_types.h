@@ -7,6 +7,13 @@ namespace groove_io {
 
     constexpr tu_uint32 kInvalidOffsetU32 = 0xFFFFFFFF;
 
+    /**
+     * The version of the dataset file format. Version 1 files encode the category keys of page ids
+     * in the legacy encoding, see groove_model::kCategoryKeyTag.
+     */
+    constexpr tu_uint8 kLegacyCategoryKeysDatasetVersion = 1;
+    constexpr tu_uint8 kCurrentDatasetVersion = 2;
+
     enum class IndexVersion {
         Unknown,
         Version1,
@@ -55,6 +55,32 @@ groove_io::DatasetReader::getSchema() const
     return m_schema;
 }
 
+/**
+ * Returns the page id as it is stored in the index. Version 1 files store category keys in the
+ * legacy encoding, so lookups must be translated before searching the index.
+ */
+groove_model::PageId
+groove_io::DatasetReader::toIndexPageId(const groove_model::PageId &pageId) const
+{
+    if (m_version != kLegacyCategoryKeysDatasetVersion)
+        return pageId;
+    std::string legacyId;
+    if (!groove_model::convert_category_page_id_to_legacy(pageId.getBytes(), legacyId))
+        return pageId;
+    return groove_model::PageId::fromString(legacyId);
+}
+
+groove_model::PageId
+groove_io::DatasetReader::fromIndexPageId(const groove_model::PageId &pageId) const
+{
+    if (m_version != kLegacyCategoryKeysDatasetVersion)
+        return pageId;
+    std::string currentId;
+    if (!groove_model::convert_legacy_category_page_id(pageId.getBytes(), currentId))
+        return pageId;
+    return groove_model::PageId::fromString(currentId);
+}
+
 bool
 groove_io::DatasetReader::isEmpty()
 {
@@ -73,15 +99,17 @@ groove_io::DatasetReader::getPageIdBefore(
             groove_model::ModelCondition::kModelInvariant, "reader is not valid");
 
     auto index = m_index.getIndex();
-    auto vector = index.findVectorBefore(pageId);
+    auto indexPageId = toIndexPageId(pageId);
+    auto vector = index.findVectorBefore(indexPageId);
     if (!vector.isValid() && !exclusive) {
-        vector = index.findVector(pageId);
+        vector = index.findVector(indexPageId);
     }
-    if (!vector.isValid())
+    // the neighbouring vector may belong to another column, in which case there is no page
+    if (!vector.isValid() || vector.getPageId().getPrefix() != pageId.getPrefix())
         return groove_model::ModelStatus::forCondition(
-            groove_model::ModelCondition::kModelInvariant);
+            groove_model::ModelCondition::kPageNotFound);
 
-    return vector.getPageId();
+    return fromIndexPageId(vector.getPageId());
 }
 
 tempo_utils::Result<groove_model::PageId>
@@ -94,15 +122,17 @@ groove_io::DatasetReader::getPageIdAfter(
             groove_model::ModelCondition::kModelInvariant, "reader is not valid");
 
     auto index = m_index.getIndex();
-    auto vector = index.findVectorAfter(pageId);
+    auto indexPageId = toIndexPageId(pageId);
+    auto vector = index.findVectorAfter(indexPageId);
     if (!vector.isValid() && !exclusive) {
-        vector = index.findVector(pageId);
+        vector = index.findVector(indexPageId);
     }
-    if (!vector.isValid())
+    // the neighbouring vector may belong to another column, in which case there is no page
+    if (!vector.isValid() || vector.getPageId().getPrefix() != pageId.getPrefix())
         return groove_model::ModelStatus::forCondition(
-            groove_model::ModelCondition::kModelInvariant);
+            groove_model::ModelCondition::kPageNotFound);
 
-    return vector.getPageId();
+    return fromIndexPageId(vector.getPageId());
 }
 
 tempo_utils::Result<std::shared_ptr<arrow::Buffer>>
@@ -114,7 +144,7 @@ groove_io::DatasetReader::getPageData(
             groove_model::ModelCondition::kModelInvariant, "reader is not valid");
 
     auto index = m_index.getIndex();
-    auto vector = index.findVector(pageId);
+    auto vector = index.findVector(toIndexPageId(pageId));
     if (!vector.isValid())
         return groove_model::ModelStatus::forCondition(
             groove_model::ModelCondition::kModelInvariant);
@@ -142,7 +172,7 @@ groove_io::DatasetReader::pageExists(const groove_model::PageId &pageId)
             groove_model::ModelCondition::kModelInvariant, "reader is not valid");
 
     auto index = m_index.getIndex();
-    auto vector = index.findVector(pageId);
+    auto vector = index.findVector(toIndexPageId(pageId));
     if (!vector.isValid())
         return groove_model::ModelStatus::forCondition(
             groove_model::ModelCondition::kModelInvariant);
@@ -169,6 +199,9 @@ groove_io::DatasetReader::create(const std::filesystem::path &datasetPath)
     mmapData += 4;
 
     auto version = tempo_utils::read_u8_and_advance(mmapData);
+    if (version == 0 || version > kCurrentDatasetVersion)
+        return IOStatus::forCondition(
+            IOCondition::kIOInvariant, "unsupported dataset version");
     auto flags = tempo_utils::read_u8_and_advance(mmapData);
     auto indexSize = tempo_utils::read_u32_and_advance(mmapData);
     mmapSize -= 10;
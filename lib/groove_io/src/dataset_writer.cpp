@@ -6,6 +6,7 @@
 #include <arrow/ipc/writer.h>
 #include <arrow/table.h>
 
+#include <groove_data/array_utils.h>
 #include <groove_data/category_double_vector.h>
 #include <groove_data/category_int64_vector.h>
 #include <groove_data/category_string_vector.h>
@@ -17,6 +18,8 @@
 #include <groove_data/int64_string_vector.h>
 #include <groove_io/dataset_writer.h>
 #include <groove_io/index_state.h>
+#include <groove_io/io_types.h>
+#include <groove_model/page_statistics.h>
 #include <tempo_utils/file_appender.h>
 
 groove_io::DatasetWriter::DatasetWriter(const tempo_utils::Url &datasetUrl, const groove_model::GrooveSchema &schema)
@@ -137,6 +140,99 @@ static std::shared_ptr<const arrow::Buffer> serialize_table(std::shared_ptr<cons
     return buffer;
 }
 
+static tempo_utils::Result<std::shared_ptr<const arrow::Table>>
+encode_category_keys(std::shared_ptr<const arrow::Table> table, int keyFieldIndex)
+{
+    auto keyField = table->schema()->field(keyFieldIndex);
+    if (!groove_data::is_category_datatype(keyField->type()))
+        return table;
+    auto encodeResult = groove_data::dictionary_encode_categories(table->column(keyFieldIndex));
+    if (!encodeResult.ok())
+        return groove_io::IOStatus::forCondition(
+            groove_io::IOCondition::kIOInvariant, encodeResult.status().ToString());
+    auto keyColumn = *encodeResult;
+    auto setColumnResult = table->SetColumn(keyFieldIndex, keyField->WithType(keyColumn->type()), keyColumn);
+    if (!setColumnResult.ok())
+        return groove_io::IOStatus::forCondition(
+            groove_io::IOCondition::kIOInvariant, setColumnResult.status().ToString());
+    return std::shared_ptr<const arrow::Table>(*setColumnResult);
+}
+
+template <typename DefType, typename VectorType>
+static std::shared_ptr<arrow::Schema>
+annotate_schema_from_vector(
+    std::shared_ptr<arrow::Schema> schema,
+    int keyFieldIndex,
+    int valFieldIndex,
+    std::shared_ptr<groove_data::BaseVector> vector)
+{
+    auto vec = std::static_pointer_cast<VectorType>(vector);
+    auto statistics = groove_model::PageStatistics<DefType>::fromVector(*vec);
+    return statistics.annotateSchema(schema, keyFieldIndex, valFieldIndex);
+}
+
+static tempo_utils::Result<std::shared_ptr<arrow::Schema>>
+annotate_schema(
+    std::shared_ptr<arrow::Schema> schema,
+    int keyFieldIndex,
+    int valFieldIndex,
+    std::shared_ptr<groove_data::BaseVector> vector)
+{
+    switch (vector->getVectorType()) {
+        case groove_data::DataVectorType::VECTOR_TYPE_CATEGORY_DOUBLE:
+            return annotate_schema_from_vector<groove_model::CategoryDouble,groove_data::CategoryDoubleVector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_CATEGORY_INT64:
+            return annotate_schema_from_vector<groove_model::CategoryInt64,groove_data::CategoryInt64Vector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_CATEGORY_STRING:
+            return annotate_schema_from_vector<groove_model::CategoryString,groove_data::CategoryStringVector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_DOUBLE_DOUBLE:
+            return annotate_schema_from_vector<groove_model::DoubleDouble,groove_data::DoubleDoubleVector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_DOUBLE_INT64:
+            return annotate_schema_from_vector<groove_model::DoubleInt64,groove_data::DoubleInt64Vector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_DOUBLE_STRING:
+            return annotate_schema_from_vector<groove_model::DoubleString,groove_data::DoubleStringVector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_INT64_DOUBLE:
+            return annotate_schema_from_vector<groove_model::Int64Double,groove_data::Int64DoubleVector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_INT64_INT64:
+            return annotate_schema_from_vector<groove_model::Int64Int64,groove_data::Int64Int64Vector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        case groove_data::DataVectorType::VECTOR_TYPE_INT64_STRING:
+            return annotate_schema_from_vector<groove_model::Int64String,groove_data::Int64StringVector>(
+                schema, keyFieldIndex, valFieldIndex, vector);
+        default:
+            return groove_io::IOStatus::forCondition(
+                groove_io::IOCondition::kIOInvariant, "invalid vector type");
+    }
+}
+
+/**
+ * Attaches the statistics of each vector to the key and value fields of the frame table, so
+ * that the statistics can be read from the frame schema without decoding the frame contents.
+ */
+static tempo_utils::Result<std::shared_ptr<const arrow::Table>>
+write_frame_statistics(
+    std::shared_ptr<const arrow::Table> table,
+    int keyFieldIndex,
+    const std::vector<std::pair<int,std::shared_ptr<groove_data::BaseVector>>> &vectors)
+{
+    auto schema = table->schema();
+    for (const auto &entry : vectors) {
+        auto annotateResult = annotate_schema(schema, keyFieldIndex, entry.first, entry.second);
+        if (annotateResult.isStatus())
+            return annotateResult.getStatus();
+        schema = annotateResult.getResult();
+    }
+    return std::shared_ptr<const arrow::Table>(
+        arrow::Table::Make(schema, table->columns(), table->num_rows()));
+}
+
 tempo_utils::Status
 groove_io::DatasetWriter::putVector(
     const std::string &modelId,
@@ -281,7 +377,21 @@ groove_io::DatasetWriter::putVector(
     if (vector->getFidFieldIndex() >= 0) {
         columns.push_back(underlyingTable->column(vector->getFidFieldIndex()));
     }
-    auto table = arrow::Table::Make(schema, columns);
+    std::shared_ptr<const arrow::Table> table = arrow::Table::Make(schema, columns);
+
+    if (m_options.encodeCategoryKeys) {
+        auto encodeKeysResult = encode_category_keys(table, 0);
+        if (encodeKeysResult.isStatus())
+            return encodeKeysResult.getStatus();
+        table = encodeKeysResult.getResult();
+    }
+
+    if (m_options.writeStatistics) {
+        auto writeStatisticsResult = write_frame_statistics(table, 0, {{1, vector}});
+        if (writeStatisticsResult.isStatus())
+            return writeStatisticsResult.getStatus();
+        table = writeStatisticsResult.getResult();
+    }
 
     //
     auto framePriv = std::make_unique<FramePriv>();
@@ -299,9 +409,28 @@ groove_io::DatasetWriter::putFrame(
     const std::string &modelId,
     std::shared_ptr<groove_data::BaseFrame> frame)
 {
+    auto table = frame->getUnderlyingTable();
+    if (m_options.encodeCategoryKeys) {
+        auto encodeKeysResult = encode_category_keys(table, frame->getKeyFieldIndex());
+        if (encodeKeysResult.isStatus())
+            return encodeKeysResult.getStatus();
+        table = encodeKeysResult.getResult();
+    }
+
+    if (m_options.writeStatistics) {
+        std::vector<std::pair<int,std::shared_ptr<groove_data::BaseVector>>> vectors;
+        for (auto iterator = frame->vectorsBegin(); iterator != frame->vectorsEnd(); iterator++) {
+            vectors.emplace_back(iterator->second->getValFieldIndex(), iterator->second);
+        }
+        auto writeStatisticsResult = write_frame_statistics(table, frame->getKeyFieldIndex(), vectors);
+        if (writeStatisticsResult.isStatus())
+            return writeStatisticsResult.getStatus();
+        table = writeStatisticsResult.getResult();
+    }
+
     auto framePriv = std::make_unique<FramePriv>();
     framePriv->keyOffset = frame->getKeyFieldIndex();
-    framePriv->frameBytes = serialize_table(frame->getUnderlyingTable());
+    framePriv->frameBytes = serialize_table(table);
 
     tu_uint32 frameIndex = m_frames.size();
     m_frames.push_back(std::move(framePriv));
@@ -354,7 +483,7 @@ groove_io::DatasetWriter::writeDataset(const std::filesystem::path &datasetPath)
         return IOStatus::forCondition(IOCondition::kIOInvariant, "failed to write dataset file identifier");
 
     // write the prologue
-    status = appender.appendU8(1);                                                  // version: u8
+    status = appender.appendU8(kCurrentDatasetVersion);                             // version: u8
     if (status.notOk())
         return IOStatus::forCondition(IOCondition::kIOInvariant, "failed to write dataset file version");
     status = appender.appendU8(0);                                                  // flags: u8
@@ -0,0 +1,370 @@
+#ifndef GROOVE_ITERATOR_ASYNC_GENERATOR_TEMPLATE_H
+#define GROOVE_ITERATOR_ASYNC_GENERATOR_TEMPLATE_H
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <tempo_utils/log_stream.h>
+#include <tempo_utils/status.h>
+
+namespace groove_iterator {
+
+    /**
+     * a value which is delivered once, usually from a callback such as a page fetch or rpc read
+     * completion, and which a coroutine awaits with co_await. the awaiting coroutine is suspended
+     * without blocking a thread and is resumed on the thread which calls complete, or continues
+     * immediately if the value was already delivered. copies share the same value, so the
+     * callback can hold one copy while the coroutine awaits another. at most one coroutine may
+     * await a completion.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class Completion {
+
+        // the state moves from kEmpty to either kAwaiting or kComplete, and then to kResumed
+        enum : int { kEmpty, kAwaiting, kComplete, kResumed };
+
+        struct SharedState {
+            std::atomic<int> state{kEmpty};
+            std::optional<T> value;
+            std::coroutine_handle<> awaiting;
+        };
+
+    public:
+        Completion()
+            : m_shared(std::make_shared<SharedState>())
+        {
+        };
+
+        bool
+        isComplete() const
+        {
+            auto state = m_shared->state.load(std::memory_order_acquire);
+            return state == kComplete || state == kResumed;
+        };
+
+        /**
+         * delivers the value, and resumes the awaiting coroutine if there is one. must be called
+         * at most once.
+         *
+         * @param value
+         */
+        void
+        complete(T value)
+        {
+            m_shared->value.emplace(std::move(value));
+            auto previous = m_shared->state.exchange(kComplete, std::memory_order_acq_rel);
+            TU_ASSERT (previous == kEmpty || previous == kAwaiting);
+            if (previous == kAwaiting) {
+                m_shared->state.store(kResumed, std::memory_order_release);
+                m_shared->awaiting.resume();
+            }
+        };
+
+        bool
+        await_ready() const noexcept
+        {
+            return isComplete();
+        };
+
+        bool
+        await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            m_shared->awaiting = handle;
+            int expected = kEmpty;
+            // if complete won the race then the coroutine continues without suspending
+            return m_shared->state.compare_exchange_strong(expected, kAwaiting, std::memory_order_acq_rel);
+        };
+
+        T
+        await_resume()
+        {
+            TU_ASSERT (m_shared->value.has_value());
+            return std::move(*m_shared->value);
+        };
+
+    private:
+        std::shared_ptr<SharedState> m_shared;
+    };
+
+    /**
+     * a coroutine which starts running as soon as it is called and runs until it first suspends,
+     * for example on a Completion, and which is resumed by whatever it awaits. a task is the
+     * entry point which drives async generators from non-coroutine code, such as an rpc
+     * reactor. the task finishes with co_return of a status. destroying the task destroys the
+     * coroutine, so a task must outlive anything which may resume it.
+     */
+    class Task {
+
+    public:
+        struct promise_type {
+            tempo_utils::Status status;
+            std::exception_ptr exception;
+
+            Task
+            get_return_object()
+            {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            };
+
+            std::suspend_never initial_suspend() noexcept { return {}; };
+            std::suspend_always final_suspend() noexcept { return {}; };
+            void return_value(tempo_utils::Status result) { status = std::move(result); };
+            void unhandled_exception() { exception = std::current_exception(); };
+        };
+
+        using HandleType = std::coroutine_handle<promise_type>;
+
+        Task(Task &&other) noexcept
+            : m_handle(std::exchange(other.m_handle, {}))
+        {
+        };
+
+        Task(const Task &other) = delete;
+        Task &operator=(const Task &other) = delete;
+        Task &operator=(Task &&other) = delete;
+
+        ~Task()
+        {
+            if (m_handle)
+                m_handle.destroy();
+        };
+
+        bool
+        isDone() const
+        {
+            return m_handle && m_handle.done();
+        };
+
+        /**
+         * returns the status the task finished with, the task must be done.
+         *
+         * @return
+         */
+        tempo_utils::Status
+        getStatus() const
+        {
+            TU_ASSERT (isDone());
+            auto &promise = m_handle.promise();
+            if (promise.exception)
+                std::rethrow_exception(promise.exception);
+            return promise.status;
+        };
+
+    private:
+        HandleType m_handle;
+
+        explicit Task(HandleType handle)
+            : m_handle(handle)
+        {
+        };
+    };
+
+    /**
+     * the asynchronous counterpart of Generator. the coroutine may co_await between values, for
+     * example on a Completion filled by a page fetch or rpc callback, and the consumer, which must
+     * itself be a coroutine, awaits each value with co_await next(value). no thread blocks while
+     * either side waits: the consumer is suspended until the producer yields, and the producer is
+     * suspended until whatever it awaits resumes it. control passes between the two coroutines by
+     * symmetric transfer, so long pipelines do not grow the stack. the coroutine finishes with
+     * co_return of a status, returned by getStatus once next has returned false.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class AsyncGenerator {
+
+    public:
+        struct promise_type;
+        using HandleType = std::coroutine_handle<promise_type>;
+
+        // transfers control back to the consumer when the producer yields or finishes
+        struct ResumeConsumer {
+            bool await_ready() const noexcept { return false; };
+            std::coroutine_handle<> await_suspend(HandleType handle) noexcept { return handle.promise().consumer; };
+            void await_resume() const noexcept {};
+        };
+
+        struct promise_type {
+            T *current = nullptr;
+            bool movable = false;
+            tempo_utils::Status status;
+            std::exception_ptr exception;
+            std::coroutine_handle<> consumer;
+
+            AsyncGenerator
+            get_return_object()
+            {
+                return AsyncGenerator(HandleType::from_promise(*this));
+            };
+
+            std::suspend_always initial_suspend() noexcept { return {}; };
+            ResumeConsumer final_suspend() noexcept { return {}; };
+
+            ResumeConsumer
+            yield_value(T &value) noexcept
+            {
+                current = std::addressof(value);
+                movable = false;
+                return {};
+            };
+
+            ResumeConsumer
+            yield_value(T &&value) noexcept
+            {
+                current = std::addressof(value);
+                movable = true;
+                return {};
+            };
+
+            void return_value(tempo_utils::Status result) { status = std::move(result); };
+            void unhandled_exception() { exception = std::current_exception(); };
+        };
+
+        // resumes the producer until it yields the next value or finishes
+        struct NextAwaiter {
+            HandleType producer;
+            T *value;
+
+            bool await_ready() const noexcept { return !producer || producer.done(); };
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> consumer) noexcept
+            {
+                producer.promise().consumer = consumer;
+                return producer;
+            };
+
+            bool
+            await_resume()
+            {
+                if (!producer || producer.done()) {
+                    if (producer && producer.promise().exception)
+                        std::rethrow_exception(producer.promise().exception);
+                    return false;
+                }
+                auto &promise = producer.promise();
+                if (promise.movable) {
+                    *value = std::move(*promise.current);
+                } else {
+                    *value = *promise.current;
+                }
+                return true;
+            };
+        };
+
+        AsyncGenerator()
+            : m_handle()
+        {
+        };
+
+        AsyncGenerator(AsyncGenerator &&other) noexcept
+            : m_handle(std::exchange(other.m_handle, {}))
+        {
+        };
+
+        AsyncGenerator &
+        operator=(AsyncGenerator &&other) noexcept
+        {
+            if (this != &other) {
+                if (m_handle)
+                    m_handle.destroy();
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        };
+
+        AsyncGenerator(const AsyncGenerator &other) = delete;
+        AsyncGenerator &operator=(const AsyncGenerator &other) = delete;
+
+        ~AsyncGenerator()
+        {
+            if (m_handle)
+                m_handle.destroy();
+        };
+
+        /**
+         * returns an awaitable which writes the next value into value and resumes with true, or
+         * resumes with false once the generator has finished.
+         *
+         * @param value
+         * @return
+         */
+        NextAwaiter
+        next(T &value)
+        {
+            return NextAwaiter{m_handle, std::addressof(value)};
+        };
+
+        /**
+         * returns the status the coroutine finished with, the generator must have finished.
+         *
+         * @return
+         */
+        tempo_utils::Status
+        getStatus() const
+        {
+            TU_ASSERT (m_handle && m_handle.done());
+            return m_handle.promise().status;
+        };
+
+    private:
+        HandleType m_handle;
+
+        explicit AsyncGenerator(HandleType handle)
+            : m_handle(handle)
+        {
+        };
+    };
+
+    /**
+     * passes through the values of the async input for which func returns true.
+     *
+     * @tparam T
+     * @tparam PredicateType
+     * @param input
+     * @param func
+     * @return
+     */
+    template<typename T, class PredicateType>
+    AsyncGenerator<T>
+    filter_async(AsyncGenerator<T> input, PredicateType func)
+    {
+        T value;
+        while (co_await input.next(value)) {
+            if (func(value)) {
+                co_yield std::move(value);
+            }
+        }
+        co_return input.getStatus();
+    }
+
+    /**
+     * yields the result of func applied to each value of the async input.
+     *
+     * @tparam T
+     * @tparam FunctionType
+     * @param input
+     * @param func
+     * @return
+     */
+    template<typename T, class FunctionType,
+        typename OutputType = std::remove_cvref_t<std::invoke_result_t<FunctionType &, const T &>>>
+    AsyncGenerator<OutputType>
+    map_async(AsyncGenerator<T> input, FunctionType func)
+    {
+        T value;
+        while (co_await input.next(value)) {
+            co_yield func(value);
+        }
+        co_return input.getStatus();
+    }
+}
+
+#endif // GROOVE_ITERATOR_ASYNC_GENERATOR_TEMPLATE_H
@@ -1,10 +1,17 @@
 #ifndef GROOVE_ITERATOR_BASE_ITERATOR_H
 #define GROOVE_ITERATOR_BASE_ITERATOR_H
 
+#include <concepts>
+
 #include <tempo_utils/iterator_template.h>
 
 namespace groove_iterator {
 
+    /**
+     * the number of elements requested per call when an iterator is consumed in batches.
+     */
+    constexpr int kDefaultBatchSize = 1024;
+
     class ErrorTrackingIterator {
     public:
         ErrorTrackingIterator();
@@ -21,7 +28,73 @@ namespace groove_iterator {
     class BaseIterator : public Iterator<T>, public ErrorTrackingIterator {
     public:
         virtual ~BaseIterator() = default;
+
+        /**
+         * fills batch with up to batchSize values and returns the number of values written. a return
+         * value of 0 means the iterator is exhausted. subclasses which can produce values in blocks
+         * should override the default implementation, which calls getNext for each value.
+         *
+         * @param batch
+         * @param batchSize
+         * @return
+         */
+        virtual int getNextBatch(T *batch, int batchSize)
+        {
+            int count = 0;
+            while (count < batchSize && this->getNext(batch[count])) {
+                count++;
+            }
+            return count;
+        };
     };
+
+    /**
+     * an input iterator type which provides a non-virtual getNextBatch method.
+     */
+    template <typename IteratorType, typename T>
+    concept BatchInputIterator = requires(IteratorType iterator, T *batch, int batchSize) {
+        { iterator.getNextBatch(batch, batchSize) } -> std::convertible_to<int>;
+    };
+
+    template <typename GetNextType>
+    struct GetNextTraits;
+
+    template <typename IteratorType, typename T>
+    struct GetNextTraits<bool (IteratorType::*)(T &)> {
+        using ValueType = T;
+    };
+
+    /**
+     * the type of the values produced by an iterator type, deduced from the signature of its getNext
+     * method, so that iterators which are not derived from a common base can be composed.
+     */
+    template <typename IteratorType>
+    using IteratorValueType = typename GetNextTraits<decltype(&IteratorType::getNext)>::ValueType;
+
+    /**
+     * fills batch with up to batchSize values from input and returns the number of values written. if
+     * the input is a BaseIterator then its getNextBatch method is used, otherwise the values are read
+     * one at a time with getNext.
+     *
+     * @tparam T
+     * @param input
+     * @param batch
+     * @param batchSize
+     * @return
+     */
+    template <typename T>
+    inline int
+    get_next_batch(Iterator<T> *input, T *batch, int batchSize)
+    {
+        auto *base = dynamic_cast<BaseIterator<T> *>(input);
+        if (base != nullptr)
+            return base->getNextBatch(batch, batchSize);
+        int count = 0;
+        while (count < batchSize && input->getNext(batch[count])) {
+            count++;
+        }
+        return count;
+    }
 }
 
 #endif // GROOVE_ITERATOR_BASE_ITERATOR_H
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef GROOVE_ITERATOR_FILTER_ITERATOR_TEMPLATE_H
 #define GROOVE_ITERATOR_FILTER_ITERATOR_TEMPLATE_H
 
+#include <utility>
+
 #include <tempo_utils/log_stream.h>
 
 #include "base_iterator.h"
@@ -16,6 +18,7 @@ namespace groove_iterator {
         FilterIterator(InputIteratorType input, FilterFunction func);
 
         bool getNext(InputType &value) override;
+        int getNextBatch(InputType *batch, int batchSize) override;
 
     private:
         InputIteratorType m_input;
@@ -45,6 +48,104 @@ namespace groove_iterator {
         }
         return false;
     }
+
+    template<class InputIteratorType, class InputType>
+    int
+    FilterIterator<InputIteratorType, InputType>::getNextBatch(InputType *batch, int batchSize)
+    {
+        if constexpr (BatchInputIterator<InputIteratorType, InputType>) {
+            // read input batches directly into the output buffer and compact the matching values
+            // in place, until at least one value matches or the input is exhausted
+            int count = 0;
+            while (count == 0) {
+                int size = m_input.getNextBatch(batch, batchSize);
+                if (size == 0)
+                    return 0;
+                for (int i = 0; i < size; i++) {
+                    if (m_func(batch[i])) {
+                        if (count != i) {
+                            batch[count] = std::move(batch[i]);
+                        }
+                        count++;
+                    }
+                }
+            }
+            return count;
+        } else {
+            return BaseIterator<InputType>::getNextBatch(batch, batchSize);
+        }
+    }
+
+    /**
+     * passes through the values of the input for which func returns true. like InlineMapIterator
+     * the predicate is a template parameter and the input is held by value, so the predicate is
+     * inlined and stages compose without virtual dispatch.
+     *
+     * @tparam InputIteratorType
+     * @tparam PredicateType
+     */
+    template<class InputIteratorType, class PredicateType>
+    class InlineFilterIterator {
+
+        using InputType = IteratorValueType<InputIteratorType>;
+
+    public:
+        InlineFilterIterator(InputIteratorType input, PredicateType func)
+            : m_input(std::move(input)),
+              m_func(std::move(func))
+        {
+        };
+
+        bool
+        getNext(InputType &value)
+        {
+            while (m_input.getNext(value)) {
+                if (m_func(value))
+                    return true;
+            }
+            return false;
+        };
+
+        int
+        getNextBatch(InputType *batch, int batchSize)
+        {
+            if constexpr (BatchInputIterator<InputIteratorType, InputType>) {
+                // compact the matching values of each input batch in place, as FilterIterator does
+                int count = 0;
+                while (count == 0) {
+                    int size = m_input.getNextBatch(batch, batchSize);
+                    if (size == 0)
+                        return 0;
+                    for (int i = 0; i < size; i++) {
+                        if (m_func(batch[i])) {
+                            if (count != i) {
+                                batch[count] = std::move(batch[i]);
+                            }
+                            count++;
+                        }
+                    }
+                }
+                return count;
+            } else {
+                int count = 0;
+                while (count < batchSize && getNext(batch[count])) {
+                    count++;
+                }
+                return count;
+            }
+        };
+
+    private:
+        InputIteratorType m_input;
+        PredicateType m_func;
+    };
+
+    template<class InputIteratorType, class PredicateType>
+    InlineFilterIterator<InputIteratorType, PredicateType>
+    filter_inline(InputIteratorType input, PredicateType func)
+    {
+        return InlineFilterIterator<InputIteratorType, PredicateType>(std::move(input), std::move(func));
+    }
 }
 
 #endif // GROOVE_ITERATOR_FILTER_ITERATOR_TEMPLATE_H
\ No newline at end of file
@@ -0,0 +1,194 @@
+#ifndef GROOVE_ITERATOR_GENERATOR_TEMPLATE_H
+#define GROOVE_ITERATOR_GENERATOR_TEMPLATE_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include <tempo_utils/log_stream.h>
+#include <tempo_utils/status.h>
+
+#include "base_iterator.h"
+
+namespace groove_iterator {
+
+    /**
+     * an iterator whose values are produced by a coroutine. the coroutine runs until its next
+     * co_yield each time getNext is called, so its state is held in local variables instead of
+     * an explicit state machine, and it finishes with co_return of a status which is returned by
+     * getStatus once getNext returns false. a value yielded as an rvalue is moved into the
+     * caller, and a value yielded as an lvalue is copied. a generator has getNext and
+     * getNextBatch, so it composes with map_inline, filter_inline and MergeIterator like any
+     * other input. a generator is move-only and destroys the coroutine when it is destroyed.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class Generator {
+
+    public:
+        struct promise_type {
+            T *current = nullptr;
+            bool movable = false;
+            tempo_utils::Status status;
+            std::exception_ptr exception;
+
+            Generator
+            get_return_object()
+            {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            };
+
+            std::suspend_always initial_suspend() noexcept { return {}; };
+            std::suspend_always final_suspend() noexcept { return {}; };
+
+            // the yielded value lives in the coroutine frame until the coroutine is resumed
+            std::suspend_always
+            yield_value(T &value) noexcept
+            {
+                current = std::addressof(value);
+                movable = false;
+                return {};
+            };
+
+            std::suspend_always
+            yield_value(T &&value) noexcept
+            {
+                current = std::addressof(value);
+                movable = true;
+                return {};
+            };
+
+            void return_value(tempo_utils::Status result) { status = std::move(result); };
+            void unhandled_exception() { exception = std::current_exception(); };
+
+            // a generator runs synchronously, asynchronous sources need an AsyncGenerator
+            template<typename U>
+            std::suspend_never await_transform(U &&) = delete;
+        };
+
+        using HandleType = std::coroutine_handle<promise_type>;
+
+        Generator()
+            : m_handle()
+        {
+        };
+
+        Generator(Generator &&other) noexcept
+            : m_handle(std::exchange(other.m_handle, {}))
+        {
+        };
+
+        Generator &
+        operator=(Generator &&other) noexcept
+        {
+            if (this != &other) {
+                if (m_handle)
+                    m_handle.destroy();
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        };
+
+        Generator(const Generator &other) = delete;
+        Generator &operator=(const Generator &other) = delete;
+
+        ~Generator()
+        {
+            if (m_handle)
+                m_handle.destroy();
+        };
+
+        bool
+        getNext(T &value)
+        {
+            if (!m_handle || m_handle.done())
+                return false;
+            m_handle.resume();
+            auto &promise = m_handle.promise();
+            if (promise.exception)
+                std::rethrow_exception(promise.exception);
+            if (m_handle.done())
+                return false;
+            if (promise.movable) {
+                value = std::move(*promise.current);
+            } else {
+                value = *promise.current;
+            }
+            return true;
+        };
+
+        int
+        getNextBatch(T *batch, int batchSize)
+        {
+            int count = 0;
+            while (count < batchSize && getNext(batch[count])) {
+                count++;
+            }
+            return count;
+        };
+
+        /**
+         * returns the status the coroutine finished with. the status is only meaningful once
+         * getNext has returned false.
+         *
+         * @return
+         */
+        tempo_utils::Status
+        getStatus() const
+        {
+            TU_ASSERT (m_handle);
+            return m_handle.promise().status;
+        };
+
+    private:
+        HandleType m_handle;
+
+        explicit Generator(HandleType handle)
+            : m_handle(handle)
+        {
+        };
+    };
+
+    /**
+     * yields the values of the input in batches of up to batchSize values, so stages which
+     * consume whole batches avoid a call per value. the batch buffer is allocated once and is
+     * refilled for each batch. it is yielded as an lvalue, so each batch is copied into the
+     * caller's vector, which keeps its capacity across calls, and neither side allocates after
+     * the first batch.
+     *
+     * @tparam InputIteratorType
+     * @param input
+     * @param batchSize
+     * @return
+     */
+    template<class InputIteratorType,
+        typename ValueType = IteratorValueType<InputIteratorType>>
+    Generator<std::vector<ValueType>>
+    generate_batches(InputIteratorType input, int batchSize = kDefaultBatchSize)
+    {
+        TU_ASSERT (batchSize > 0);
+        std::vector<ValueType> batch;
+        batch.reserve(batchSize);
+        for (;;) {
+            batch.resize(batchSize);
+            int count;
+            if constexpr (BatchInputIterator<InputIteratorType, ValueType>) {
+                count = input.getNextBatch(batch.data(), batchSize);
+            } else {
+                count = 0;
+                while (count < batchSize && input.getNext(batch[count])) {
+                    count++;
+                }
+            }
+            if (count == 0)
+                break;
+            batch.resize(count);
+            co_yield batch;
+        }
+        co_return tempo_utils::Status();
+    }
+}
+
+#endif // GROOVE_ITERATOR_GENERATOR_TEMPLATE_H
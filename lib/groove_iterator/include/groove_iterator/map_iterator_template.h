@@ -1,6 +1,10 @@
 #ifndef GROOVE_ITERATOR_MAP_ITERATOR_TEMPLATE_H
 #define GROOVE_ITERATOR_MAP_ITERATOR_TEMPLATE_H
 
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <tempo_utils/log_stream.h>
 
 #include "base_iterator.h"
@@ -16,10 +20,12 @@ namespace groove_iterator {
         MapIterator(InputIteratorType input, MapFunction func);
 
         bool getNext(OutputType &value) override;
+        int getNextBatch(OutputType *batch, int batchSize) override;
 
     private:
         InputIteratorType m_input;
         MapFunction m_func;
+        std::vector<InputType> m_inputs;
     };
 
     template<class InputIteratorType, class InputType, class OutputType>
@@ -42,6 +48,91 @@ namespace groove_iterator {
         value = m_func(input);
         return true;
     }
+
+    template<class InputIteratorType, class InputType, class OutputType>
+    int
+    MapIterator<InputIteratorType, InputType, OutputType>::getNextBatch(OutputType *batch, int batchSize)
+    {
+        if constexpr (BatchInputIterator<InputIteratorType, InputType>) {
+            if (m_inputs.size() < static_cast<size_t>(batchSize)) {
+                m_inputs.resize(batchSize);
+            }
+            int count = m_input.getNextBatch(m_inputs.data(), batchSize);
+            for (int i = 0; i < count; i++) {
+                batch[i] = m_func(m_inputs[i]);
+            }
+            return count;
+        } else {
+            return BaseIterator<OutputType>::getNextBatch(batch, batchSize);
+        }
+    }
+
+    /**
+     * maps each value of the input through func. unlike MapIterator the function is a template
+     * parameter, so a lambda or functor is inlined into the loop, and the input is held by value
+     * and called without virtual dispatch. the iterator is not itself virtual, so stages can be
+     * nested to any depth and a whole pipeline compiles to a single loop; wrap the outermost stage
+     * in a PipelineIterator where an Iterator is required.
+     *
+     * @tparam InputIteratorType
+     * @tparam FunctorType
+     */
+    template<class InputIteratorType, class FunctorType>
+    class InlineMapIterator {
+
+        using InputType = IteratorValueType<InputIteratorType>;
+        using OutputType = std::remove_cvref_t<std::invoke_result_t<FunctorType &, const InputType &>>;
+
+    public:
+        InlineMapIterator(InputIteratorType input, FunctorType func)
+            : m_input(std::move(input)),
+              m_func(std::move(func))
+        {
+        };
+
+        bool
+        getNext(OutputType &value)
+        {
+            InputType input;
+            if (!m_input.getNext(input))
+                return false;
+            value = m_func(input);
+            return true;
+        };
+
+        int
+        getNextBatch(OutputType *batch, int batchSize)
+        {
+            if constexpr (BatchInputIterator<InputIteratorType, InputType>) {
+                if (m_inputs.size() < static_cast<size_t>(batchSize)) {
+                    m_inputs.resize(batchSize);
+                }
+                int count = m_input.getNextBatch(m_inputs.data(), batchSize);
+                for (int i = 0; i < count; i++) {
+                    batch[i] = m_func(m_inputs[i]);
+                }
+                return count;
+            } else {
+                int count = 0;
+                while (count < batchSize && getNext(batch[count])) {
+                    count++;
+                }
+                return count;
+            }
+        };
+
+    private:
+        InputIteratorType m_input;
+        FunctorType m_func;
+        std::vector<InputType> m_inputs;
+    };
+
+    template<class InputIteratorType, class FunctorType>
+    InlineMapIterator<InputIteratorType, FunctorType>
+    map_inline(InputIteratorType input, FunctorType func)
+    {
+        return InlineMapIterator<InputIteratorType, FunctorType>(std::move(input), std::move(func));
+    }
 }
 
 #endif // GROOVE_ITERATOR_MAP_ITERATOR_TEMPLATE_H
\ No newline at end of file
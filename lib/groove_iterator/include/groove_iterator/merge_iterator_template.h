@@ -0,0 +1,131 @@
+#ifndef GROOVE_ITERATOR_MERGE_ITERATOR_TEMPLATE_H
+#define GROOVE_ITERATOR_MERGE_ITERATOR_TEMPLATE_H
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base_iterator.h"
+
+namespace groove_iterator {
+
+    /**
+     * returns the key member of a datum, the default key of a MergeIterator.
+     */
+    struct DatumKey {
+        template<typename DatumType>
+        auto operator()(const DatumType &datum) const { return datum.key; };
+    };
+
+    /**
+     * one aligned row of a MergeIterator. values and present are addressed by input index, and
+     * values[i] is only meaningful if present[i] is set. the buffers are sized once and reused
+     * when the same row is passed to each call of getNext.
+     *
+     * @tparam KeyType
+     * @tparam ValueType
+     */
+    template<typename KeyType, typename ValueType>
+    struct MergeRow {
+        KeyType key;
+        std::vector<ValueType> values;
+        std::vector<bool> present;
+    };
+
+    /**
+     * merges K inputs which are each sorted by key into rows of aligned values, one row per
+     * distinct key in ascending order. the head of each input is kept in a binary heap, so each
+     * input value costs O(log K) comparisons rather than the O(K) of scanning every input for
+     * the smallest key. if an input holds a key more than once, each occurrence is emitted in a
+     * separate row. keys need only support operator<.
+     *
+     * @tparam InputIteratorType
+     * @tparam KeyFunctorType
+     */
+    template<class InputIteratorType, class KeyFunctorType = DatumKey>
+    class MergeIterator : public BaseIterator<
+        MergeRow<
+            std::remove_cvref_t<std::invoke_result_t<KeyFunctorType &, const IteratorValueType<InputIteratorType> &>>,
+            IteratorValueType<InputIteratorType>>> {
+
+    public:
+        using ValueType = IteratorValueType<InputIteratorType>;
+        using KeyType = std::remove_cvref_t<std::invoke_result_t<KeyFunctorType &, const ValueType &>>;
+        using RowType = MergeRow<KeyType,ValueType>;
+
+        MergeIterator(std::vector<InputIteratorType> inputs, KeyFunctorType keyFunc = {})
+            : m_inputs(std::move(inputs)),
+              m_keyFunc(std::move(keyFunc)),
+              m_heads(m_inputs.size()),
+              m_primed(false)
+        {
+        };
+
+        int numInputs() const { return m_inputs.size(); };
+
+        bool
+        getNext(RowType &row) override
+        {
+            if (!m_primed) {
+                for (int i = 0; i < numInputs(); i++) {
+                    advance(i);
+                }
+                m_primed = true;
+            }
+            if (m_heap.empty())
+                return false;
+
+            row.values.resize(m_inputs.size());
+            row.present.assign(m_inputs.size(), false);
+            row.key = m_heap.front().first;
+
+            // pop every head at the smallest key before advancing any input, so a repeated key
+            // within one input is left for the next row
+            m_popped.clear();
+            while (!m_heap.empty() && !(row.key < m_heap.front().first)) {
+                std::pop_heap(m_heap.begin(), m_heap.end(), HeapOrder());
+                m_popped.push_back(m_heap.back().second);
+                m_heap.pop_back();
+            }
+            for (auto index : m_popped) {
+                row.values[index] = std::move(m_heads[index]);
+                row.present[index] = true;
+                advance(index);
+            }
+            return true;
+        };
+
+    private:
+        using HeapEntry = std::pair<KeyType,int>;
+
+        // orders the heap so the entry with the smallest key, then smallest index, is at the front
+        struct HeapOrder {
+            bool operator()(const HeapEntry &lhs, const HeapEntry &rhs) const {
+                if (rhs.first < lhs.first)
+                    return true;
+                if (lhs.first < rhs.first)
+                    return false;
+                return rhs.second < lhs.second;
+            };
+        };
+
+        std::vector<InputIteratorType> m_inputs;
+        KeyFunctorType m_keyFunc;
+        std::vector<ValueType> m_heads;
+        std::vector<HeapEntry> m_heap;
+        std::vector<int> m_popped;
+        bool m_primed;
+
+        void
+        advance(int index)
+        {
+            if (!m_inputs[index].getNext(m_heads[index]))
+                return;
+            m_heap.emplace_back(m_keyFunc(m_heads[index]), index);
+            std::push_heap(m_heap.begin(), m_heap.end(), HeapOrder());
+        };
+    };
+}
+
+#endif // GROOVE_ITERATOR_MERGE_ITERATOR_TEMPLATE_H
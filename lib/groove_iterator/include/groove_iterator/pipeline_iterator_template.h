@@ -0,0 +1,47 @@
+#ifndef GROOVE_ITERATOR_PIPELINE_ITERATOR_TEMPLATE_H
+#define GROOVE_ITERATOR_PIPELINE_ITERATOR_TEMPLATE_H
+
+#include <utility>
+
+#include "base_iterator.h"
+
+namespace groove_iterator {
+
+    /**
+     * adapts a pipeline of inline iterators to the BaseIterator interface. the pipeline is held by
+     * value, so consuming it in batches costs one virtual call per batch rather than one per stage
+     * per value.
+     *
+     * @tparam PipelineType
+     */
+    template<class PipelineType>
+    class PipelineIterator : public BaseIterator<IteratorValueType<PipelineType>> {
+
+        using ValueType = IteratorValueType<PipelineType>;
+
+    public:
+        explicit PipelineIterator(PipelineType pipeline)
+            : m_pipeline(std::move(pipeline))
+        {
+        };
+
+        bool getNext(ValueType &value) override
+        {
+            return m_pipeline.getNext(value);
+        };
+
+        int getNextBatch(ValueType *batch, int batchSize) override
+        {
+            if constexpr (BatchInputIterator<PipelineType, ValueType>) {
+                return m_pipeline.getNextBatch(batch, batchSize);
+            } else {
+                return BaseIterator<ValueType>::getNextBatch(batch, batchSize);
+            }
+        };
+
+    private:
+        PipelineType m_pipeline;
+    };
+}
+
+#endif // GROOVE_ITERATOR_PIPELINE_ITERATOR_TEMPLATE_H
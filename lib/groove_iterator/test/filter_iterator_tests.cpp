@@ -50,4 +50,53 @@ TEST(FilterIteratorTest, TestEmpty)
 
     tu_int64 value;
     ASSERT_FALSE (filter.getNext(value));
-}
\ No newline at end of file
+}
+
+TEST(FilterIteratorTest, TestGetNextBatch)
+{
+    auto range = std::make_shared<std::vector<tu_int64>>();
+    for (tu_int64 i = 0; i < 10; i++) {
+        range->push_back(i);
+    }
+    groove_iterator::RangeIterator<std::vector<tu_int64>> it(range, range->cbegin(), range->cend());
+    groove_iterator::FilterIterator<
+        groove_iterator::RangeIterator<
+            std::vector<tu_int64>>,tu_int64> filter(it, is_even);
+
+    tu_int64 batch[4];
+    ASSERT_EQ (2, filter.getNextBatch(batch, 4));
+    ASSERT_EQ (0, batch[0]);
+    ASSERT_EQ (2, batch[1]);
+    ASSERT_EQ (2, filter.getNextBatch(batch, 4));
+    ASSERT_EQ (4, batch[0]);
+    ASSERT_EQ (6, batch[1]);
+    ASSERT_EQ (1, filter.getNextBatch(batch, 4));
+    ASSERT_EQ (8, batch[0]);
+    ASSERT_EQ (0, filter.getNextBatch(batch, 4));
+}
+
+TEST(FilterIteratorTest, TestInlineFilterWithLambda)
+{
+    auto range = std::make_shared<std::vector<tu_int64>>();
+    for (tu_int64 i = 0; i < 10; i++) {
+        range->push_back(i);
+    }
+    groove_iterator::RangeIterator<std::vector<tu_int64>> src(range, range->cbegin(), range->cend());
+    tu_int64 divisor = 3;
+    auto filter = groove_iterator::filter_inline(src, [divisor](const tu_int64 &value) {
+        return value % divisor == 0;
+    });
+
+    // each batch holds the matches of one input batch
+    tu_int64 batch[3];
+    ASSERT_EQ (1, filter.getNextBatch(batch, 3));
+    ASSERT_EQ (0, batch[0]);
+    ASSERT_EQ (1, filter.getNextBatch(batch, 3));
+    ASSERT_EQ (3, batch[0]);
+    tu_int64 value;
+    ASSERT_TRUE (filter.getNext(value));
+    ASSERT_EQ (6, value);
+    ASSERT_TRUE (filter.getNext(value));
+    ASSERT_EQ (9, value);
+    ASSERT_FALSE (filter.getNext(value));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <groove_iterator/async_generator_template.h>
+#include <groove_iterator/filter_iterator_template.h>
+#include <groove_iterator/generator_template.h>
+#include <groove_iterator/map_iterator_template.h>
+#include <groove_iterator/merge_iterator_template.h>
+#include <groove_iterator/range_iterator_template.h>
+
+static groove_iterator::Generator<tu_int64>
+count_to(tu_int64 last)
+{
+    for (tu_int64 i = 1; i <= last; i++) {
+        co_yield i;
+    }
+    co_return tempo_utils::Status();
+}
+
+TEST(GeneratorTest, TestYieldsValuesInOrder)
+{
+    auto gen = count_to(3);
+
+    tu_int64 value;
+    ASSERT_TRUE (gen.getNext(value));
+    ASSERT_EQ (1, value);
+    ASSERT_TRUE (gen.getNext(value));
+    ASSERT_EQ (2, value);
+    ASSERT_TRUE (gen.getNext(value));
+    ASSERT_EQ (3, value);
+    ASSERT_FALSE (gen.getNext(value));
+    ASSERT_FALSE (gen.getNext(value));
+    ASSERT_TRUE (gen.getStatus().isOk());
+}
+
+TEST(GeneratorTest, TestComposesWithInlineStages)
+{
+    auto pipeline = groove_iterator::map_inline(
+        groove_iterator::filter_inline(count_to(10), [](tu_int64 value) { return value % 2 == 0; }),
+        [](tu_int64 value) { return value * 10; });
+
+    tu_int64 batch[16];
+    ASSERT_EQ (5, pipeline.getNextBatch(batch, 16));
+    ASSERT_EQ (20, batch[0]);
+    ASSERT_EQ (100, batch[4]);
+    ASSERT_EQ (0, pipeline.getNextBatch(batch, 16));
+}
+
+struct TestDatum {
+    tu_int64 key;
+    tu_int64 value;
+};
+
+static groove_iterator::Generator<TestDatum>
+scaled_to(tu_int64 last, tu_int64 scale)
+{
+    for (tu_int64 i = 1; i <= last; i++) {
+        co_yield TestDatum{i, i * scale};
+    }
+    co_return tempo_utils::Status();
+}
+
+TEST(GeneratorTest, TestMergesGenerators)
+{
+    std::vector<groove_iterator::Generator<TestDatum>> inputs;
+    inputs.push_back(scaled_to(2, 10));
+    inputs.push_back(scaled_to(3, 100));
+    groove_iterator::MergeIterator<groove_iterator::Generator<TestDatum>> it(std::move(inputs));
+
+    groove_iterator::MergeRow<tu_int64, TestDatum> row;
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (1, row.key);
+    ASSERT_EQ (std::vector<bool>({true, true}), row.present);
+    ASSERT_EQ (10, row.values[0].value);
+    ASSERT_EQ (100, row.values[1].value);
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (3, row.key);
+    ASSERT_EQ (std::vector<bool>({false, true}), row.present);
+    ASSERT_FALSE (it.getNext(row));
+}
+
+TEST(GeneratorTest, TestGenerateBatches)
+{
+    auto range = std::make_shared<std::vector<tu_int64>>(std::initializer_list<tu_int64>{1, 2, 3, 4, 5});
+    groove_iterator::RangeIterator<std::vector<tu_int64>> it(range, range->cbegin(), range->cend());
+    auto batches = groove_iterator::generate_batches(it, 2);
+
+    std::vector<tu_int64> batch;
+    ASSERT_TRUE (batches.getNext(batch));
+    ASSERT_EQ (std::vector<tu_int64>({1, 2}), batch);
+    ASSERT_TRUE (batches.getNext(batch));
+    ASSERT_TRUE (batches.getNext(batch));
+    ASSERT_EQ (std::vector<tu_int64>({5}), batch);
+    ASSERT_FALSE (batches.getNext(batch));
+}
+
+static groove_iterator::AsyncGenerator<tu_int64>
+await_each(std::vector<groove_iterator::Completion<tu_int64>> completions)
+{
+    for (auto &completion : completions) {
+        co_yield co_await completion;
+    }
+    co_return tempo_utils::Status();
+}
+
+static groove_iterator::Task
+sum_values(groove_iterator::AsyncGenerator<tu_int64> input, tu_int64 &sum)
+{
+    tu_int64 value;
+    while (co_await input.next(value)) {
+        sum += value;
+    }
+    co_return input.getStatus();
+}
+
+TEST(AsyncGeneratorTest, TestResumesWhenCompleted)
+{
+    std::vector<groove_iterator::Completion<tu_int64>> completions(3);
+    completions[0].complete(1);
+
+    auto evens = groove_iterator::map_async(
+        await_each(completions), [](const tu_int64 &value) { return value * 2; });
+    tu_int64 sum = 0;
+    auto task = sum_values(std::move(evens), sum);
+
+    // the first value was already delivered, so the task runs until it awaits the second
+    ASSERT_FALSE (task.isDone());
+    ASSERT_EQ (2, sum);
+
+    completions[2].complete(3);
+    ASSERT_FALSE (task.isDone());
+    completions[1].complete(2);
+    ASSERT_TRUE (task.isDone());
+    ASSERT_EQ (12, sum);
+    ASSERT_TRUE (task.getStatus().isOk());
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <groove_iterator/filter_iterator_template.h>
 #include <groove_iterator/map_iterator_template.h>
+#include <groove_iterator/pipeline_iterator_template.h>
 #include <groove_iterator/range_iterator_template.h>
 
 static std::string int64_to_string(const tu_int64 &value)
@@ -39,4 +41,47 @@ TEST(MapIteratorTest, TestMapEmpty)
 
     std::string value;
     ASSERT_FALSE (it.getNext(value));
-}
\ No newline at end of file
+}
+
+TEST(MapIteratorTest, TestGetNextBatch)
+{
+    auto range = std::make_shared<std::vector<tu_int64>>();
+    range->push_back(1);
+    range->push_back(2);
+    range->push_back(3);
+    groove_iterator::RangeIterator<std::vector<tu_int64>> src(range, range->cbegin(), range->cend());
+    groove_iterator::MapIterator<
+        groove_iterator::RangeIterator<
+            std::vector<tu_int64>>,tu_int64,std::string> it(src, int64_to_string);
+
+    std::string batch[2];
+    ASSERT_EQ (2, it.getNextBatch(batch, 2));
+    ASSERT_EQ ("1", batch[0]);
+    ASSERT_EQ ("2", batch[1]);
+    ASSERT_EQ (1, it.getNextBatch(batch, 2));
+    ASSERT_EQ ("3", batch[0]);
+    ASSERT_EQ (0, it.getNextBatch(batch, 2));
+}
+
+TEST(MapIteratorTest, TestInlinePipeline)
+{
+    auto range = std::make_shared<std::vector<tu_int64>>();
+    for (tu_int64 i = 1; i <= 5; i++) {
+        range->push_back(i);
+    }
+    groove_iterator::RangeIterator<std::vector<tu_int64>> src(range, range->cbegin(), range->cend());
+
+    // the stages are composed by value and erased once at the end of the pipeline
+    auto pipeline = groove_iterator::map_inline(
+        groove_iterator::filter_inline(src, [](const tu_int64 &value) { return value % 2 == 1; }),
+        [](const tu_int64 &value) { return absl::StrCat(value * 10); });
+    auto it = std::make_shared<groove_iterator::PipelineIterator<decltype(pipeline)>>(pipeline);
+
+    std::string batch[4];
+    ASSERT_EQ (2, groove_iterator::get_next_batch<std::string>(it.get(), batch, 4));
+    ASSERT_EQ ("10", batch[0]);
+    ASSERT_EQ ("30", batch[1]);
+    ASSERT_EQ (1, groove_iterator::get_next_batch<std::string>(it.get(), batch, 4));
+    ASSERT_EQ ("50", batch[0]);
+    ASSERT_EQ (0, groove_iterator::get_next_batch<std::string>(it.get(), batch, 4));
+}
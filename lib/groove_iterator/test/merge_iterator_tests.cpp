@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <groove_iterator/merge_iterator_template.h>
+#include <groove_iterator/range_iterator_template.h>
+
+struct TestDatum {
+    tu_int64 key;
+    tu_int64 value;
+};
+
+using TestRangeIterator = groove_iterator::RangeIterator<std::vector<TestDatum>>;
+
+static TestRangeIterator
+make_input(std::initializer_list<TestDatum> data)
+{
+    auto range = std::make_shared<std::vector<TestDatum>>(data);
+    return TestRangeIterator(range, range->cbegin(), range->cend());
+}
+
+TEST(MergeIteratorTest, TestAlignsRowsByKey)
+{
+    std::vector<TestRangeIterator> inputs = {
+        make_input({{1, 10}, {3, 30}, {5, 50}}),
+        make_input({}),
+        make_input({{2, 21}, {3, 31}}),
+    };
+    groove_iterator::MergeIterator<TestRangeIterator> it(inputs);
+
+    groove_iterator::MergeRow<tu_int64, TestDatum> row;
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (1, row.key);
+    ASSERT_EQ (std::vector<bool>({true, false, false}), row.present);
+    ASSERT_EQ (10, row.values[0].value);
+
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (2, row.key);
+    ASSERT_EQ (std::vector<bool>({false, false, true}), row.present);
+
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (3, row.key);
+    ASSERT_EQ (std::vector<bool>({true, false, true}), row.present);
+    ASSERT_EQ (30, row.values[0].value);
+    ASSERT_EQ (31, row.values[2].value);
+
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (5, row.key);
+    ASSERT_FALSE (it.getNext(row));
+}
+
+TEST(MergeIteratorTest, TestRepeatedKeyIsEmittedInSeparateRows)
+{
+    std::vector<TestRangeIterator> inputs = {
+        make_input({{1, 10}, {1, 11}}),
+        make_input({{1, 20}}),
+    };
+    groove_iterator::MergeIterator<TestRangeIterator> it(inputs);
+
+    groove_iterator::MergeRow<tu_int64, TestDatum> row;
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (std::vector<bool>({true, true}), row.present);
+    ASSERT_EQ (10, row.values[0].value);
+    ASSERT_TRUE (it.getNext(row));
+    ASSERT_EQ (1, row.key);
+    ASSERT_EQ (std::vector<bool>({true, false}), row.present);
+    ASSERT_EQ (11, row.values[0].value);
+    ASSERT_FALSE (it.getNext(row));
+}
+
+TEST(MergeIteratorTest, TestManyInputs)
+{
+    // 200 inputs, input i holds the keys which are multiples of i + 1 below 1000
+    std::vector<TestRangeIterator> inputs;
+    for (tu_int64 i = 0; i < 200; i++) {
+        auto range = std::make_shared<std::vector<TestDatum>>();
+        for (tu_int64 key = 0; key < 1000; key += i + 1) {
+            range->push_back({key, i});
+        }
+        inputs.emplace_back(range, range->cbegin(), range->cend());
+    }
+    groove_iterator::MergeIterator<TestRangeIterator> it(inputs);
+
+    groove_iterator::MergeRow<tu_int64, TestDatum> row;
+    tu_int64 expectedKey = 0;
+    while (it.getNext(row)) {
+        ASSERT_EQ (expectedKey, row.key);
+        for (tu_int64 i = 0; i < 200; i++) {
+            ASSERT_EQ (row.key % (i + 1) == 0, row.present[i]);
+        }
+        expectedKey++;
+    }
+    ASSERT_EQ (1000, expectedKey);
+}
@@ -0,0 +1,346 @@
+#ifndef GROOVE_MATH_BUCKET_REDUCER_TEMPLATE_H
+#define GROOVE_MATH_BUCKET_REDUCER_TEMPLATE_H
+
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <absl/container/btree_map.h>
+
+#include <groove_data/search_utils.h>
+#include <groove_data/vector_view_template.h>
+
+#include "fused_function_template.h"
+#include "histogram.h"
+#include "reduce_kernels.h"
+#include "reducer_traits.h"
+
+namespace groove_math {
+
+    /**
+     * Divides the key space into buckets of equal width, aligned so that origin is the start
+     * of a bucket. Each bucket includes its start key and excludes its end key.
+     *
+     * @tparam KeyType
+     */
+    template<typename KeyType>
+    struct BucketSpec {
+        static_assert(std::is_same_v<KeyType, tu_int64> || std::is_same_v<KeyType, double>);
+
+        KeyType origin;
+        KeyType width;
+
+        KeyType
+        bucketStart(KeyType key) const
+        {
+            if constexpr (std::is_integral_v<KeyType>) {
+                // round toward negative infinity, so keys before the origin are bucketed correctly
+                KeyType offset = key - origin;
+                KeyType index = offset / width;
+                if (offset % width < 0) {
+                    index--;
+                }
+                return origin + index * width;
+            } else {
+                return origin + std::floor((key - origin) / width) * width;
+            }
+        };
+
+        KeyType bucketEnd(KeyType start) const { return start + width; };
+    };
+
+    template<typename KeyType>
+    struct BucketRow {
+        KeyType start;
+        KeyType end;
+        std::vector<double> values;
+    };
+
+    /**
+     * Divides each chunk of the view into runs of rows whose keys lie in the same bucket, and
+     * calls visitor with the start of the bucket and the values of the run. The keys of a chunk
+     * are sorted, so each run is found with a binary search rather than by bucketing every key.
+     *
+     * @tparam KeyType
+     * @tparam ValueType
+     * @tparam VisitorType
+     * @param spec
+     * @param view
+     * @param visitor
+     */
+    template<typename KeyType, typename ValueType, typename VisitorType>
+    void
+    for_each_bucket_run(
+        const BucketSpec<KeyType> &spec,
+        const groove_data::VectorView<KeyType,ValueType> &view,
+        VisitorType &&visitor)
+    {
+        for (int i = 0; i < view.numChunks(); i++) {
+            const auto &chunk = view.getChunk(i);
+            const KeyType *keys = chunk.keys.values;
+            const TypedSpan<ValueType> span{chunk.values.values, chunk.length, chunk.fidelity};
+
+            tu_int64 curr = 0;
+            while (curr < chunk.length) {
+                auto start = spec.bucketStart(keys[curr]);
+                auto next = curr + groove_data::search_lower_bound(
+                    keys + curr, chunk.length - curr, spec.bucketEnd(start));
+                // guard against rounding placing the key at or past the computed bucket end
+                if (next <= curr) {
+                    next = curr + 1;
+                }
+                visitor(start, span.slice(curr, next - curr));
+                curr = next;
+            }
+        }
+    }
+
+    /**
+     * Reduces double or int64 values into key buckets, evaluating every reducer in DefTypes for
+     * each bucket. Views are consumed a chunk at a time: the keys of a chunk are sorted, so the
+     * rows of each bucket are a contiguous run which is found by binary search and passed to the
+     * vectorized span kernels as a whole. The reducers are the functions of DefTypes over
+     * ValueType, so int64 values are reduced natively, for example summed exactly by
+     * Int64SumFunction, and only the outputs are converted to double. Only buckets which hold at
+     * least one valid value are emitted. The reducers of a bucket are evaluated together by
+     * FusedFunction, so each run is read once however many reducers there are. Buckets may also
+     * be seeded from precomputed summaries when every reducer can be derived from one (see
+     * supportsSummaries()), and bucket reducers with the same spec may be merged, so buckets can
+     * be computed per page, thread or agent and combined.
+     *
+     * @tparam KeyType
+     * @tparam ValueType
+     * @tparam DefTypes
+     */
+    template<typename KeyType, typename ValueType, typename... DefTypes>
+    class BucketReducer {
+
+        static_assert(sizeof...(DefTypes) > 0);
+
+    public:
+        using FunctionType = FusedFunction<ValueType, DefTypes...>;
+        using StateTuple = typename FunctionType::State;
+        using SummaryType = typename FunctionType::Summary;
+        static constexpr size_t kNumReducers = sizeof...(DefTypes);
+
+        BucketReducer(const BucketSpec<KeyType> &spec, const std::array<double,kNumReducers> &identities)
+            : m_spec(spec),
+              m_identities(identities)
+        {
+            TU_ASSERT (m_spec.width > 0);
+        };
+
+        const BucketSpec<KeyType> &getSpec() const { return m_spec; };
+        int numBuckets() const { return m_buckets.size(); };
+
+        static constexpr bool supportsSummaries() { return FunctionType::supportsSummaries(); };
+
+        /**
+         * Accumulates the valid values of the view into the buckets of their keys.
+         *
+         * @param view
+         */
+        void
+        accumulate(const groove_data::VectorView<KeyType,ValueType> &view)
+        {
+            for_each_bucket_run(m_spec, view, [this](KeyType start, const TypedSpan<ValueType> &run) {
+                if constexpr (supportsSummaries()) {
+                    // a single pass both summarizes the run and detects an empty run
+                    accumulateSummary(start, summary_kernel(run));
+                } else if (count_kernel(run) > 0) {
+                    FunctionType::accumulate(getBucket(start), run);
+                }
+            });
+        };
+
+        /**
+         * Accumulates a precomputed summary of values whose keys all lie in the bucket starting
+         * at bucketStart.
+         *
+         * @param bucketStart
+         * @param summary
+         */
+        void
+        accumulateSummary(KeyType bucketStart, const SummaryType &summary) requires (supportsSummaries())
+        {
+            if (summary.count == 0)
+                return;
+            FunctionType::merge(getBucket(bucketStart), FunctionType::fromSummary(summary));
+        };
+
+        /**
+         * Returns a reducer with the same spec and identities and no buckets, into which a
+         * separate part of the keys can be reduced and then merged.
+         *
+         * @return
+         */
+        BucketReducer
+        emptyCopy() const
+        {
+            return BucketReducer(m_spec, m_identities);
+        };
+
+        void
+        merge(const BucketReducer &other)
+        {
+            TU_ASSERT (m_spec.origin == other.m_spec.origin && m_spec.width == other.m_spec.width);
+            for (const auto &entry : other.m_buckets) {
+                FunctionType::merge(getBucket(entry.first), entry.second);
+            }
+        };
+
+        /**
+         * Returns one row per bucket in key order, holding the output of each reducer in the
+         * order of DefTypes.
+         *
+         * @return
+         */
+        std::vector<BucketRow<KeyType>>
+        finalize() const
+        {
+            std::vector<BucketRow<KeyType>> rows;
+            rows.reserve(m_buckets.size());
+            for (const auto &entry : m_buckets) {
+                BucketRow<KeyType> row;
+                row.start = entry.first;
+                row.end = m_spec.bucketEnd(entry.first);
+                auto values = FunctionType::finalize(entry.second, m_identities);
+                row.values.assign(values.cbegin(), values.cend());
+                rows.push_back(std::move(row));
+            }
+            return rows;
+        };
+
+    private:
+        BucketSpec<KeyType> m_spec;
+        std::array<double,kNumReducers> m_identities;
+        absl::btree_map<KeyType,StateTuple> m_buckets;
+
+        StateTuple &
+        getBucket(KeyType start)
+        {
+            // rows usually arrive in key order, so try the last bucket before searching
+            if (!m_buckets.empty()) {
+                auto last = std::prev(m_buckets.end());
+                if (last->first == start)
+                    return last->second;
+            }
+            auto entry = m_buckets.try_emplace(start, FunctionType::init());
+            return entry.first->second;
+        };
+    };
+
+    template<typename KeyType>
+    struct BucketHistogramRow {
+        KeyType start;
+        KeyType end;
+        Histogram histogram;
+    };
+
+    /**
+     * Counts double or int64 values into a histogram per key bucket, so that the distribution of
+     * values over time or any other key can be queried without returning the raw values. Every
+     * bucket histogram has the bins of the prototype passed to the constructor. Only buckets
+     * which hold at least one valid value are emitted, and bucket histograms with the same spec
+     * and bins may be merged.
+     *
+     * @tparam KeyType
+     */
+    template<typename KeyType>
+    class BucketHistogram {
+
+    public:
+        BucketHistogram(const BucketSpec<KeyType> &spec, const Histogram &prototype)
+            : m_spec(spec),
+              m_prototype(prototype)
+        {
+            TU_ASSERT (m_spec.width > 0);
+            TU_ASSERT (m_prototype.isValid() && m_prototype.getTotal() == 0);
+        };
+
+        const BucketSpec<KeyType> &getSpec() const { return m_spec; };
+        int numBuckets() const { return m_buckets.size(); };
+
+        // page summaries carry no distribution, so every page must be decoded
+        static constexpr bool supportsSummaries() { return false; };
+
+        /**
+         * Counts the valid values of the view into the histograms of their key buckets.
+         *
+         * @tparam ValueType
+         * @param view
+         */
+        template<typename ValueType>
+        void
+        accumulate(const groove_data::VectorView<KeyType,ValueType> &view)
+        {
+            std::vector<double> buffer;
+            for_each_bucket_run(m_spec, view, [this, &buffer](KeyType start, const TypedSpan<ValueType> &values) {
+                const ValueSpan &run = widen_span(values, buffer);
+                if (count_kernel(run) > 0) {
+                    getBucket(start).add(run);
+                }
+            });
+        };
+
+        /**
+         * Returns a bucket histogram with the same spec and bins and no buckets.
+         *
+         * @return
+         */
+        BucketHistogram
+        emptyCopy() const
+        {
+            return BucketHistogram(m_spec, m_prototype);
+        };
+
+        void
+        merge(const BucketHistogram &other)
+        {
+            TU_ASSERT (m_spec.origin == other.m_spec.origin && m_spec.width == other.m_spec.width);
+            TU_ASSERT (m_prototype.hasSameBins(other.m_prototype));
+            for (const auto &entry : other.m_buckets) {
+                getBucket(entry.first).merge(entry.second);
+            }
+        };
+
+        /**
+         * Returns one row per bucket in key order, holding the histogram of the bucket.
+         *
+         * @return
+         */
+        std::vector<BucketHistogramRow<KeyType>>
+        finalize() const
+        {
+            std::vector<BucketHistogramRow<KeyType>> rows;
+            rows.reserve(m_buckets.size());
+            for (const auto &entry : m_buckets) {
+                rows.push_back({entry.first, m_spec.bucketEnd(entry.first), entry.second});
+            }
+            return rows;
+        };
+
+    private:
+        BucketSpec<KeyType> m_spec;
+        Histogram m_prototype;
+        absl::btree_map<KeyType,Histogram> m_buckets;
+
+        Histogram &
+        getBucket(KeyType start)
+        {
+            if (!m_buckets.empty()) {
+                auto last = std::prev(m_buckets.end());
+                if (last->first == start)
+                    return last->second;
+            }
+            auto entry = m_buckets.try_emplace(start, m_prototype);
+            return entry.first->second;
+        };
+    };
+}
+
+#endif // GROOVE_MATH_BUCKET_REDUCER_TEMPLATE_H
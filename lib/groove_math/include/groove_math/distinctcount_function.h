@@ -0,0 +1,40 @@
+#ifndef GROOVE_MATH_DISTINCTCOUNT_FUNCTION_H
+#define GROOVE_MATH_DISTINCTCOUNT_FUNCTION_H
+
+#include <tempo_utils/option_template.h>
+
+#include "hyperloglog.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    class DistinctCountFunction {
+
+    public:
+        using State = HyperLogLog;
+
+        static State init();
+        static void accumulate(State &state, double input);
+        static void accumulate(State &state, const ValueSpan &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+
+        /**
+         * Accumulates the valid values of a vector view of any value type, for example the view
+         * of an Int64StringVector, a CategoryStringVector or an Int64Int64Vector.
+         *
+         * @tparam KeyType
+         * @tparam ValueType
+         * @param state
+         * @param view
+         */
+        template<typename KeyType, typename ValueType>
+        static void
+        accumulate(State &state, const groove_data::VectorView<KeyType,ValueType> &view)
+        {
+            state.add(view);
+        }
+    };
+}
+
+#endif // GROOVE_MATH_DISTINCTCOUNT_FUNCTION_H
@@ -0,0 +1,128 @@
+#ifndef GROOVE_MATH_FUSED_FUNCTION_TEMPLATE_H
+#define GROOVE_MATH_FUSED_FUNCTION_TEMPLATE_H
+
+#include <array>
+#include <tuple>
+#include <utility>
+
+#include "math_types.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * Evaluates every reducer in DefTypes in a single pass over the input, producing one output
+     * per reducer in the order of DefTypes. The reducers are the functions of DefTypes over
+     * ValueType, so int64 values are reduced by the int64 functions without being widened, and
+     * every reducer in DefTypes must have a function for ValueType. The state is the tuple of the
+     * partial states of the reducers. When every reducer can be derived from a summary (a
+     * ValueSummary, or an Int64Summary for int64 values), each span is read once by
+     * summary_kernel and the summary is merged into each state. Otherwise each span is passed to
+     * each reducer in turn while it is still in cache. Outputs are converted to double, and an
+     * int64 sum which overflows saturates as in Int64SumFunction::finalize.
+     *
+     * @tparam ValueType
+     * @tparam DefTypes
+     */
+    template <typename ValueType, typename... DefTypes>
+    class FusedFunction {
+
+        static_assert(sizeof...(DefTypes) > 0);
+
+    public:
+        using State = std::tuple<typename ReducerTraits<DefTypes,ValueType>::FunctionType::State...>;
+        using Output = std::array<double,sizeof...(DefTypes)>;
+        using Span = TypedSpan<ValueType>;
+        using Summary = decltype(summary_kernel(std::declval<const Span &>()));
+
+        static constexpr bool
+        supportsSummaries()
+        {
+            return (requires (const Summary &summary) {
+                ReducerTraits<DefTypes,ValueType>::FunctionType::fromSummary(summary);
+            } && ...);
+        };
+
+        static State
+        init()
+        {
+            return State(ReducerTraits<DefTypes,ValueType>::FunctionType::init()...);
+        };
+
+        static void
+        accumulate(State &state, ValueType input)
+        {
+            accumulate(state, input, std::index_sequence_for<DefTypes...>());
+        };
+
+        static void
+        accumulate(State &state, const Span &span)
+        {
+            if constexpr (supportsSummaries()) {
+                merge(state, fromSummary(summary_kernel(span)));
+            } else {
+                accumulate(state, span, std::index_sequence_for<DefTypes...>());
+            }
+        };
+
+        static void
+        merge(State &state, const State &other)
+        {
+            merge(state, other, std::index_sequence_for<DefTypes...>());
+        };
+
+        static State
+        fromSummary(const Summary &summary) requires (supportsSummaries())
+        {
+            return State(ReducerTraits<DefTypes,ValueType>::FunctionType::fromSummary(summary)...);
+        };
+
+        /**
+         * Returns the output of each reducer, or the corresponding identity for each reducer
+         * which has accumulated no values.
+         *
+         * @param state
+         * @param identity
+         * @return
+         */
+        static Output
+        finalize(const State &state, const Output &identity)
+        {
+            return finalize(state, identity, std::index_sequence_for<DefTypes...>());
+        };
+
+    private:
+        template<typename InputType, size_t... I>
+        static void
+        accumulate(State &state, const InputType &input, std::index_sequence<I...>)
+        {
+            (ReducerTraits<DefTypes,ValueType>::FunctionType::accumulate(std::get<I>(state), input), ...);
+        };
+
+        template<size_t... I>
+        static void
+        merge(State &state, const State &other, std::index_sequence<I...>)
+        {
+            (ReducerTraits<DefTypes,ValueType>::FunctionType::merge(std::get<I>(state), std::get<I>(other)), ...);
+        };
+
+        template<size_t... I>
+        static Output
+        finalize(const State &state, const Output &identity, std::index_sequence<I...>)
+        {
+            Output output;
+            ((output[I] = finalize<DefTypes>(std::get<I>(state), identity[I])), ...);
+            return output;
+        };
+
+        template<typename DefType, typename StateType>
+        static double
+        finalize(const StateType &state, double identity)
+        {
+            auto output = ReducerTraits<DefType,ValueType>::FunctionType::finalize(state);
+            return output.isEmpty()? identity : static_cast<double>(output.getValue());
+        };
+    };
+}
+
+#endif // GROOVE_MATH_FUSED_FUNCTION_TEMPLATE_H
@@ -0,0 +1,73 @@
+#ifndef GROOVE_MATH_HISTOGRAM_H
+#define GROOVE_MATH_HISTOGRAM_H
+
+#include <vector>
+
+#include <tempo_utils/integer_types.h>
+
+#include "math_result.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * Counts values into bins, either numBins bins of equal width starting at origin, or the
+     * bins between consecutive caller-supplied boundaries. Each bin includes its start and
+     * excludes its end. Values before the first bin and after the last bin are counted
+     * separately as underflow and overflow, and NaN values are not counted. Histograms with the
+     * same bins may be merged, so counts can be computed per page, thread or agent and combined.
+     */
+    class Histogram {
+
+    public:
+        Histogram();
+
+        static Histogram equiWidth(double origin, double width, int numBins);
+
+        /**
+         * Returns a histogram with a bin between each pair of consecutive boundaries, which must
+         * be strictly increasing.
+         *
+         * @param boundaries
+         * @return
+         */
+        static Histogram withBoundaries(const std::vector<double> &boundaries);
+
+        bool isValid() const;
+        bool isEquiWidth() const;
+        int numBins() const;
+        double binStart(int bin) const;
+        double binEnd(int bin) const;
+        tu_int64 getCount(int bin) const;
+        tu_int64 getUnderflow() const;
+        tu_int64 getOverflow() const;
+        tu_int64 getTotal() const;
+        bool hasSameBins(const Histogram &other) const;
+
+        /**
+         * Returns a histogram with the same bins and no counts, into which a separate part of
+         * the values can be counted and then merged.
+         *
+         * @return
+         */
+        Histogram emptyCopy() const;
+
+        void add(double value);
+        void add(const ValueSpan &span);
+        void merge(const Histogram &other);
+
+    private:
+        double m_origin;
+        double m_width;
+        std::vector<double> m_boundaries;
+        std::vector<tu_int64> m_counts;
+
+        Histogram(double origin, double width, int numBins);
+        explicit Histogram(const std::vector<double> &boundaries);
+
+        // returns the index into m_counts of the slot which counts value, which must not be NaN
+        int slotFor(double value) const;
+    };
+}
+
+#endif // GROOVE_MATH_HISTOGRAM_H
@@ -0,0 +1,29 @@
+#ifndef GROOVE_MATH_INT64_AVERAGE_FUNCTION_H
+#define GROOVE_MATH_INT64_AVERAGE_FUNCTION_H
+
+#include <tempo_utils/option_template.h>
+
+#include "partial_state.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * Averages int64 values. The values are summed exactly, so the average is only rounded once
+     * when the exact sum is divided by the count in finalize().
+     */
+    class Int64AverageFunction {
+
+    public:
+        using State = Int64SumState;
+
+        static State init();
+        static void accumulate(State &state, tu_int64 input);
+        static void accumulate(State &state, const Int64Span &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+        static State fromSummary(const Int64Summary &summary);
+    };
+}
+
+#endif // GROOVE_MATH_INT64_AVERAGE_FUNCTION_H
@@ -0,0 +1,29 @@
+#ifndef GROOVE_MATH_INT64_DISTINCTCOUNT_FUNCTION_H
+#define GROOVE_MATH_INT64_DISTINCTCOUNT_FUNCTION_H
+
+#include <tempo_utils/option_template.h>
+
+#include "hyperloglog.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * Estimates the number of distinct int64 values. The values are hashed as integers rather
+     * than widened to double, so values above 2^53 which round to the same double are still
+     * counted as distinct.
+     */
+    class Int64DistinctCountFunction {
+
+    public:
+        using State = HyperLogLog;
+
+        static State init();
+        static void accumulate(State &state, tu_int64 input);
+        static void accumulate(State &state, const Int64Span &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+    };
+}
+
+#endif // GROOVE_MATH_INT64_DISTINCTCOUNT_FUNCTION_H
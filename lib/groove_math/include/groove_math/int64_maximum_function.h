@@ -0,0 +1,25 @@
+#ifndef GROOVE_MATH_INT64_MAXIMUM_FUNCTION_H
+#define GROOVE_MATH_INT64_MAXIMUM_FUNCTION_H
+
+#include <tempo_utils/option_template.h>
+
+#include "math_result.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    class Int64MaximumFunction {
+
+    public:
+        using State = Option<tu_int64>;
+
+        static State init();
+        static void accumulate(State &state, tu_int64 input);
+        static void accumulate(State &state, const Int64Span &span);
+        static void merge(State &state, const State &other);
+        static Option<tu_int64> finalize(const State &state);
+        static State fromSummary(const Int64Summary &summary);
+    };
+}
+
+#endif // GROOVE_MATH_INT64_MAXIMUM_FUNCTION_H
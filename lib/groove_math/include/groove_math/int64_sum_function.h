@@ -0,0 +1,31 @@
+#ifndef GROOVE_MATH_INT64_SUM_FUNCTION_H
+#define GROOVE_MATH_INT64_SUM_FUNCTION_H
+
+#include <tempo_utils/option_template.h>
+
+#include "math_result.h"
+#include "partial_state.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * Sums int64 values exactly. If the sum does not fit in an int64 then finalize() saturates
+     * to the nearest representable value and validate() returns kMathOverflow.
+     */
+    class Int64SumFunction {
+
+    public:
+        using State = Int64SumState;
+
+        static State init();
+        static void accumulate(State &state, tu_int64 input);
+        static void accumulate(State &state, const Int64Span &span);
+        static void merge(State &state, const State &other);
+        static MathStatus validate(const State &state);
+        static Option<tu_int64> finalize(const State &state);
+        static State fromSummary(const Int64Summary &summary);
+    };
+}
+
+#endif // GROOVE_MATH_INT64_SUM_FUNCTION_H
@@ -15,6 +15,7 @@ namespace groove_math {
 
     enum class MathCondition {
         kMathInvariant,
+        kMathOverflow,
     };
 
     class MathStatus : public tempo_utils::TypedStatus<MathCondition> {
@@ -85,6 +86,8 @@ namespace tempo_utils {
             switch (condition) {
                 case groove_math::MathCondition::kMathInvariant:
                     return tempo_utils::StatusCode::kInternal;
+                case groove_math::MathCondition::kMathOverflow:
+                    return tempo_utils::StatusCode::kInvalidArgument;
                 default:
                     return tempo_utils::StatusCode::kUnknown;
             }
@@ -94,6 +97,8 @@ namespace tempo_utils {
             switch (condition) {
                 case groove_math::MathCondition::kMathInvariant:
                     return "Math invariant";
+                case groove_math::MathCondition::kMathOverflow:
+                    return "Math overflow";
                 default:
                     return "INVALID";
             }
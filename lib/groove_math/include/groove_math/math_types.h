@@ -9,7 +9,11 @@ namespace groove_math {
         EXPRESSION_MAX,
         EXPRESSION_MIN,
         EXPRESSION_SAMPLECOUNT,
-        EXPRESSION_SUM
+        EXPRESSION_SUM,
+        EXPRESSION_VARIANCE,
+        EXPRESSION_STDDEV,
+        EXPRESSION_QUANTILE,
+        EXPRESSION_DISTINCTCOUNT
     };
 
     class ReduceDef {
@@ -25,7 +29,12 @@ namespace groove_math {
         ExpressionType m_expressionType;
     };
 
-    template <typename DefType>
+    /**
+     * Selects the function which implements DefType over values of ValueType. Reducers over
+     * int64 columns are selected with ValueType tu_int64, and reduce natively without converting
+     * each value to double.
+     */
+    template <typename DefType, typename ValueType = double>
     struct ReducerTraits {};
 
     struct Average : public ReduceDef {
@@ -47,6 +56,33 @@ namespace groove_math {
     struct SampleCount : public ReduceDef {
         SampleCount();
     };
+
+    struct Variance : public ReduceDef {
+        Variance();
+    };
+
+    struct StdDev : public ReduceDef {
+        StdDev();
+    };
+
+    struct DistinctCount : public ReduceDef {
+        DistinctCount();
+    };
+
+    /**
+     * Reduces to the approximate value at quantile Numerator / Denominator, for example
+     * Quantile<95> is the 95th percentile and Quantile<999,1000> is the 99.9th percentile.
+     */
+    template <int Numerator, int Denominator = 100>
+    struct Quantile : public ReduceDef {
+        static_assert(0 <= Numerator && Numerator <= Denominator);
+        static constexpr double quantile() { return static_cast<double>(Numerator) / Denominator; }
+        Quantile() : ReduceDef(ExpressionType::EXPRESSION_QUANTILE) {};
+    };
+
+    using Median = Quantile<50>;
+    using P95 = Quantile<95>;
+    using P99 = Quantile<99>;
 }
 
 #endif // GROOVE_MATH_MATH_TYPES_H
\ No newline at end of file
@@ -3,19 +3,22 @@
 
 #include <tempo_utils/option_template.h>
 
-#include "math_result.h"
+#include "partial_state.h"
+#include "reduce_kernels.h"
 
 namespace groove_math {
 
     class MaximumFunction {
 
     public:
-        MaximumFunction();
-
-        MathStatus apply(double &output, const double &input);
-
-    private:
-        Option<double> m_max;
+        using State = Option<double>;
+
+        static State init();
+        static void accumulate(State &state, double input);
+        static void accumulate(State &state, const ValueSpan &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+        static State fromSummary(const ValueSummary &summary);
     };
 }
 
@@ -0,0 +1,67 @@
+#ifndef GROOVE_MATH_PARTIAL_STATE_H
+#define GROOVE_MATH_PARTIAL_STATE_H
+
+#include <tempo_utils/integer_types.h>
+
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * A running sum which carries the rounding error of each addition in a separate compensation
+     * term (Neumaier's variant of Kahan summation). The error of the total does not grow with the
+     * number of additions, so partial sums merged in any order agree with a serial sum to within
+     * rounding of the final value.
+     */
+    struct CompensatedSum {
+        double sum = 0.0;
+        double compensation = 0.0;
+
+        void add(double value);
+        void merge(const CompensatedSum &other);
+        double value() const;
+    };
+
+    /**
+     * Partial state of the sum and average reductions.
+     */
+    struct SumState {
+        CompensatedSum sum;
+        tu_int64 count = 0;
+
+        void add(double value);
+        void add(const ValueSpan &span);
+        void merge(const SumState &other);
+    };
+
+    /**
+     * Partial state of the int64 sum reduction. The sum is exact, since the 128-bit total cannot
+     * overflow, so it is only range checked when the reduction is finalized.
+     */
+    struct Int64SumState {
+        Int128 sum = 0;
+        tu_int64 count = 0;
+
+        void add(tu_int64 value);
+        void add(const Int64Span &span);
+        void merge(const Int64SumState &other);
+        bool overflows() const;
+    };
+
+    /**
+     * Partial state of the variance and standard deviation reductions. Values are accumulated
+     * with Welford's update, and partial states are combined with the pairwise update of Chan et
+     * al, so no sum of squares is ever formed and cancellation is avoided.
+     */
+    struct WelfordState {
+        tu_int64 count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double value);
+        void add(const ValueSpan &span);
+        void merge(const WelfordState &other);
+    };
+}
+
+#endif // GROOVE_MATH_PARTIAL_STATE_H
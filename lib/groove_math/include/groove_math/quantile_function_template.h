@@ -0,0 +1,33 @@
+#ifndef GROOVE_MATH_QUANTILE_FUNCTION_TEMPLATE_H
+#define GROOVE_MATH_QUANTILE_FUNCTION_TEMPLATE_H
+
+#include <tempo_utils/option_template.h>
+
+#include "quantile_sketch.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    /**
+     * Reduces to the approximate value at the quantile of DefType. The partial state is a
+     * QuantileSketch, so states can be serialized with QuantileSketch::toBytes, precomputed per
+     * page and merged across pages and agents.
+     *
+     * @tparam DefType
+     */
+    template <typename DefType>
+    class QuantileFunction {
+
+    public:
+        using State = QuantileSketch;
+
+        static State init() { return State(); };
+
+        static void accumulate(State &state, double input) { state.add(input); };
+        static void accumulate(State &state, const ValueSpan &span) { state.add(span); };
+        static void merge(State &state, const State &other) { state.merge(other); };
+        static Option<double> finalize(const State &state) { return state.quantile(DefType::quantile()); };
+    };
+}
+
+#endif // GROOVE_MATH_QUANTILE_FUNCTION_TEMPLATE_H
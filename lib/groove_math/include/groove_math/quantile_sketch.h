@@ -0,0 +1,64 @@
+#ifndef GROOVE_MATH_QUANTILE_SKETCH_H
+#define GROOVE_MATH_QUANTILE_SKETCH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tempo_utils/integer_types.h>
+#include <tempo_utils/option_template.h>
+
+#include "math_result.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    constexpr double kDefaultSketchCompression = 100.0;
+
+    /**
+     * A mergeable sketch of a distribution from which approximate quantiles can be read, using
+     * the merging t-digest. Values are summarized as weighted centroids which are small near the
+     * tails of the distribution, so extreme quantiles are more accurate than those near the
+     * median. The number of centroids is bounded by the compression regardless of the number of
+     * values added, and merging sketches gives the same accuracy as adding all the values to one
+     * sketch. NaN values are ignored.
+     */
+    class QuantileSketch {
+
+    public:
+        struct Centroid {
+            double mean;
+            double weight;
+        };
+
+        QuantileSketch();
+        explicit QuantileSketch(double compression);
+
+        double getCompression() const;
+        tu_int64 getCount() const;
+        Option<double> getMin() const;
+        Option<double> getMax() const;
+
+        void add(double value);
+        void add(const ValueSpan &span);
+        void merge(const QuantileSketch &other);
+
+        Option<double> quantile(double q) const;
+
+        std::string toBytes() const;
+        static tempo_utils::Result<QuantileSketch> fromBytes(std::string_view bytes);
+
+    private:
+        double m_compression;
+        std::vector<Centroid> m_centroids;
+        std::vector<double> m_buffer;
+        tu_int64 m_count;
+        double m_min;
+        double m_max;
+
+        void compress(std::vector<Centroid> &&incoming);
+        void flush();
+    };
+}
+
+#endif // GROOVE_MATH_QUANTILE_SKETCH_H
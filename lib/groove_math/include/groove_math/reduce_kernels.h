@@ -0,0 +1,182 @@
+#ifndef GROOVE_MATH_REDUCE_KERNELS_H
+#define GROOVE_MATH_REDUCE_KERNELS_H
+
+#include <vector>
+
+#include <groove_data/vector_view_template.h>
+#include <tempo_utils/option_template.h>
+
+namespace groove_math {
+
+    /**
+     * Precomputed summary of the valid values of a run of rows, such as the statistics stored
+     * with a page. Reductions whose state can be derived from a summary expose a static
+     * fromSummary() function, which lets callers skip decoding the rows entirely.
+     */
+    struct ValueSummary {
+        tu_int64 count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    /**
+     * A contiguous run of values together with the fidelity of each value. Only values with
+     * FIDELITY_VALID take part in a reduction, the fidelity mask is applied inside the kernels
+     * so no per-element filtering is needed by the caller.
+     *
+     * @tparam ValueType
+     */
+    template<typename ValueType>
+    struct TypedSpan {
+        const ValueType *values = nullptr;
+        tu_int64 length = 0;
+        groove_data::FidelitySpan fidelity;
+
+        TypedSpan
+        slice(tu_int64 offset, tu_int64 count) const
+        {
+            TypedSpan span{values + offset, count, fidelity};
+            if (fidelity.codes != nullptr) {
+                span.fidelity.codes = fidelity.codes + offset;
+            } else if (fidelity.validity != nullptr) {
+                span.fidelity.bitOffset = fidelity.bitOffset + offset;
+            }
+            return span;
+        };
+    };
+
+    using ValueSpan = TypedSpan<double>;
+    using Int64Span = TypedSpan<tu_int64>;
+
+    /**
+     * Signed 128-bit integer, wide enough to hold the exact sum of 2^64 int64 values.
+     */
+    __extension__ typedef __int128 Int128;
+
+    /**
+     * Precomputed summary of the valid int64 values of a run of rows, the int64 counterpart of
+     * ValueSummary. The sum is exact.
+     */
+    struct Int64Summary {
+        tu_int64 count = 0;
+        Int128 sum = 0;
+        tu_int64 min = 0;
+        tu_int64 max = 0;
+    };
+
+    /**
+     * Returns the sum of the valid values in the span.
+     */
+    double sum_kernel(const ValueSpan &span);
+
+    /**
+     * Returns the sum of the squared differences between center and each valid value in the span.
+     */
+    double squared_deviation_kernel(const ValueSpan &span, double center);
+
+    /**
+     * Returns the number of valid values in the span.
+     */
+    tu_int64 count_kernel(const ValueSpan &span);
+
+    /**
+     * Returns the smallest valid value in the span, or an empty option if the span has no valid
+     * values. NaN values are ignored.
+     */
+    Option<double> minimum_kernel(const ValueSpan &span);
+
+    /**
+     * Returns the largest valid value in the span, or an empty option if the span has no valid
+     * values. NaN values are ignored.
+     */
+    Option<double> maximum_kernel(const ValueSpan &span);
+
+    /**
+     * Returns the count, sum, minimum and maximum of the valid values in the span, computed in a
+     * single pass with all four accumulators held in registers. If there are no valid values the
+     * summary is zeroed. NaN values are ignored by the minimum and maximum.
+     */
+    ValueSummary summary_kernel(const ValueSpan &span);
+
+    /**
+     * Counts the valid values in the span into numBins bins of equal width starting at origin.
+     * The count of bin i is incremented at counts[i + 1], values before the first bin are counted
+     * at counts[0] and values after the last bin at counts[numBins + 1], so counts must hold
+     * numBins + 2 entries. NaN values are not counted.
+     */
+    void histogram_kernel(
+        const ValueSpan &span,
+        double origin,
+        double width,
+        int numBins,
+        tu_int64 *counts);
+
+    /**
+     * Returns the exact sum of the valid values in the span. The sum cannot overflow.
+     */
+    Int128 sum_kernel(const Int64Span &span);
+
+    /**
+     * Returns the number of valid values in the span.
+     */
+    tu_int64 count_kernel(const Int64Span &span);
+
+    /**
+     * Returns the smallest valid value in the span, or an empty option if the span has no valid
+     * values.
+     */
+    Option<tu_int64> minimum_kernel(const Int64Span &span);
+
+    /**
+     * Returns the largest valid value in the span, or an empty option if the span has no valid
+     * values.
+     */
+    Option<tu_int64> maximum_kernel(const Int64Span &span);
+
+    /**
+     * Returns the count, exact sum, minimum and maximum of the valid values in the span. If there
+     * are no valid values the summary is zeroed.
+     */
+    Int64Summary summary_kernel(const Int64Span &span);
+
+    /**
+     * Appends the valid values in the span to values, in span order.
+     */
+    void append_valid_values(const ValueSpan &span, std::vector<double> &values);
+
+    /**
+     * Returns the span unchanged, for generic code which also widens int64 spans.
+     */
+    inline const ValueSpan &widen_span(const ValueSpan &span, std::vector<double> &buffer) { return span; }
+
+    /**
+     * Converts the values of the span to double in buffer, and returns a value span over buffer
+     * with the fidelity of the span. The returned span is invalidated by the next use of buffer.
+     */
+    ValueSpan widen_span(const Int64Span &span, std::vector<double> &buffer);
+
+    /**
+     * Appends a value span for each chunk of the view to spans. The spans reference the memory
+     * of the vector the view belongs to, so the vector must outlive them.
+     *
+     * @tparam KeyType
+     * @param view
+     * @param spans
+     */
+    template<typename KeyType, typename ValueType>
+    void
+    append_value_spans(
+        const groove_data::VectorView<KeyType,ValueType> &view,
+        std::vector<TypedSpan<ValueType>> &spans)
+    {
+        for (int i = 0; i < view.numChunks(); i++) {
+            const auto &chunk = view.getChunk(i);
+            if (chunk.length == 0)
+                continue;
+            spans.push_back({chunk.values.values, chunk.length, chunk.fidelity});
+        }
+    }
+}
+
+#endif // GROOVE_MATH_REDUCE_KERNELS_H
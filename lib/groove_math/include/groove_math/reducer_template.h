@@ -1,53 +1,156 @@
 #ifndef GROOVE_MATH_REDUCER_TEMPLATE_H
 #define GROOVE_MATH_REDUCER_TEMPLATE_H
 
+#include <array>
+#include <vector>
+
+#include <groove_iterator/base_iterator.h>
 #include <tempo_utils/iterator_template.h>
 
 #include "base_reducer.h"
 #include "math_result.h"
+#include "reduce_kernels.h"
 #include "reducer_traits.h"
 
 namespace groove_math {
 
+    /**
+     * Reduces values with the function of DefType. A reduction is carried in an explicit partial
+     * state: init() returns an empty state, accumulate() adds values to it, merge() combines two
+     * states, and finalize() produces the output. States may be accumulated independently over
+     * pages, threads or agents and merged afterwards, and reduce() is simply init, accumulate and
+     * finalize run serially. The function is selected by both DefType and the ValueType of the
+     * input, so for example Reducer<Sum,tu_int64> sums int64 values exactly.
+     *
+     * @tparam DefType
+     * @tparam ValueType
+     */
     template<typename DefType,
-        typename FunctionType = typename ReducerTraits<DefType>::FunctionType,
-        typename InputType = typename ReducerTraits<DefType>::InputType,
-        typename OutputType = typename ReducerTraits<DefType>::OutputType>
+        typename ValueType = double,
+        typename FunctionType = typename ReducerTraits<DefType,ValueType>::FunctionType,
+        typename InputType = typename ReducerTraits<DefType,ValueType>::InputType,
+        typename OutputType = typename ReducerTraits<DefType,ValueType>::OutputType,
+        typename StateType = typename FunctionType::State>
     class Reducer : public BaseReducer {
 
     public:
-        typedef MathStatus (*ReduceFunction)(OutputType &, const InputType &);
-
         Reducer(const OutputType &identity)
-            : m_identity(identity),
-              m_reducer(FunctionType())
-        {
-        }
-
-        Reducer(const OutputType &identity, const FunctionType &reducer)
-            : m_identity(identity),
-              m_reducer(reducer)
+            : m_identity(identity)
         {
         }
 
     private:
         const OutputType m_identity;
-        FunctionType m_reducer;
 
     public:
 
-        tempo_utils::Result<OutputType>
-        reduce(std::shared_ptr<Iterator<InputType>> input)
+        StateType
+        init() const
+        {
+            return FunctionType::init();
+        }
+
+        /**
+         * Accumulates every value of the input. If the input is a BaseIterator then the values are
+         * drained in batches into a buffer on the stack, otherwise they are read one at a time.
+         *
+         * @param state
+         * @param input
+         */
+        void
+        accumulate(StateType &state, std::shared_ptr<Iterator<InputType>> input) const
+        {
+            auto *base = dynamic_cast<groove_iterator::BaseIterator<InputType> *>(input.get());
+            if (base == nullptr) {
+                InputType value;
+                while (input->getNext(value)) {
+                    FunctionType::accumulate(state, value);
+                }
+                return;
+            }
+
+            std::array<InputType, groove_iterator::kDefaultBatchSize> batch;
+            int count;
+            while ((count = base->getNextBatch(batch.data(), batch.size())) > 0) {
+                for (int i = 0; i < count; i++) {
+                    FunctionType::accumulate(state, batch[i]);
+                }
+            }
+        }
+
+        /**
+         * Accumulates contiguous spans of values with the vectorized kernels of the function.
+         * Values which are not FIDELITY_VALID are masked out by the kernels.
+         *
+         * @param state
+         * @param spans
+         */
+        void
+        accumulate(StateType &state, const std::vector<TypedSpan<InputType>> &spans) const
+        {
+            for (const auto &span : spans) {
+                FunctionType::accumulate(state, span);
+            }
+        }
+
+        void
+        merge(StateType &state, const StateType &other) const
         {
-            OutputType output = m_identity;
+            FunctionType::merge(state, other);
+        }
 
-            InputType next;
-            while (input->getNext(next)) {
-                MathStatus status = m_reducer.apply(output, next);
+        /**
+         * Returns the output of the reduction, or the identity if no values were accumulated.
+         *
+         * @param state
+         * @return
+         */
+        OutputType
+        finalize(const StateType &state) const
+        {
+            // fused functions produce several outputs, each with its own identity
+            if constexpr (requires { FunctionType::finalize(state, m_identity); }) {
+                return FunctionType::finalize(state, m_identity);
+            } else {
+                auto output = FunctionType::finalize(state);
+                if (output.isEmpty())
+                    return m_identity;
+                return output.getValue();
+            }
+        }
+
+        /**
+         * Returns the output of the reduction like finalize(), or a status if the function
+         * reports that the state has no valid output, for example an int64 sum which overflows.
+         *
+         * @param state
+         * @return
+         */
+        tempo_utils::Result<OutputType>
+        validateAndFinalize(const StateType &state) const
+        {
+            if constexpr (requires { FunctionType::validate(state); }) {
+                auto status = FunctionType::validate(state);
                 if (status.notOk())
                     return status;
             }
-            return output;
+            return finalize(state);
+        }
+
+        tempo_utils::Result<OutputType>
+        reduce(std::shared_ptr<Iterator<InputType>> input) const
+        {
+            auto state = init();
+            accumulate(state, input);
+            return validateAndFinalize(state);
+        }
+
+        tempo_utils::Result<OutputType>
+        reduce(const std::vector<TypedSpan<InputType>> &spans) const
+        {
+            auto state = init();
+            accumulate(state, spans);
+            return validateAndFinalize(state);
         }
     };
 }
@@ -2,12 +2,23 @@
 #define GROOVE_MATH_REDUCER_TRAITS_H
 
 #include "average_function.h"
+#include "distinctcount_function.h"
+#include "fused_function_template.h"
+#include "int64_average_function.h"
+#include "int64_distinctcount_function.h"
+#include "int64_maximum_function.h"
+#include "int64_minimum_function.h"
+#include "int64_samplecount_function.h"
+#include "int64_sum_function.h"
 #include "math_types.h"
 #include "math_result.h"
 #include "maximum_function.h"
 #include "minimum_function.h"
+#include "quantile_function_template.h"
 #include "samplecount_function.h"
+#include "stddev_function.h"
 #include "sum_function.h"
+#include "variance_function.h"
 
 namespace groove_math {
 
@@ -50,6 +61,94 @@ namespace groove_math {
         using InputType = double;
         using OutputType = double;
     };
+
+    template <>
+    struct ReducerTraits<Variance> {
+        using DefType = Variance;
+        using FunctionType = VarianceFunction;
+        using InputType = double;
+        using OutputType = double;
+    };
+
+    template <>
+    struct ReducerTraits<StdDev> {
+        using DefType = StdDev;
+        using FunctionType = StdDevFunction;
+        using InputType = double;
+        using OutputType = double;
+    };
+
+    template <>
+    struct ReducerTraits<DistinctCount> {
+        using DefType = DistinctCount;
+        using FunctionType = DistinctCountFunction;
+        using InputType = double;
+        using OutputType = double;
+    };
+
+    template <int Numerator, int Denominator>
+    struct ReducerTraits<Quantile<Numerator,Denominator>> {
+        using DefType = Quantile<Numerator,Denominator>;
+        using FunctionType = QuantileFunction<DefType>;
+        using InputType = double;
+        using OutputType = double;
+    };
+
+    template <>
+    struct ReducerTraits<Average, tu_int64> {
+        using DefType = Average;
+        using FunctionType = Int64AverageFunction;
+        using InputType = tu_int64;
+        using OutputType = double;
+    };
+
+    template <>
+    struct ReducerTraits<DistinctCount, tu_int64> {
+        using DefType = DistinctCount;
+        using FunctionType = Int64DistinctCountFunction;
+        using InputType = tu_int64;
+        using OutputType = double;
+    };
+
+    template <>
+    struct ReducerTraits<Maximum, tu_int64> {
+        using DefType = Maximum;
+        using FunctionType = Int64MaximumFunction;
+        using InputType = tu_int64;
+        using OutputType = tu_int64;
+    };
+
+    template <>
+    struct ReducerTraits<Minimum, tu_int64> {
+        using DefType = Minimum;
+        using FunctionType = Int64MinimumFunction;
+        using InputType = tu_int64;
+        using OutputType = tu_int64;
+    };
+
+    template <>
+    struct ReducerTraits<SampleCount, tu_int64> {
+        using DefType = SampleCount;
+        using FunctionType = Int64SampleCountFunction;
+        using InputType = tu_int64;
+        using OutputType = tu_int64;
+    };
+
+    template <>
+    struct ReducerTraits<Sum, tu_int64> {
+        using DefType = Sum;
+        using FunctionType = Int64SumFunction;
+        using InputType = tu_int64;
+        using OutputType = tu_int64;
+    };
+
+    template <typename... DefTypes>
+    struct ReducerTraits<std::tuple<DefTypes...>> {
+        using DefType = std::tuple<DefTypes...>;
+        using FunctionType = FusedFunction<double, DefTypes...>;
+        using InputType = double;
+        using OutputType = typename FusedFunction<double, DefTypes...>::Output;
+    };
 }
 
 #endif // GROOVE_MATH_REDUCER_TRAITS_H
\ No newline at end of file
@@ -1,19 +1,24 @@
 #ifndef GROOVE_MATH_SAMPLECOUNT_FUNCTION_H
 #define GROOVE_MATH_SAMPLECOUNT_FUNCTION_H
 
-#include "math_result.h"
+#include <tempo_utils/option_template.h>
+
+#include "partial_state.h"
+#include "reduce_kernels.h"
 
 namespace groove_math {
 
     class SampleCountFunction {
 
     public:
-        SampleCountFunction();
-
-        MathStatus apply(double &output, const double &input);
+        using State = tu_int64;
 
-    private:
-        double m_count;
+        static State init();
+        static void accumulate(State &state, double input);
+        static void accumulate(State &state, const ValueSpan &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+        static State fromSummary(const ValueSummary &summary);
     };
 }
 
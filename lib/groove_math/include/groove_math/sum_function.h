@@ -1,19 +1,24 @@
 #ifndef GROOVE_MATH_SUM_FUNCTION_H
 #define GROOVE_MATH_SUM_FUNCTION_H
 
-#include "math_result.h"
+#include <tempo_utils/option_template.h>
+
+#include "partial_state.h"
+#include "reduce_kernels.h"
 
 namespace groove_math {
 
     class SumFunction {
 
     public:
-        SumFunction();
-
-        MathStatus apply(double &output, const double &input);
+        using State = SumState;
 
-    private:
-        double m_sum;
+        static State init();
+        static void accumulate(State &state, double input);
+        static void accumulate(State &state, const ValueSpan &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+        static State fromSummary(const ValueSummary &summary);
     };
 }
 
@@ -0,0 +1,24 @@
+#ifndef GROOVE_MATH_VARIANCE_FUNCTION_H
+#define GROOVE_MATH_VARIANCE_FUNCTION_H
+
+#include <tempo_utils/option_template.h>
+
+#include "partial_state.h"
+#include "reduce_kernels.h"
+
+namespace groove_math {
+
+    class VarianceFunction {
+
+    public:
+        using State = WelfordState;
+
+        static State init();
+        static void accumulate(State &state, double input);
+        static void accumulate(State &state, const ValueSpan &span);
+        static void merge(State &state, const State &other);
+        static Option<double> finalize(const State &state);
+    };
+}
+
+#endif // GROOVE_MATH_VARIANCE_FUNCTION_H
\ No newline at end of file
@@ -1,17 +1,45 @@
 
 #include <groove_math/average_function.h>
 
-groove_math::AverageFunction::AverageFunction()
-    : m_sum(0.0),
-      m_count(0.0)
+groove_math::AverageFunction::State
+groove_math::AverageFunction::init()
 {
+    return State();
 }
 
-groove_math::MathStatus
-groove_math::AverageFunction::apply(double &output, const double &input)
+void
+groove_math::AverageFunction::accumulate(State &state, double input)
 {
-    m_sum += input;
-    m_count++;
-    output = m_sum / m_count;
-    return MathStatus::ok();
-}
\ No newline at end of file
+    state.add(input);
+}
+
+void
+groove_math::AverageFunction::accumulate(State &state, const ValueSpan &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::AverageFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+Option<double>
+groove_math::AverageFunction::finalize(const State &state)
+{
+    if (state.count == 0)
+        return {};
+    return Option<double>(state.sum.value() / state.count);
+}
+
+groove_math::AverageFunction::State
+groove_math::AverageFunction::fromSummary(const ValueSummary &summary)
+{
+    State state;
+    if (summary.count > 0) {
+        state.sum.add(summary.sum);
+        state.count = summary.count;
+    }
+    return state;
+}
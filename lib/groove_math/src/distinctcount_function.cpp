@@ -0,0 +1,34 @@
+
+#include <groove_math/distinctcount_function.h>
+
+groove_math::DistinctCountFunction::State
+groove_math::DistinctCountFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::DistinctCountFunction::accumulate(State &state, double input)
+{
+    state.add(input);
+}
+
+void
+groove_math::DistinctCountFunction::accumulate(State &state, const ValueSpan &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::DistinctCountFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+Option<double>
+groove_math::DistinctCountFunction::finalize(const State &state)
+{
+    if (state.isEmpty())
+        return {};
+    return Option<double>(state.estimate());
+}
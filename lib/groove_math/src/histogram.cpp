@@ -0,0 +1,168 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include <groove_math/histogram.h>
+
+groove_math::Histogram::Histogram()
+    : m_origin(0.0),
+      m_width(0.0)
+{
+}
+
+groove_math::Histogram::Histogram(double origin, double width, int numBins)
+    : m_origin(origin),
+      m_width(width),
+      m_counts(numBins + 2, 0)
+{
+    TU_ASSERT (std::isfinite(m_origin) && std::isfinite(m_width) && m_width > 0.0);
+    TU_ASSERT (numBins > 0);
+}
+
+groove_math::Histogram::Histogram(const std::vector<double> &boundaries)
+    : m_origin(0.0),
+      m_width(0.0),
+      m_boundaries(boundaries),
+      m_counts(boundaries.size() + 1, 0)
+{
+    TU_ASSERT (m_boundaries.size() >= 2);
+    TU_ASSERT (std::adjacent_find(m_boundaries.cbegin(), m_boundaries.cend(),
+        [](double lhs, double rhs) { return !(lhs < rhs); }) == m_boundaries.cend());
+}
+
+groove_math::Histogram
+groove_math::Histogram::equiWidth(double origin, double width, int numBins)
+{
+    return Histogram(origin, width, numBins);
+}
+
+groove_math::Histogram
+groove_math::Histogram::withBoundaries(const std::vector<double> &boundaries)
+{
+    return Histogram(boundaries);
+}
+
+bool
+groove_math::Histogram::isValid() const
+{
+    return !m_counts.empty();
+}
+
+bool
+groove_math::Histogram::isEquiWidth() const
+{
+    return m_boundaries.empty();
+}
+
+int
+groove_math::Histogram::numBins() const
+{
+    return m_counts.empty()? 0 : static_cast<int>(m_counts.size()) - 2;
+}
+
+double
+groove_math::Histogram::binStart(int bin) const
+{
+    TU_ASSERT (0 <= bin && bin < numBins());
+    return isEquiWidth()? m_origin + bin * m_width : m_boundaries[bin];
+}
+
+double
+groove_math::Histogram::binEnd(int bin) const
+{
+    TU_ASSERT (0 <= bin && bin < numBins());
+    return isEquiWidth()? m_origin + (bin + 1) * m_width : m_boundaries[bin + 1];
+}
+
+tu_int64
+groove_math::Histogram::getCount(int bin) const
+{
+    TU_ASSERT (0 <= bin && bin < numBins());
+    return m_counts[bin + 1];
+}
+
+tu_int64
+groove_math::Histogram::getUnderflow() const
+{
+    return m_counts.empty()? 0 : m_counts.front();
+}
+
+tu_int64
+groove_math::Histogram::getOverflow() const
+{
+    return m_counts.empty()? 0 : m_counts.back();
+}
+
+tu_int64
+groove_math::Histogram::getTotal() const
+{
+    tu_int64 total = 0;
+    for (auto count : m_counts) {
+        total += count;
+    }
+    return total;
+}
+
+bool
+groove_math::Histogram::hasSameBins(const Histogram &other) const
+{
+    return m_origin == other.m_origin
+        && m_width == other.m_width
+        && m_boundaries == other.m_boundaries
+        && m_counts.size() == other.m_counts.size();
+}
+
+groove_math::Histogram
+groove_math::Histogram::emptyCopy() const
+{
+    Histogram histogram(*this);
+    std::fill(histogram.m_counts.begin(), histogram.m_counts.end(), 0);
+    return histogram;
+}
+
+int
+groove_math::Histogram::slotFor(double value) const
+{
+    if (isEquiWidth()) {
+        // matches the arithmetic of histogram_kernel, so both paths bin a value identically
+        auto position = (value - m_origin) / m_width + 1.0;
+        position = std::min(std::max(position, 0.0), static_cast<double>(numBins() + 1));
+        return static_cast<int>(position);
+    }
+    auto upper = std::upper_bound(m_boundaries.cbegin(), m_boundaries.cend(), value);
+    return static_cast<int>(upper - m_boundaries.cbegin());
+}
+
+void
+groove_math::Histogram::add(double value)
+{
+    TU_ASSERT (isValid());
+    if (std::isnan(value))
+        return;
+    m_counts[slotFor(value)]++;
+}
+
+void
+groove_math::Histogram::add(const ValueSpan &span)
+{
+    TU_ASSERT (isValid());
+    if (isEquiWidth()) {
+        histogram_kernel(span, m_origin, m_width, numBins(), m_counts.data());
+        return;
+    }
+    // explicit boundaries are searched per value, the kernels only vectorize equal widths
+    for (tu_int64 i = 0; i < span.length; i++) {
+        if (span.fidelity.at(i) != groove_data::DatumFidelity::FIDELITY_VALID)
+            continue;
+        add(span.values[i]);
+    }
+}
+
+void
+groove_math::Histogram::merge(const Histogram &other)
+{
+    TU_ASSERT (hasSameBins(other));
+    for (size_t i = 0; i < m_counts.size(); i++) {
+        m_counts[i] += other.m_counts[i];
+    }
+}
@@ -0,0 +1,281 @@
+
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include <groove_math/hyperloglog.h>
+
+constexpr tu_uint8 kHyperLogLogVersion = 1;
+
+constexpr tu_uint64 kGoldenRatio = 0x9e3779b97f4a7c15ull;
+
+// the murmur3 finalizer, every input bit affects every output bit
+static inline tu_uint64
+mix64(tu_uint64 x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// words are assembled byte by byte, so the hash does not depend on the byte order of the host
+static tu_uint64
+hash_bytes(std::string_view bytes)
+{
+    tu_uint64 hash = kGoldenRatio ^ bytes.size();
+    size_t i = 0;
+    for (; i + 8 <= bytes.size(); i += 8) {
+        tu_uint64 word = 0;
+        for (int j = 0; j < 8; j++) {
+            word |= tu_uint64(static_cast<tu_uint8>(bytes[i + j])) << (8 * j);
+        }
+        hash = std::rotl((hash ^ mix64(word)) * kGoldenRatio, 27);
+    }
+    tu_uint64 tail = 0;
+    for (int j = 0; i + j < bytes.size(); j++) {
+        tail |= tu_uint64(static_cast<tu_uint8>(bytes[i + j])) << (8 * j);
+    }
+    return mix64(hash ^ mix64(tail));
+}
+
+groove_math::HyperLogLog::HyperLogLog()
+    : HyperLogLog(kDefaultHyperLogLogPrecision)
+{
+}
+
+groove_math::HyperLogLog::HyperLogLog(int precision)
+    : m_precision(precision)
+{
+    TU_ASSERT (kMinHyperLogLogPrecision <= m_precision && m_precision <= kMaxHyperLogLogPrecision);
+    m_registers.resize(size_t(1) << m_precision, 0);
+}
+
+int
+groove_math::HyperLogLog::getPrecision() const
+{
+    return m_precision;
+}
+
+bool
+groove_math::HyperLogLog::isEmpty() const
+{
+    for (auto rank : m_registers) {
+        if (rank != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * The top precision bits of the hash select a register, which keeps the largest rank seen, where
+ * the rank is one more than the number of leading zeros in the remaining bits.
+ */
+void
+groove_math::HyperLogLog::addHash(tu_uint64 hash)
+{
+    auto index = hash >> (64 - m_precision);
+    auto remaining = hash << m_precision;
+    tu_uint8 rank = remaining == 0? 64 - m_precision + 1 : std::countl_zero(remaining) + 1;
+    if (m_registers[index] < rank) {
+        m_registers[index] = rank;
+    }
+}
+
+void
+groove_math::HyperLogLog::add(tu_int64 value)
+{
+    addHash(mix64(static_cast<tu_uint64>(value) + kGoldenRatio));
+}
+
+void
+groove_math::HyperLogLog::add(double value)
+{
+    // equal values must hash equally, so both zeros and all NaNs are canonicalized
+    if (value == 0.0) {
+        value = 0.0;
+    } else if (std::isnan(value)) {
+        value = std::numeric_limits<double>::quiet_NaN();
+    }
+    addHash(mix64(std::bit_cast<tu_uint64>(value) + kGoldenRatio));
+}
+
+void
+groove_math::HyperLogLog::add(std::string_view value)
+{
+    addHash(hash_bytes(value));
+}
+
+void
+groove_math::HyperLogLog::add(const groove_data::Category &value)
+{
+    tu_uint64 hash = kGoldenRatio;
+    for (auto iterator = value.cbegin(); iterator != value.cend(); iterator++) {
+        hash = mix64(hash ^ hash_bytes(**iterator));
+    }
+    addHash(hash);
+}
+
+void
+groove_math::HyperLogLog::add(const ValueSpan &span)
+{
+    for (tu_int64 i = 0; i < span.length; i++) {
+        if (span.fidelity.at(i) == groove_data::DatumFidelity::FIDELITY_VALID) {
+            add(span.values[i]);
+        }
+    }
+}
+
+void
+groove_math::HyperLogLog::add(const Int64Span &span)
+{
+    for (tu_int64 i = 0; i < span.length; i++) {
+        if (span.fidelity.at(i) == groove_data::DatumFidelity::FIDELITY_VALID) {
+            add(span.values[i]);
+        }
+    }
+}
+
+/**
+ * Returns a copy of the registers folded down to a lower precision. The low bits of the old
+ * register index become the leading bits of the remaining hash, so the rank is recomputed from
+ * them, and the old rank only carries over when they are all zero.
+ */
+groove_math::HyperLogLog
+groove_math::HyperLogLog::withPrecision(int precision) const
+{
+    TU_ASSERT (precision <= m_precision);
+    if (precision == m_precision)
+        return *this;
+    HyperLogLog folded(precision);
+    const int shift = m_precision - precision;
+    const tu_uint64 lowMask = (tu_uint64(1) << shift) - 1;
+    for (tu_uint64 index = 0; index < m_registers.size(); index++) {
+        auto rank = m_registers[index];
+        if (rank == 0)
+            continue;
+        auto low = index & lowMask;
+        tu_uint8 foldedRank = low != 0? shift - std::bit_width(low) + 1 : shift + rank;
+        auto &target = folded.m_registers[index >> shift];
+        if (target < foldedRank) {
+            target = foldedRank;
+        }
+    }
+    return folded;
+}
+
+/**
+ * Merges the registers of other into this sketch. If the precisions differ then the result has
+ * the lower of the two.
+ */
+void
+groove_math::HyperLogLog::merge(const HyperLogLog &other)
+{
+    if (other.m_precision > m_precision) {
+        merge(other.withPrecision(m_precision));
+        return;
+    }
+    if (other.m_precision < m_precision) {
+        *this = withPrecision(other.m_precision);
+    }
+    for (size_t i = 0; i < m_registers.size(); i++) {
+        if (m_registers[i] < other.m_registers[i]) {
+            m_registers[i] = other.m_registers[i];
+        }
+    }
+}
+
+static double
+ertl_sigma(double x)
+{
+    if (x == 1.0)
+        return std::numeric_limits<double>::infinity();
+    double y = 1.0;
+    double z = x;
+    double prev;
+    do {
+        x *= x;
+        prev = z;
+        z += x * y;
+        y += y;
+    } while (z != prev);
+    return z;
+}
+
+static double
+ertl_tau(double x)
+{
+    if (x == 0.0 || x == 1.0)
+        return 0.0;
+    double y = 1.0;
+    double z = 1.0 - x;
+    double prev;
+    do {
+        x = std::sqrt(x);
+        prev = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != prev);
+    return z / 3.0;
+}
+
+/**
+ * Ertl's improved estimator, from the histogram of register values. See "New cardinality
+ * estimation algorithms for HyperLogLog sketches", Otmar Ertl, 2017.
+ */
+double
+groove_math::HyperLogLog::estimate() const
+{
+    const int q = 64 - m_precision;
+    const double m = m_registers.size();
+    std::vector<tu_int64> histogram(q + 2, 0);
+    for (auto rank : m_registers) {
+        histogram[rank]++;
+    }
+
+    double z = m * ertl_tau(1.0 - histogram[q + 1] / m);
+    for (int k = q; k >= 1; k--) {
+        z = 0.5 * (z + histogram[k]);
+    }
+    z += m * ertl_sigma(histogram[0] / m);
+    return m * m / (2.0 * std::log(2.0) * z);
+}
+
+std::string
+groove_math::HyperLogLog::toBytes() const
+{
+    std::string bytes;
+    bytes.reserve(2 + m_registers.size());
+    bytes.push_back(static_cast<char>(kHyperLogLogVersion));
+    bytes.push_back(static_cast<char>(m_precision));
+    bytes.append(reinterpret_cast<const char *>(m_registers.data()), m_registers.size());
+    return bytes;
+}
+
+tempo_utils::Result<groove_math::HyperLogLog>
+groove_math::HyperLogLog::fromBytes(std::string_view bytes)
+{
+    if (bytes.size() < 2 || static_cast<tu_uint8>(bytes[0]) != kHyperLogLogVersion)
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "unknown hyperloglog version");
+    int precision = static_cast<tu_uint8>(bytes[1]);
+    if (precision < kMinHyperLogLogPrecision || kMaxHyperLogLogPrecision < precision)
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "invalid hyperloglog precision {}", precision);
+    bytes.remove_prefix(2);
+
+    HyperLogLog sketch(precision);
+    if (bytes.size() != sketch.m_registers.size())
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "hyperloglog is malformed");
+    for (size_t i = 0; i < bytes.size(); i++) {
+        auto rank = static_cast<tu_uint8>(bytes[i]);
+        if (rank > 64 - precision + 1)
+            return MathStatus::forCondition(MathCondition::kMathInvariant,
+                "hyperloglog is malformed");
+        sketch.m_registers[i] = rank;
+    }
+    return sketch;
+}
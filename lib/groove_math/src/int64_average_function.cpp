@@ -0,0 +1,45 @@
+
+#include <groove_math/int64_average_function.h>
+
+groove_math::Int64AverageFunction::State
+groove_math::Int64AverageFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::Int64AverageFunction::accumulate(State &state, tu_int64 input)
+{
+    state.add(input);
+}
+
+void
+groove_math::Int64AverageFunction::accumulate(State &state, const Int64Span &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::Int64AverageFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+Option<double>
+groove_math::Int64AverageFunction::finalize(const State &state)
+{
+    if (state.count == 0)
+        return {};
+    return Option<double>(static_cast<double>(state.sum) / state.count);
+}
+
+groove_math::Int64AverageFunction::State
+groove_math::Int64AverageFunction::fromSummary(const Int64Summary &summary)
+{
+    State state;
+    if (summary.count > 0) {
+        state.sum = summary.sum;
+        state.count = summary.count;
+    }
+    return state;
+}
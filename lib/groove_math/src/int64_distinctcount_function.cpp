@@ -0,0 +1,34 @@
+
+#include <groove_math/int64_distinctcount_function.h>
+
+groove_math::Int64DistinctCountFunction::State
+groove_math::Int64DistinctCountFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::Int64DistinctCountFunction::accumulate(State &state, tu_int64 input)
+{
+    state.add(input);
+}
+
+void
+groove_math::Int64DistinctCountFunction::accumulate(State &state, const Int64Span &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::Int64DistinctCountFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+Option<double>
+groove_math::Int64DistinctCountFunction::finalize(const State &state)
+{
+    if (state.isEmpty())
+        return {};
+    return Option<double>(state.estimate());
+}
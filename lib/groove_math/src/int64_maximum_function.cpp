@@ -0,0 +1,45 @@
+#include <groove_math/int64_maximum_function.h>
+
+groove_math::Int64MaximumFunction::State
+groove_math::Int64MaximumFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::Int64MaximumFunction::accumulate(State &state, tu_int64 input)
+{
+    if (state.isEmpty() || state.getValue() < input) {
+        state = Option<tu_int64>(input);
+    }
+}
+
+void
+groove_math::Int64MaximumFunction::accumulate(State &state, const Int64Span &span)
+{
+    merge(state, maximum_kernel(span));
+}
+
+void
+groove_math::Int64MaximumFunction::merge(State &state, const State &other)
+{
+    if (other.isEmpty())
+        return;
+    if (state.isEmpty() || state.getValue() < other.getValue()) {
+        state = other;
+    }
+}
+
+Option<tu_int64>
+groove_math::Int64MaximumFunction::finalize(const State &state)
+{
+    return state;
+}
+
+groove_math::Int64MaximumFunction::State
+groove_math::Int64MaximumFunction::fromSummary(const Int64Summary &summary)
+{
+    if (summary.count == 0)
+        return {};
+    return Option<tu_int64>(summary.max);
+}
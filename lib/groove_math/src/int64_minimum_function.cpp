@@ -0,0 +1,45 @@
+#include <groove_math/int64_minimum_function.h>
+
+groove_math::Int64MinimumFunction::State
+groove_math::Int64MinimumFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::Int64MinimumFunction::accumulate(State &state, tu_int64 input)
+{
+    if (state.isEmpty() || state.getValue() > input) {
+        state = Option<tu_int64>(input);
+    }
+}
+
+void
+groove_math::Int64MinimumFunction::accumulate(State &state, const Int64Span &span)
+{
+    merge(state, minimum_kernel(span));
+}
+
+void
+groove_math::Int64MinimumFunction::merge(State &state, const State &other)
+{
+    if (other.isEmpty())
+        return;
+    if (state.isEmpty() || state.getValue() > other.getValue()) {
+        state = other;
+    }
+}
+
+Option<tu_int64>
+groove_math::Int64MinimumFunction::finalize(const State &state)
+{
+    return state;
+}
+
+groove_math::Int64MinimumFunction::State
+groove_math::Int64MinimumFunction::fromSummary(const Int64Summary &summary)
+{
+    if (summary.count == 0)
+        return {};
+    return Option<tu_int64>(summary.min);
+}
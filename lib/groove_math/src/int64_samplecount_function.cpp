@@ -0,0 +1,39 @@
+#include <groove_math/int64_samplecount_function.h>
+
+groove_math::Int64SampleCountFunction::State
+groove_math::Int64SampleCountFunction::init()
+{
+    return 0;
+}
+
+void
+groove_math::Int64SampleCountFunction::accumulate(State &state, tu_int64 input)
+{
+    state++;
+}
+
+void
+groove_math::Int64SampleCountFunction::accumulate(State &state, const Int64Span &span)
+{
+    state += count_kernel(span);
+}
+
+void
+groove_math::Int64SampleCountFunction::merge(State &state, const State &other)
+{
+    state += other;
+}
+
+Option<tu_int64>
+groove_math::Int64SampleCountFunction::finalize(const State &state)
+{
+    if (state == 0)
+        return {};
+    return Option<tu_int64>(state);
+}
+
+groove_math::Int64SampleCountFunction::State
+groove_math::Int64SampleCountFunction::fromSummary(const Int64Summary &summary)
+{
+    return summary.count;
+}
@@ -0,0 +1,58 @@
+#include <limits>
+
+#include <groove_math/int64_sum_function.h>
+
+groove_math::Int64SumFunction::State
+groove_math::Int64SumFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::Int64SumFunction::accumulate(State &state, tu_int64 input)
+{
+    state.add(input);
+}
+
+void
+groove_math::Int64SumFunction::accumulate(State &state, const Int64Span &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::Int64SumFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+groove_math::MathStatus
+groove_math::Int64SumFunction::validate(const State &state)
+{
+    if (state.overflows())
+        return MathStatus::forCondition(MathCondition::kMathOverflow, "int64 sum overflow");
+    return MathStatus::ok();
+}
+
+Option<tu_int64>
+groove_math::Int64SumFunction::finalize(const State &state)
+{
+    if (state.count == 0)
+        return {};
+    if (state.sum < std::numeric_limits<tu_int64>::min())
+        return Option<tu_int64>(std::numeric_limits<tu_int64>::min());
+    if (state.sum > std::numeric_limits<tu_int64>::max())
+        return Option<tu_int64>(std::numeric_limits<tu_int64>::max());
+    return Option<tu_int64>(static_cast<tu_int64>(state.sum));
+}
+
+groove_math::Int64SumFunction::State
+groove_math::Int64SumFunction::fromSummary(const Int64Summary &summary)
+{
+    State state;
+    if (summary.count > 0) {
+        state.sum = summary.sum;
+        state.count = summary.count;
+    }
+    return state;
+}
@@ -40,4 +40,16 @@ groove_math::Sum::Sum() : ReduceDef(ExpressionType::EXPRESSION_SUM)
 
 groove_math::SampleCount::SampleCount() : ReduceDef(ExpressionType::EXPRESSION_SAMPLECOUNT)
 {
+}
+
+groove_math::Variance::Variance() : ReduceDef(ExpressionType::EXPRESSION_VARIANCE)
+{
+}
+
+groove_math::StdDev::StdDev() : ReduceDef(ExpressionType::EXPRESSION_STDDEV)
+{
+}
+
+groove_math::DistinctCount::DistinctCount() : ReduceDef(ExpressionType::EXPRESSION_DISTINCTCOUNT)
+{
 }
\ No newline at end of file
@@ -1,17 +1,46 @@
 
 #include <groove_math/maximum_function.h>
 
-groove_math::MaximumFunction::MaximumFunction()
-    : m_max()
+groove_math::MaximumFunction::State
+groove_math::MaximumFunction::init()
 {
+    return State();
 }
 
-groove_math::MathStatus
-groove_math::MaximumFunction::apply(double &output, const double &input)
+void
+groove_math::MaximumFunction::accumulate(State &state, double input)
 {
-    if (m_max.isEmpty() || m_max.getValue() < input) {
-        m_max = Option<double>(input);
+    if (state.isEmpty() || state.getValue() < input) {
+        state = Option<double>(input);
     }
-    output = m_max.getValue();
-    return MathStatus::ok();
-}
\ No newline at end of file
+}
+
+void
+groove_math::MaximumFunction::accumulate(State &state, const ValueSpan &span)
+{
+    merge(state, maximum_kernel(span));
+}
+
+void
+groove_math::MaximumFunction::merge(State &state, const State &other)
+{
+    if (other.isEmpty())
+        return;
+    if (state.isEmpty() || state.getValue() < other.getValue()) {
+        state = other;
+    }
+}
+
+Option<double>
+groove_math::MaximumFunction::finalize(const State &state)
+{
+    return state;
+}
+
+groove_math::MaximumFunction::State
+groove_math::MaximumFunction::fromSummary(const ValueSummary &summary)
+{
+    if (summary.count == 0)
+        return {};
+    return Option<double>(summary.max);
+}
@@ -1,17 +1,46 @@
 
 #include <groove_math/minimum_function.h>
 
-groove_math::MinimumFunction::MinimumFunction()
-    : m_min()
+groove_math::MinimumFunction::State
+groove_math::MinimumFunction::init()
 {
+    return State();
 }
 
-groove_math::MathStatus
-groove_math::MinimumFunction::apply(double &output, const double &input)
+void
+groove_math::MinimumFunction::accumulate(State &state, double input)
 {
-    if (m_min.isEmpty() || m_min.getValue() > input) {
-        m_min = Option<double>(input);
+    if (state.isEmpty() || state.getValue() > input) {
+        state = Option<double>(input);
     }
-    output = m_min.getValue();
-    return MathStatus::ok();
-}
\ No newline at end of file
+}
+
+void
+groove_math::MinimumFunction::accumulate(State &state, const ValueSpan &span)
+{
+    merge(state, minimum_kernel(span));
+}
+
+void
+groove_math::MinimumFunction::merge(State &state, const State &other)
+{
+    if (other.isEmpty())
+        return;
+    if (state.isEmpty() || state.getValue() > other.getValue()) {
+        state = other;
+    }
+}
+
+Option<double>
+groove_math::MinimumFunction::finalize(const State &state)
+{
+    return state;
+}
+
+groove_math::MinimumFunction::State
+groove_math::MinimumFunction::fromSummary(const ValueSummary &summary)
+{
+    if (summary.count == 0)
+        return {};
+    return Option<double>(summary.min);
+}
@@ -0,0 +1,122 @@
+
+#include <cmath>
+#include <limits>
+
+#include <groove_math/partial_state.h>
+
+void
+groove_math::CompensatedSum::add(double value)
+{
+    double total = sum + value;
+    if (std::abs(sum) >= std::abs(value)) {
+        compensation += (sum - total) + value;
+    } else {
+        compensation += (value - total) + sum;
+    }
+    sum = total;
+}
+
+void
+groove_math::CompensatedSum::merge(const CompensatedSum &other)
+{
+    add(other.sum);
+    compensation += other.compensation;
+}
+
+double
+groove_math::CompensatedSum::value() const
+{
+    return sum + compensation;
+}
+
+void
+groove_math::SumState::add(double value)
+{
+    sum.add(value);
+    count++;
+}
+
+void
+groove_math::SumState::add(const ValueSpan &span)
+{
+    auto spanCount = count_kernel(span);
+    if (spanCount == 0)
+        return;
+    sum.add(sum_kernel(span));
+    count += spanCount;
+}
+
+void
+groove_math::SumState::merge(const SumState &other)
+{
+    sum.merge(other.sum);
+    count += other.count;
+}
+
+void
+groove_math::Int64SumState::add(tu_int64 value)
+{
+    sum += value;
+    count++;
+}
+
+void
+groove_math::Int64SumState::add(const Int64Span &span)
+{
+    auto spanCount = count_kernel(span);
+    if (spanCount == 0)
+        return;
+    sum += sum_kernel(span);
+    count += spanCount;
+}
+
+void
+groove_math::Int64SumState::merge(const Int64SumState &other)
+{
+    sum += other.sum;
+    count += other.count;
+}
+
+bool
+groove_math::Int64SumState::overflows() const
+{
+    return sum < std::numeric_limits<tu_int64>::min() || sum > std::numeric_limits<tu_int64>::max();
+}
+
+void
+groove_math::WelfordState::add(double value)
+{
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+void
+groove_math::WelfordState::add(const ValueSpan &span)
+{
+    // summarize the span with a two-pass mean and squared deviation, then merge it as a partial
+    WelfordState spanState;
+    spanState.count = count_kernel(span);
+    if (spanState.count == 0)
+        return;
+    spanState.mean = sum_kernel(span) / spanState.count;
+    spanState.m2 = squared_deviation_kernel(span, spanState.mean);
+    merge(spanState);
+}
+
+void
+groove_math::WelfordState::merge(const WelfordState &other)
+{
+    if (other.count == 0)
+        return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    tu_int64 total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+    count = total;
+}
@@ -0,0 +1,325 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+
+#include <groove_math/quantile_sketch.h>
+#include <tempo_utils/big_endian.h>
+
+// values are buffered and sorted into the centroids in batches of this many times the compression
+constexpr double kBufferFactor = 5.0;
+
+constexpr tu_uint8 kSketchVersion = 1;
+
+groove_math::QuantileSketch::QuantileSketch()
+    : QuantileSketch(kDefaultSketchCompression)
+{
+}
+
+groove_math::QuantileSketch::QuantileSketch(double compression)
+    : m_compression(compression),
+      m_count(0),
+      m_min(std::numeric_limits<double>::infinity()),
+      m_max(-std::numeric_limits<double>::infinity())
+{
+    TU_ASSERT (m_compression > 0.0);
+}
+
+double
+groove_math::QuantileSketch::getCompression() const
+{
+    return m_compression;
+}
+
+tu_int64
+groove_math::QuantileSketch::getCount() const
+{
+    return m_count;
+}
+
+Option<double>
+groove_math::QuantileSketch::getMin() const
+{
+    if (m_count == 0)
+        return {};
+    return Option<double>(m_min);
+}
+
+Option<double>
+groove_math::QuantileSketch::getMax() const
+{
+    if (m_count == 0)
+        return {};
+    return Option<double>(m_max);
+}
+
+void
+groove_math::QuantileSketch::add(double value)
+{
+    if (std::isnan(value))
+        return;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_count++;
+    m_buffer.push_back(value);
+    if (m_buffer.size() >= kBufferFactor * m_compression) {
+        flush();
+    }
+}
+
+void
+groove_math::QuantileSketch::add(const ValueSpan &span)
+{
+    auto first = m_buffer.size();
+    append_valid_values(span, m_buffer);
+    auto last = std::remove_if(m_buffer.begin() + first, m_buffer.end(), [](double value) {
+        return std::isnan(value);
+    });
+    m_buffer.erase(last, m_buffer.end());
+    for (auto iterator = m_buffer.cbegin() + first; iterator != m_buffer.cend(); iterator++) {
+        m_min = std::min(m_min, *iterator);
+        m_max = std::max(m_max, *iterator);
+    }
+    m_count += m_buffer.size() - first;
+    if (m_buffer.size() >= kBufferFactor * m_compression) {
+        flush();
+    }
+}
+
+void
+groove_math::QuantileSketch::merge(const QuantileSketch &other)
+{
+    if (other.m_count == 0)
+        return;
+    std::vector<Centroid> incoming = other.m_centroids;
+    for (auto value : other.m_buffer) {
+        incoming.push_back({value, 1.0});
+    }
+    for (auto value : m_buffer) {
+        incoming.push_back({value, 1.0});
+    }
+    m_buffer.clear();
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_count += other.m_count;
+    compress(std::move(incoming));
+}
+
+void
+groove_math::QuantileSketch::flush()
+{
+    if (m_buffer.empty())
+        return;
+    std::vector<Centroid> incoming;
+    incoming.reserve(m_buffer.size());
+    for (auto value : m_buffer) {
+        incoming.push_back({value, 1.0});
+    }
+    m_buffer.clear();
+    compress(std::move(incoming));
+}
+
+/**
+ * Maps quantile q onto the k1 scale of the t-digest, on which each centroid spans at most one
+ * unit. The scale is steepest at the tails, so centroids there hold few values, and its range is
+ * the compression, so the number of centroids is bounded by the compression.
+ */
+static double
+k1_scale(double q, double compression)
+{
+    return compression / (2.0 * std::numbers::pi) * std::asin(2.0 * std::clamp(q, 0.0, 1.0) - 1.0);
+}
+
+/**
+ * Sorts the incoming centroids into the sketch, then merges adjacent centroids while the merged
+ * centroid spans at most one unit of the k1 scale.
+ */
+void
+groove_math::QuantileSketch::compress(std::vector<Centroid> &&incoming)
+{
+    std::vector<Centroid> centroids = std::move(incoming);
+    centroids.insert(centroids.end(), m_centroids.cbegin(), m_centroids.cend());
+    if (centroids.empty())
+        return;
+    std::sort(centroids.begin(), centroids.end(), [](const Centroid &lhs, const Centroid &rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    double total = 0.0;
+    for (const auto &centroid : centroids) {
+        total += centroid.weight;
+    }
+
+    m_centroids.clear();
+    Centroid current = centroids.front();
+    double weightSoFar = 0.0;
+    double kLeft = k1_scale(0.0, m_compression);
+    for (size_t i = 1; i < centroids.size(); i++) {
+        const auto &next = centroids[i];
+        double proposed = current.weight + next.weight;
+        if (k1_scale((weightSoFar + proposed) / total, m_compression) - kLeft <= 1.0) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed;
+            current.weight = proposed;
+        } else {
+            weightSoFar += current.weight;
+            kLeft = k1_scale(weightSoFar / total, m_compression);
+            m_centroids.push_back(current);
+            current = next;
+        }
+    }
+    m_centroids.push_back(current);
+}
+
+/**
+ * Returns the approximate value at quantile q, interpolating linearly between the centers of
+ * adjacent centroids, and between the outermost centroids and the exact minimum and maximum.
+ */
+Option<double>
+groove_math::QuantileSketch::quantile(double q) const
+{
+    if (m_count == 0 || std::isnan(q))
+        return {};
+    if (!m_buffer.empty()) {
+        QuantileSketch flushed(*this);
+        flushed.flush();
+        return flushed.quantile(q);
+    }
+    if (q <= 0.0)
+        return Option<double>(m_min);
+    if (q >= 1.0)
+        return Option<double>(m_max);
+
+    const auto &centroids = m_centroids;
+    const double index = q * m_count;
+
+    const auto &first = centroids.front();
+    if (index < first.weight / 2.0) {
+        double value = m_min + (first.mean - m_min) * index / (first.weight / 2.0);
+        return Option<double>(std::clamp(value, m_min, m_max));
+    }
+
+    double cumulative = 0.0;
+    for (size_t i = 0; i + 1 < centroids.size(); i++) {
+        double left = cumulative + centroids[i].weight / 2.0;
+        double right = cumulative + centroids[i].weight + centroids[i + 1].weight / 2.0;
+        if (index < right) {
+            double value = centroids[i].mean
+                + (centroids[i + 1].mean - centroids[i].mean) * (index - left) / (right - left);
+            return Option<double>(std::clamp(value, m_min, m_max));
+        }
+        cumulative += centroids[i].weight;
+    }
+
+    const auto &last = centroids.back();
+    double left = m_count - last.weight / 2.0;
+    double value = last.mean + (m_max - last.mean) * (index - left) / (last.weight / 2.0);
+    return Option<double>(std::clamp(value, m_min, m_max));
+}
+
+// fields are written big endian so sketches can be exchanged between hosts
+
+template<typename T>
+static void
+append_bytes(std::string &bytes, T value)
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == 8);
+    if constexpr (sizeof(T) == 1) {
+        bytes.push_back(static_cast<char>(value));
+    } else {
+        tu_uint64 u64;
+        std::memcpy(&u64, &value, 8);
+        u64 = H_TO_BE64(u64);
+        bytes.append(reinterpret_cast<const char *>(&u64), 8);
+    }
+}
+
+template<typename T>
+static bool
+consume_bytes(std::string_view &bytes, T &value)
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == 8);
+    if (bytes.size() < sizeof(T))
+        return false;
+    if constexpr (sizeof(T) == 1) {
+        value = static_cast<T>(bytes.front());
+    } else {
+        tu_uint64 u64;
+        std::memcpy(&u64, bytes.data(), 8);
+        u64 = BE64_TO_H(u64);
+        std::memcpy(&value, &u64, 8);
+    }
+    bytes.remove_prefix(sizeof(T));
+    return true;
+}
+
+/**
+ * Serializes the sketch as a version byte, followed by the compression, count, minimum and
+ * maximum, the number of centroids and the mean and weight of each centroid. Buffered values
+ * are merged into the centroids first.
+ */
+std::string
+groove_math::QuantileSketch::toBytes() const
+{
+    if (!m_buffer.empty()) {
+        QuantileSketch flushed(*this);
+        flushed.flush();
+        return flushed.toBytes();
+    }
+
+    std::string bytes;
+    bytes.reserve(1 + 5 * 8 + 16 * m_centroids.size());
+    append_bytes(bytes, kSketchVersion);
+    append_bytes(bytes, m_compression);
+    append_bytes(bytes, m_count);
+    append_bytes(bytes, m_min);
+    append_bytes(bytes, m_max);
+    append_bytes(bytes, static_cast<tu_int64>(m_centroids.size()));
+    for (const auto &centroid : m_centroids) {
+        append_bytes(bytes, centroid.mean);
+        append_bytes(bytes, centroid.weight);
+    }
+    return bytes;
+}
+
+tempo_utils::Result<groove_math::QuantileSketch>
+groove_math::QuantileSketch::fromBytes(std::string_view bytes)
+{
+    tu_uint8 version;
+    if (!consume_bytes(bytes, version) || version != kSketchVersion)
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "unknown quantile sketch version");
+
+    double compression;
+    tu_int64 count;
+    double min, max;
+    tu_int64 numCentroids;
+    if (!consume_bytes(bytes, compression) || !consume_bytes(bytes, count)
+        || !consume_bytes(bytes, min) || !consume_bytes(bytes, max)
+        || !consume_bytes(bytes, numCentroids))
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "quantile sketch is truncated");
+    if (!(compression > 0.0) || count < 0 || numCentroids < 0
+        || static_cast<tu_uint64>(numCentroids) != bytes.size() / 16 || bytes.size() % 16 != 0)
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "quantile sketch is malformed");
+
+    QuantileSketch sketch(compression);
+    sketch.m_count = count;
+    if (count > 0) {
+        sketch.m_min = min;
+        sketch.m_max = max;
+    }
+    sketch.m_centroids.reserve(numCentroids);
+    for (tu_int64 i = 0; i < numCentroids; i++) {
+        Centroid centroid;
+        consume_bytes(bytes, centroid.mean);
+        consume_bytes(bytes, centroid.weight);
+        sketch.m_centroids.push_back(centroid);
+    }
+    if ((count == 0) != sketch.m_centroids.empty())
+        return MathStatus::forCondition(MathCondition::kMathInvariant,
+            "quantile sketch is malformed");
+    return sketch;
+}
@@ -0,0 +1,650 @@
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <groove_math/reduce_kernels.h>
+
+// the span is processed in blocks of 64 rows, so the fidelity mask of a block fits in one word
+constexpr tu_int64 kBlockSize = 64;
+
+static inline tu_uint64
+low_bits(tu_int64 n)
+{
+    return n >= 64? ~tu_uint64(0) : (tu_uint64(1) << n) - 1;
+}
+
+/**
+ * Returns a mask with bit i set if row start + i of the span is FIDELITY_VALID, for the n <= 64
+ * rows of the block beginning at start.
+ */
+static inline tu_uint64
+valid_mask(const groove_data::FidelitySpan &fidelity, tu_int64 start, tu_int64 n)
+{
+    if (fidelity.allValid)
+        return low_bits(n);
+
+    if (fidelity.codes != nullptr) {
+        constexpr auto kValid = static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID);
+        const tu_int8 *codes = fidelity.codes + start;
+        tu_uint64 mask = 0;
+        for (tu_int64 i = 0; i < n; i++) {
+            mask |= tu_uint64(codes[i] == kValid) << i;
+        }
+        return mask;
+    }
+
+    // gather the validity bits at an arbitrary bit offset, reading only the bytes which hold them
+    const tu_int64 bit = fidelity.bitOffset + start;
+    const tu_uint8 *bytes = fidelity.validity + (bit >> 3);
+    const int shift = bit & 7;
+    const tu_int64 numBytes = (shift + n + 7) >> 3;
+    tu_uint64 word = 0;
+    for (tu_int64 i = 0; i < std::min<tu_int64>(numBytes, 8); i++) {
+        word |= tu_uint64(bytes[i]) << (8 * i);
+    }
+    word >>= shift;
+    if (numBytes > 8) {
+        word |= tu_uint64(bytes[8]) << (64 - shift);
+    }
+    return word & low_bits(n);
+}
+
+#if defined(__AVX2__)
+
+// expands the low four bits into a mask with all bits of lane i set if bit i is set
+static inline __m256d
+lane_mask(tu_uint64 bits)
+{
+    const __m256i lanes = _mm256_setr_epi64x(1, 2, 4, 8);
+    auto selected = _mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(bits)), lanes);
+    return _mm256_castsi256_pd(_mm256_cmpeq_epi64(selected, lanes));
+}
+
+#elif defined(__SSE2__)
+
+alignas(16) static const tu_uint64 kLaneMasks[4][2] = {
+    {0, 0}, {~tu_uint64(0), 0}, {0, ~tu_uint64(0)}, {~tu_uint64(0), ~tu_uint64(0)},
+};
+
+// expands the low two bits into a mask with all bits of lane i set if bit i is set
+static inline __m128d
+lane_mask(tu_uint64 bits)
+{
+    return _mm_load_pd(reinterpret_cast<const double *>(kLaneMasks[bits & 0x3]));
+}
+
+#endif
+
+double
+groove_math::sum_kernel(const ValueSpan &span)
+{
+    double sum = 0.0;
+#if defined(__AVX2__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+#elif defined(__SSE2__)
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+#endif
+
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        const tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        const double *block = span.values + start;
+        tu_int64 i = 0;
+#if defined(__AVX2__)
+        if (mask == low_bits(n)) {
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(block + i));
+                acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(block + i + 4));
+            }
+        } else {
+            for (; i + 4 <= n; i += 4) {
+                auto values = _mm256_and_pd(_mm256_loadu_pd(block + i), lane_mask(mask >> i));
+                acc0 = _mm256_add_pd(acc0, values);
+            }
+        }
+#elif defined(__SSE2__)
+        if (mask == low_bits(n)) {
+            for (; i + 4 <= n; i += 4) {
+                acc0 = _mm_add_pd(acc0, _mm_loadu_pd(block + i));
+                acc1 = _mm_add_pd(acc1, _mm_loadu_pd(block + i + 2));
+            }
+        } else {
+            for (; i + 2 <= n; i += 2) {
+                acc0 = _mm_add_pd(acc0, _mm_and_pd(_mm_loadu_pd(block + i), lane_mask(mask >> i)));
+            }
+        }
+#endif
+        for (; i < n; i++) {
+            sum += ((mask >> i) & 1)? block[i] : 0.0;
+        }
+    }
+
+#if defined(__AVX2__)
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+    sum += lanes[0] + lanes[1];
+#endif
+    return sum;
+}
+
+double
+groove_math::squared_deviation_kernel(const ValueSpan &span, double center)
+{
+    // the select on the mask bit has no branch, which leaves the inner loop to the vectorizer
+    double sum = 0.0;
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        const tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        const double *block = span.values + start;
+        double blockSum = 0.0;
+        for (tu_int64 i = 0; i < n; i++) {
+            double deviation = ((mask >> i) & 1)? block[i] - center : 0.0;
+            blockSum += deviation * deviation;
+        }
+        sum += blockSum;
+    }
+    return sum;
+}
+
+static tu_int64
+count_valid(const groove_data::FidelitySpan &fidelity, tu_int64 length)
+{
+    if (fidelity.allValid)
+        return length;
+    if (fidelity.codes == nullptr)
+        return arrow::internal::CountSetBits(fidelity.validity, fidelity.bitOffset, length);
+    tu_int64 count = 0;
+    for (tu_int64 start = 0; start < length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, length - start);
+        count += std::popcount(valid_mask(fidelity, start, n));
+    }
+    return count;
+}
+
+tu_int64
+groove_math::count_kernel(const ValueSpan &span)
+{
+    return count_valid(span.fidelity, span.length);
+}
+
+/**
+ * Shared implementation of the minimum and maximum kernels. The vector min/max instructions
+ * return their second operand when either operand is NaN, so passing the accumulator second
+ * means NaN values are skipped, matching the scalar comparison.
+ */
+template<bool IsMax>
+static Option<double>
+extremum_kernel(const groove_math::ValueSpan &span)
+{
+    const double identity = IsMax?
+        -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+    double result = identity;
+    bool found = false;
+
+#if defined(__AVX2__)
+    const __m256d fill = _mm256_set1_pd(identity);
+    __m256d acc = fill;
+    auto combine = [](__m256d values, __m256d acc) {
+        return IsMax? _mm256_max_pd(values, acc) : _mm256_min_pd(values, acc);
+    };
+#elif defined(__SSE2__)
+    const __m128d fill = _mm_set1_pd(identity);
+    __m128d acc = fill;
+    auto combine = [](__m128d values, __m128d acc) {
+        return IsMax? _mm_max_pd(values, acc) : _mm_min_pd(values, acc);
+    };
+#endif
+
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        const tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        found = true;
+        const double *block = span.values + start;
+        tu_int64 i = 0;
+#if defined(__AVX2__)
+        if (mask == low_bits(n)) {
+            for (; i + 4 <= n; i += 4) {
+                acc = combine(_mm256_loadu_pd(block + i), acc);
+            }
+        } else {
+            for (; i + 4 <= n; i += 4) {
+                auto values = _mm256_blendv_pd(fill, _mm256_loadu_pd(block + i), lane_mask(mask >> i));
+                acc = combine(values, acc);
+            }
+        }
+#elif defined(__SSE2__)
+        if (mask == low_bits(n)) {
+            for (; i + 2 <= n; i += 2) {
+                acc = combine(_mm_loadu_pd(block + i), acc);
+            }
+        } else {
+            for (; i + 2 <= n; i += 2) {
+                auto laneMask = lane_mask(mask >> i);
+                auto values = _mm_or_pd(
+                    _mm_and_pd(laneMask, _mm_loadu_pd(block + i)), _mm_andnot_pd(laneMask, fill));
+                acc = combine(values, acc);
+            }
+        }
+#endif
+        for (; i < n; i++) {
+            if (!((mask >> i) & 1))
+                continue;
+            if (IsMax? block[i] > result : block[i] < result) {
+                result = block[i];
+            }
+        }
+    }
+
+    if (!found)
+        return {};
+
+#if defined(__AVX2__)
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    for (auto lane : lanes) {
+        result = IsMax? std::max(result, lane) : std::min(result, lane);
+    }
+#elif defined(__SSE2__)
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    for (auto lane : lanes) {
+        result = IsMax? std::max(result, lane) : std::min(result, lane);
+    }
+#endif
+    return Option<double>(result);
+}
+
+Option<double>
+groove_math::minimum_kernel(const ValueSpan &span)
+{
+    return extremum_kernel<false>(span);
+}
+
+Option<double>
+groove_math::maximum_kernel(const ValueSpan &span)
+{
+    return extremum_kernel<true>(span);
+}
+
+groove_math::ValueSummary
+groove_math::summary_kernel(const ValueSpan &span)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    tu_int64 count = 0;
+    double sum = 0.0;
+    double min = inf;
+    double max = -inf;
+
+#if defined(__AVX2__)
+    const __m256d posInf = _mm256_set1_pd(inf);
+    const __m256d negInf = _mm256_set1_pd(-inf);
+    __m256d sumAcc = _mm256_setzero_pd();
+    __m256d minAcc = posInf;
+    __m256d maxAcc = negInf;
+#elif defined(__SSE2__)
+    const __m128d posInf = _mm_set1_pd(inf);
+    const __m128d negInf = _mm_set1_pd(-inf);
+    __m128d sumAcc = _mm_setzero_pd();
+    __m128d minAcc = posInf;
+    __m128d maxAcc = negInf;
+#endif
+
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        const tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        count += std::popcount(mask);
+        const double *block = span.values + start;
+        tu_int64 i = 0;
+#if defined(__AVX2__)
+        if (mask == low_bits(n)) {
+            for (; i + 4 <= n; i += 4) {
+                auto values = _mm256_loadu_pd(block + i);
+                sumAcc = _mm256_add_pd(sumAcc, values);
+                minAcc = _mm256_min_pd(values, minAcc);
+                maxAcc = _mm256_max_pd(values, maxAcc);
+            }
+        } else {
+            for (; i + 4 <= n; i += 4) {
+                auto laneMask = lane_mask(mask >> i);
+                auto values = _mm256_loadu_pd(block + i);
+                sumAcc = _mm256_add_pd(sumAcc, _mm256_and_pd(values, laneMask));
+                minAcc = _mm256_min_pd(_mm256_blendv_pd(posInf, values, laneMask), minAcc);
+                maxAcc = _mm256_max_pd(_mm256_blendv_pd(negInf, values, laneMask), maxAcc);
+            }
+        }
+#elif defined(__SSE2__)
+        if (mask == low_bits(n)) {
+            for (; i + 2 <= n; i += 2) {
+                auto values = _mm_loadu_pd(block + i);
+                sumAcc = _mm_add_pd(sumAcc, values);
+                minAcc = _mm_min_pd(values, minAcc);
+                maxAcc = _mm_max_pd(values, maxAcc);
+            }
+        } else {
+            for (; i + 2 <= n; i += 2) {
+                auto laneMask = lane_mask(mask >> i);
+                auto values = _mm_and_pd(laneMask, _mm_loadu_pd(block + i));
+                sumAcc = _mm_add_pd(sumAcc, values);
+                minAcc = _mm_min_pd(_mm_or_pd(values, _mm_andnot_pd(laneMask, posInf)), minAcc);
+                maxAcc = _mm_max_pd(_mm_or_pd(values, _mm_andnot_pd(laneMask, negInf)), maxAcc);
+            }
+        }
+#endif
+        for (; i < n; i++) {
+            if (!((mask >> i) & 1))
+                continue;
+            sum += block[i];
+            if (block[i] < min) {
+                min = block[i];
+            }
+            if (block[i] > max) {
+                max = block[i];
+            }
+        }
+    }
+
+    ValueSummary summary;
+    if (count == 0)
+        return summary;
+
+#if defined(__AVX2__)
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, sumAcc);
+    sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm256_store_pd(lanes, minAcc);
+    for (auto lane : lanes) {
+        min = std::min(min, lane);
+    }
+    _mm256_store_pd(lanes, maxAcc);
+    for (auto lane : lanes) {
+        max = std::max(max, lane);
+    }
+#elif defined(__SSE2__)
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, sumAcc);
+    sum += lanes[0] + lanes[1];
+    _mm_store_pd(lanes, minAcc);
+    min = std::min({min, lanes[0], lanes[1]});
+    _mm_store_pd(lanes, maxAcc);
+    max = std::max({max, lanes[0], lanes[1]});
+#endif
+
+    summary.count = count;
+    summary.sum = sum;
+    summary.min = min;
+    summary.max = max;
+    return summary;
+}
+
+void
+groove_math::histogram_kernel(
+    const ValueSpan &span,
+    double origin,
+    double width,
+    int numBins,
+    tu_int64 *counts)
+{
+    // the bin position is offset by one and clamped to [0, numBins + 1] before truncation, so
+    // truncation is a floor and the underflow and overflow slots fall out of the clamp. The bin
+    // positions are computed in vector registers, only the increments themselves are scalar.
+    const double last = numBins + 1;
+
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        const double *block = span.values + start;
+        tu_int64 i = 0;
+#if defined(__AVX2__)
+        const __m256d originVec = _mm256_set1_pd(origin);
+        const __m256d widthVec = _mm256_set1_pd(width);
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d lastVec = _mm256_set1_pd(last);
+        const __m256d zero = _mm256_setzero_pd();
+        alignas(16) tu_int32 bins[4];
+        for (; i + 4 <= n; i += 4) {
+            auto values = _mm256_loadu_pd(block + i);
+            auto ordered = static_cast<tu_uint64>(_mm256_movemask_pd(_mm256_cmp_pd(values, values, _CMP_ORD_Q)));
+            auto lanes = (mask >> i) & ordered & 0xf;
+            if (lanes == 0)
+                continue;
+            auto position = _mm256_add_pd(_mm256_div_pd(_mm256_sub_pd(values, originVec), widthVec), one);
+            position = _mm256_min_pd(_mm256_max_pd(position, zero), lastVec);
+            _mm_store_si128(reinterpret_cast<__m128i *>(bins), _mm256_cvttpd_epi32(position));
+            for (int j = 0; j < 4; j++) {
+                counts[bins[j]] += (lanes >> j) & 1;
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128d originVec = _mm_set1_pd(origin);
+        const __m128d widthVec = _mm_set1_pd(width);
+        const __m128d one = _mm_set1_pd(1.0);
+        const __m128d lastVec = _mm_set1_pd(last);
+        const __m128d zero = _mm_setzero_pd();
+        alignas(16) tu_int32 bins[4];
+        for (; i + 2 <= n; i += 2) {
+            auto values = _mm_loadu_pd(block + i);
+            auto ordered = static_cast<tu_uint64>(_mm_movemask_pd(_mm_cmpord_pd(values, values)));
+            auto lanes = (mask >> i) & ordered & 0x3;
+            if (lanes == 0)
+                continue;
+            auto position = _mm_add_pd(_mm_div_pd(_mm_sub_pd(values, originVec), widthVec), one);
+            position = _mm_min_pd(_mm_max_pd(position, zero), lastVec);
+            _mm_store_si128(reinterpret_cast<__m128i *>(bins), _mm_cvttpd_epi32(position));
+            counts[bins[0]] += lanes & 1;
+            counts[bins[1]] += (lanes >> 1) & 1;
+        }
+#endif
+        for (; i < n; i++) {
+            if (!((mask >> i) & 1) || std::isnan(block[i]))
+                continue;
+            auto position = (block[i] - origin) / width + 1.0;
+            position = std::min(std::max(position, 0.0), last);
+            counts[static_cast<tu_int32>(position)]++;
+        }
+    }
+}
+
+groove_math::Int128
+groove_math::sum_kernel(const Int64Span &span)
+{
+    // each value is biased by 2^63 into an unsigned value, and the low and high 32-bit halves of
+    // the biased values are summed separately in 64-bit lanes. The halves of one block cannot
+    // overflow a lane, so the exact sum of the block is recovered without any carry detection.
+    constexpr tu_uint64 kBias = tu_uint64(1) << 63;
+    constexpr tu_uint64 kLowHalf = 0xffffffff;
+    Int128 sum = 0;
+
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        const tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        const tu_int64 *block = span.values + start;
+        tu_uint64 lowSum = 0;
+        tu_uint64 highSum = 0;
+        tu_int64 i = 0;
+#if defined(__AVX2__)
+        const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(kBias));
+        const __m256i lowHalf = _mm256_set1_epi64x(kLowHalf);
+        __m256i lowAcc = _mm256_setzero_si256();
+        __m256i highAcc = _mm256_setzero_si256();
+        for (; i + 4 <= n; i += 4) {
+            auto values = _mm256_xor_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i)), bias);
+            values = _mm256_and_si256(values, _mm256_castpd_si256(lane_mask(mask >> i)));
+            lowAcc = _mm256_add_epi64(lowAcc, _mm256_and_si256(values, lowHalf));
+            highAcc = _mm256_add_epi64(highAcc, _mm256_srli_epi64(values, 32));
+        }
+        alignas(32) tu_uint64 lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), lowAcc);
+        lowSum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), highAcc);
+        highSum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+        const __m128i bias = _mm_set1_epi64x(static_cast<long long>(kBias));
+        const __m128i lowHalf = _mm_set1_epi64x(kLowHalf);
+        __m128i lowAcc = _mm_setzero_si128();
+        __m128i highAcc = _mm_setzero_si128();
+        for (; i + 2 <= n; i += 2) {
+            auto values = _mm_xor_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i)), bias);
+            values = _mm_and_si128(values, _mm_castpd_si128(lane_mask(mask >> i)));
+            lowAcc = _mm_add_epi64(lowAcc, _mm_and_si128(values, lowHalf));
+            highAcc = _mm_add_epi64(highAcc, _mm_srli_epi64(values, 32));
+        }
+        alignas(16) tu_uint64 lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), lowAcc);
+        lowSum += lanes[0] + lanes[1];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), highAcc);
+        highSum += lanes[0] + lanes[1];
+#endif
+        for (; i < n; i++) {
+            if (!((mask >> i) & 1))
+                continue;
+            auto biased = static_cast<tu_uint64>(block[i]) ^ kBias;
+            lowSum += biased & kLowHalf;
+            highSum += biased >> 32;
+        }
+        sum += (Int128(highSum) << 32) + Int128(lowSum) - Int128(std::popcount(mask)) * Int128(kBias);
+    }
+    return sum;
+}
+
+tu_int64
+groove_math::count_kernel(const Int64Span &span)
+{
+    return count_valid(span.fidelity, span.length);
+}
+
+/**
+ * Shared implementation of the int64 minimum and maximum kernels. SSE2 has no 64-bit integer
+ * comparison, so only AVX2 builds take a vector path.
+ */
+template<bool IsMax>
+static Option<tu_int64>
+int64_extremum_kernel(const groove_math::Int64Span &span)
+{
+    const tu_int64 identity = IsMax?
+        std::numeric_limits<tu_int64>::min() : std::numeric_limits<tu_int64>::max();
+    tu_int64 result = identity;
+    bool found = false;
+
+#if defined(__AVX2__)
+    const __m256i fill = _mm256_set1_epi64x(identity);
+    __m256i acc = fill;
+#endif
+
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        const tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        if (mask == 0)
+            continue;
+        found = true;
+        const tu_int64 *block = span.values + start;
+        tu_int64 i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4) {
+            auto values = _mm256_castpd_si256(_mm256_blendv_pd(
+                _mm256_castsi256_pd(fill),
+                _mm256_loadu_pd(reinterpret_cast<const double *>(block + i)),
+                lane_mask(mask >> i)));
+            auto replace = IsMax? _mm256_cmpgt_epi64(values, acc) : _mm256_cmpgt_epi64(acc, values);
+            acc = _mm256_blendv_epi8(acc, values, replace);
+        }
+#endif
+        for (; i < n; i++) {
+            if (!((mask >> i) & 1))
+                continue;
+            if (IsMax? block[i] > result : block[i] < result) {
+                result = block[i];
+            }
+        }
+    }
+
+    if (!found)
+        return {};
+
+#if defined(__AVX2__)
+    alignas(32) tu_int64 lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    for (auto lane : lanes) {
+        result = IsMax? std::max(result, lane) : std::min(result, lane);
+    }
+#endif
+    return Option<tu_int64>(result);
+}
+
+Option<tu_int64>
+groove_math::minimum_kernel(const Int64Span &span)
+{
+    return int64_extremum_kernel<false>(span);
+}
+
+Option<tu_int64>
+groove_math::maximum_kernel(const Int64Span &span)
+{
+    return int64_extremum_kernel<true>(span);
+}
+
+groove_math::Int64Summary
+groove_math::summary_kernel(const Int64Span &span)
+{
+    // each of the int64 kernels is vectorized on its own, so the span is read once per kernel
+    // while it is still in cache rather than in a single scalar pass
+    Int64Summary summary;
+    summary.count = count_kernel(span);
+    if (summary.count == 0)
+        return summary;
+    summary.sum = sum_kernel(span);
+    summary.min = minimum_kernel(span).getValue();
+    summary.max = maximum_kernel(span).getValue();
+    return summary;
+}
+
+void
+groove_math::append_valid_values(const ValueSpan &span, std::vector<double> &values)
+{
+    for (tu_int64 start = 0; start < span.length; start += kBlockSize) {
+        const tu_int64 n = std::min(kBlockSize, span.length - start);
+        tu_uint64 mask = valid_mask(span.fidelity, start, n);
+        const double *block = span.values + start;
+        if (mask == low_bits(n)) {
+            values.insert(values.end(), block, block + n);
+            continue;
+        }
+        // visit only the set bits of the mask
+        while (mask != 0) {
+            values.push_back(block[std::countr_zero(mask)]);
+            mask &= mask - 1;
+        }
+    }
+}
+
+groove_math::ValueSpan
+groove_math::widen_span(const Int64Span &span, std::vector<double> &buffer)
+{
+    buffer.assign(span.values, span.values + span.length);
+    return ValueSpan{buffer.data(), span.length, span.fidelity};
+}
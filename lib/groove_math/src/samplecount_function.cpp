@@ -1,15 +1,40 @@
 
 #include <groove_math/samplecount_function.h>
 
-groove_math::SampleCountFunction::SampleCountFunction()
-    : m_count(0.0)
+groove_math::SampleCountFunction::State
+groove_math::SampleCountFunction::init()
 {
+    return 0;
 }
 
-groove_math::MathStatus
-groove_math::SampleCountFunction::apply(double &output, const double &input)
+void
+groove_math::SampleCountFunction::accumulate(State &state, double input)
 {
-    m_count++;
-    output = m_count;
-    return MathStatus::ok();
-}
\ No newline at end of file
+    state++;
+}
+
+void
+groove_math::SampleCountFunction::accumulate(State &state, const ValueSpan &span)
+{
+    state += count_kernel(span);
+}
+
+void
+groove_math::SampleCountFunction::merge(State &state, const State &other)
+{
+    state += other;
+}
+
+Option<double>
+groove_math::SampleCountFunction::finalize(const State &state)
+{
+    if (state == 0)
+        return {};
+    return Option<double>(static_cast<double>(state));
+}
+
+groove_math::SampleCountFunction::State
+groove_math::SampleCountFunction::fromSummary(const ValueSummary &summary)
+{
+    return summary.count;
+}
@@ -0,0 +1,36 @@
+
+#include <cmath>
+
+#include <groove_math/stddev_function.h>
+
+groove_math::StdDevFunction::State
+groove_math::StdDevFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::StdDevFunction::accumulate(State &state, double input)
+{
+    state.add(input);
+}
+
+void
+groove_math::StdDevFunction::accumulate(State &state, const ValueSpan &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::StdDevFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+Option<double>
+groove_math::StdDevFunction::finalize(const State &state)
+{
+    if (state.count == 0)
+        return {};
+    return Option<double>(std::sqrt(state.m2 / state.count));
+}
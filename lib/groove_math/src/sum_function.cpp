@@ -1,15 +1,45 @@
 
 #include <groove_math/sum_function.h>
 
-groove_math::SumFunction::SumFunction()
-    : m_sum(0.0)
+groove_math::SumFunction::State
+groove_math::SumFunction::init()
 {
+    return State();
 }
 
-groove_math::MathStatus
-groove_math::SumFunction::apply(double &output, const double &input)
+void
+groove_math::SumFunction::accumulate(State &state, double input)
 {
-    m_sum += input;
-    output = m_sum;
-    return MathStatus::ok();
-}
\ No newline at end of file
+    state.add(input);
+}
+
+void
+groove_math::SumFunction::accumulate(State &state, const ValueSpan &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::SumFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+Option<double>
+groove_math::SumFunction::finalize(const State &state)
+{
+    if (state.count == 0)
+        return {};
+    return Option<double>(state.sum.value());
+}
+
+groove_math::SumFunction::State
+groove_math::SumFunction::fromSummary(const ValueSummary &summary)
+{
+    State state;
+    if (summary.count > 0) {
+        state.sum.add(summary.sum);
+        state.count = summary.count;
+    }
+    return state;
+}
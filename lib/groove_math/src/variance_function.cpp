@@ -0,0 +1,35 @@
+
+#include <groove_math/variance_function.h>
+
+groove_math::VarianceFunction::State
+groove_math::VarianceFunction::init()
+{
+    return State();
+}
+
+void
+groove_math::VarianceFunction::accumulate(State &state, double input)
+{
+    state.add(input);
+}
+
+void
+groove_math::VarianceFunction::accumulate(State &state, const ValueSpan &span)
+{
+    state.add(span);
+}
+
+void
+groove_math::VarianceFunction::merge(State &state, const State &other)
+{
+    state.merge(other);
+}
+
+// the population variance of the valid values, ie the squared deviation is divided by the count
+Option<double>
+groove_math::VarianceFunction::finalize(const State &state)
+{
+    if (state.count == 0)
+        return {};
+    return Option<double>(state.m2 / state.count);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <groove_math/histogram.h>
+
+TEST(Histogram, EquiWidthSpanMatchesScalarAdd)
+{
+    std::vector<double> values;
+    for (int i = 0; i < 150; i++) {
+        values.push_back(i * 0.25 - 5.0);
+    }
+    values[7] = NAN;
+    values[8] = INFINITY;
+    values[9] = -INFINITY;
+
+    // only even rows are valid
+    std::vector<tu_int8> codes(values.size());
+    for (size_t i = 0; i < codes.size(); i++) {
+        codes[i] = static_cast<tu_int8>(i % 2 == 0?
+            groove_data::DatumFidelity::FIDELITY_VALID : groove_data::DatumFidelity::FIDELITY_MISSING);
+    }
+    groove_data::FidelitySpan fidelity;
+    fidelity.codes = codes.data();
+    fidelity.allValid = false;
+
+    auto spanHistogram = groove_math::Histogram::equiWidth(-2.0, 3.0, 8);
+    spanHistogram.add(groove_math::ValueSpan{values.data(), static_cast<tu_int64>(values.size()), fidelity});
+
+    auto scalarHistogram = groove_math::Histogram::equiWidth(-2.0, 3.0, 8);
+    for (size_t i = 0; i < values.size(); i += 2) {
+        scalarHistogram.add(values[i]);
+    }
+
+    ASSERT_EQ (scalarHistogram.getUnderflow(), spanHistogram.getUnderflow());
+    ASSERT_EQ (scalarHistogram.getOverflow(), spanHistogram.getOverflow());
+    for (int bin = 0; bin < 8; bin++) {
+        ASSERT_EQ (scalarHistogram.getCount(bin), spanHistogram.getCount(bin));
+    }
+    // the NaN row is missing, so all 75 valid rows are counted
+    ASSERT_EQ (75, spanHistogram.getTotal());
+    // the bin starting at 1.0 holds 1.0 through 3.75, of which 1.0, 1.5, ... 3.5 are valid
+    ASSERT_DOUBLE_EQ (1.0, spanHistogram.binStart(1));
+    ASSERT_EQ (6, spanHistogram.getCount(1));
+}
+
+TEST(Histogram, ExplicitBoundaries)
+{
+    auto histogram = groove_math::Histogram::withBoundaries({0.0, 1.0, 10.0, 100.0});
+    ASSERT_EQ (3, histogram.numBins());
+    ASSERT_FALSE (histogram.isEquiWidth());
+
+    std::vector<double> values = {-1.0, 0.0, 0.5, 1.0, 9.99, 10.0, 99.0, 100.0, NAN};
+    histogram.add(groove_math::ValueSpan{values.data(), static_cast<tu_int64>(values.size()), {}});
+
+    ASSERT_EQ (1, histogram.getUnderflow());
+    ASSERT_EQ (2, histogram.getCount(0));
+    ASSERT_EQ (2, histogram.getCount(1));
+    ASSERT_EQ (2, histogram.getCount(2));
+    ASSERT_EQ (1, histogram.getOverflow());
+    ASSERT_DOUBLE_EQ (10.0, histogram.binEnd(1));
+}
+
+TEST(Histogram, MergedCountsMatchSerialCounts)
+{
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(std::sin(i) * 10.0);
+    }
+
+    auto serial = groove_math::Histogram::equiWidth(-10.0, 1.0, 20);
+    serial.add(groove_math::ValueSpan{values.data(), 1000, {}});
+
+    auto first = groove_math::Histogram::equiWidth(-10.0, 1.0, 20);
+    auto second = groove_math::Histogram::equiWidth(-10.0, 1.0, 20);
+    first.add(groove_math::ValueSpan{values.data(), 333, {}});
+    second.add(groove_math::ValueSpan{values.data() + 333, 667, {}});
+    second.merge(first);
+
+    ASSERT_TRUE (serial.hasSameBins(second));
+    ASSERT_EQ (1000, second.getTotal());
+    for (int bin = 0; bin < 20; bin++) {
+        ASSERT_EQ (serial.getCount(bin), second.getCount(bin));
+    }
+    ASSERT_FALSE (serial.hasSameBins(groove_math::Histogram::equiWidth(-10.0, 1.0, 10)));
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <absl/strings/str_cat.h>
+#include <arrow/table.h>
+#include <arrow/array/builder_binary.h>
+#include <arrow/array/builder_primitive.h>
+
+#include <groove_data/int64_string_vector.h>
+#include <groove_math/hyperloglog.h>
+#include <groove_math/reducer_traits.h>
+#include <groove_math/reducer_template.h>
+
+TEST(HyperLogLog, EstimatesDistinctCount)
+{
+    groove_math::HyperLogLog sketch;
+    ASSERT_TRUE (sketch.isEmpty());
+    ASSERT_DOUBLE_EQ (0.0, sketch.estimate());
+
+    // every value is added twice, duplicates must not change the estimate
+    for (tu_int64 i = 0; i < 100000; i++) {
+        sketch.add(i);
+        sketch.add(i);
+    }
+    ASSERT_NEAR (100000.0, sketch.estimate(), 3000.0);
+
+    groove_math::HyperLogLog small;
+    for (tu_int64 i = 0; i < 10; i++) {
+        small.add(i);
+    }
+    ASSERT_NEAR (10.0, small.estimate(), 0.5);
+}
+
+TEST(HyperLogLog, MergesOverlappingSketches)
+{
+    groove_math::HyperLogLog first;
+    groove_math::HyperLogLog second(10);
+    for (int i = 0; i < 60000; i++) {
+        first.add(absl::StrCat("host-", i));
+    }
+    for (int i = 40000; i < 100000; i++) {
+        second.add(absl::StrCat("host-", i));
+    }
+
+    // merging with a lower precision sketch folds the registers down to that precision
+    first.merge(second);
+    ASSERT_EQ (10, first.getPrecision());
+    ASSERT_NEAR (100000.0, first.estimate(), 10000.0);
+}
+
+TEST(HyperLogLog, RoundTripsThroughBytes)
+{
+    groove_math::HyperLogLog sketch(12);
+    for (int i = 0; i < 5000; i++) {
+        sketch.add(i * 0.25);
+    }
+
+    auto fromBytesResult = groove_math::HyperLogLog::fromBytes(sketch.toBytes());
+    ASSERT_TRUE (fromBytesResult.isResult());
+    auto parsed = fromBytesResult.getResult();
+    ASSERT_EQ (12, parsed.getPrecision());
+    ASSERT_DOUBLE_EQ (sketch.estimate(), parsed.estimate());
+
+    auto bytes = sketch.toBytes();
+    ASSERT_TRUE (groove_math::HyperLogLog::fromBytes(bytes.substr(0, bytes.size() - 1)).isStatus());
+}
+
+TEST(HyperLogLog, AddsValidValuesOfStringVector)
+{
+    arrow::Int64Builder keyBuilder;
+    ASSERT_TRUE (keyBuilder.AppendValues({1, 2, 3, 4, 5}).ok());
+    arrow::StringBuilder valBuilder;
+    ASSERT_TRUE (valBuilder.AppendValues({"a", "b", "a"}).ok());
+    ASSERT_TRUE (valBuilder.AppendNull().ok());
+    ASSERT_TRUE (valBuilder.Append("c").ok());
+    arrow::BooleanBuilder fidBuilder;
+    ASSERT_TRUE (fidBuilder.AppendNulls(5).ok());
+
+    auto schema = arrow::schema({
+        arrow::field("", arrow::int64()),
+        arrow::field("val", arrow::utf8()),
+        arrow::field("", arrow::boolean()),
+    });
+    auto table = arrow::Table::Make(schema, {
+        *keyBuilder.Finish(),
+        *valBuilder.Finish(),
+        *fidBuilder.Finish(),
+    });
+    auto vector = groove_data::Int64StringVector::create(table, 0, 1, 2);
+
+    groove_math::Reducer<groove_math::DistinctCount> reducer(0.0);
+    auto state = reducer.init();
+    groove_math::DistinctCountFunction::accumulate(state, vector->getView());
+    ASSERT_NEAR (3.0, reducer.finalize(state), 0.1);
+}
+
+TEST(DistinctCountFunction, ReduceSpans)
+{
+    std::vector<double> values = {1.0, 2.0, 2.0, -0.0, 0.0, 1.0};
+    std::vector<groove_math::ValueSpan> spans = {
+        {values.data(), static_cast<tu_int64>(values.size()), {}},
+    };
+
+    groove_math::Reducer<groove_math::DistinctCount> reducer(0.0);
+    auto result = reducer.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_NEAR (3.0, result.getResult(), 0.1);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include <groove_iterator/range_iterator_template.h>
+#include <groove_math/reduce_kernels.h>
+#include <groove_math/reducer_template.h>
+#include <groove_math/reducer_traits.h>
+
+static std::shared_ptr<Iterator<tu_int64>>
+make_input(std::initializer_list<tu_int64> values)
+{
+    auto range = std::make_shared<std::vector<tu_int64>>(values);
+    return std::make_shared<groove_iterator::RangeIterator<std::vector<tu_int64>>>(
+        range, range->cbegin(), range->cend());
+}
+
+TEST(Int64Reducer, SumIsExactBeyondDoublePrecision)
+{
+    // 2^53 + 1 is not representable as a double, so a double sum would lose the final 1
+    const tu_int64 large = tu_int64(1) << 53;
+    std::vector<tu_int64> values(150, 1);
+    values[0] = large;
+    std::vector<groove_math::Int64Span> spans = {
+        {values.data(), 70, {}},
+        {values.data() + 70, 80, {}},
+    };
+
+    groove_math::Reducer<groove_math::Sum, tu_int64> reducer(0);
+    auto result = reducer.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_EQ (large + 149, result.getResult());
+
+    result = reducer.reduce(make_input({large, 1, 1}));
+    ASSERT_TRUE (result.isResult());
+    ASSERT_EQ (large + 2, result.getResult());
+}
+
+TEST(Int64Reducer, SumOverflowIsReported)
+{
+    const tu_int64 max = std::numeric_limits<tu_int64>::max();
+    std::vector<tu_int64> values = {max, max, max, -max, -max};
+    std::vector<groove_math::Int64Span> spans = {
+        {values.data(), static_cast<tu_int64>(values.size()), {}},
+    };
+
+    // the intermediate sums overflow but the total does not
+    groove_math::Reducer<groove_math::Sum, tu_int64> reducer(0);
+    auto result = reducer.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_EQ (max, result.getResult());
+
+    values.push_back(1);
+    spans[0].length++;
+    result = reducer.reduce(spans);
+    ASSERT_TRUE (result.isStatus());
+    ASSERT_TRUE (result.getStatus().matchesCondition(groove_math::MathCondition::kMathOverflow));
+}
+
+TEST(Int64Reducer, MaskedMinimumMaximumAndCount)
+{
+    std::vector<tu_int64> values;
+    for (int i = 0; i < 150; i++) {
+        values.push_back(i % 2 == 0? -tu_int64(i) * 1000000000000 : tu_int64(i) * 1000000000000);
+    }
+
+    // only rows which are multiples of three are valid
+    std::vector<tu_uint8> validity(32, 0);
+    const tu_int64 bitOffset = 6;
+    for (int i = 0; i < 150; i += 3) {
+        validity[(bitOffset + i) / 8] |= 1 << ((bitOffset + i) % 8);
+    }
+    groove_data::FidelitySpan fidelity;
+    fidelity.validity = validity.data();
+    fidelity.bitOffset = bitOffset;
+    fidelity.allValid = false;
+    std::vector<groove_math::Int64Span> spans = {
+        {values.data(), static_cast<tu_int64>(values.size()), fidelity},
+    };
+
+    groove_math::Reducer<groove_math::Minimum, tu_int64> minimum(0);
+    ASSERT_EQ (-tu_int64(144) * 1000000000000, minimum.reduce(spans).getResult());
+    groove_math::Reducer<groove_math::Maximum, tu_int64> maximum(0);
+    ASSERT_EQ (tu_int64(147) * 1000000000000, maximum.reduce(spans).getResult());
+    groove_math::Reducer<groove_math::SampleCount, tu_int64> count(0);
+    ASSERT_EQ (50, count.reduce(spans).getResult());
+
+    // a reduction over no valid values yields the identity
+    ASSERT_EQ (-1, groove_math::Reducer<groove_math::Maximum, tu_int64>(-1).reduce(
+        std::vector<groove_math::Int64Span>{}).getResult());
+}
+
+TEST(Int64Reducer, AverageIsRoundedOnce)
+{
+    // a double sum would absorb each 1 into 2^53, giving an average of exactly 2^53 / 4
+    const tu_int64 large = tu_int64(1) << 53;
+    std::vector<tu_int64> values = {large, 1, 1, 2};
+    std::vector<groove_math::Int64Span> spans = {
+        {values.data(), 2, {}},
+        {values.data() + 2, 2, {}},
+    };
+
+    groove_math::Reducer<groove_math::Average, tu_int64> reducer(0.0);
+    auto result = reducer.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ ((static_cast<double>(large) + 4.0) / 4.0, result.getResult());
+
+    ASSERT_EQ (-1.0, groove_math::Reducer<groove_math::Average, tu_int64>(-1.0).reduce(
+        std::vector<groove_math::Int64Span>{}).getResult());
+}
+
+TEST(Int64Reducer, DistinctCountHashesIntegers)
+{
+    // 2^53 and 2^53 + 1 widen to the same double, but are distinct int64 values
+    const tu_int64 large = tu_int64(1) << 53;
+    std::vector<tu_int64> values = {large, large + 1, large, 7, large + 1};
+    std::vector<groove_math::Int64Span> spans = {
+        {values.data(), 3, {}},
+        {values.data() + 3, 2, {}},
+    };
+
+    groove_math::Reducer<groove_math::DistinctCount, tu_int64> reducer(0.0);
+    auto result = reducer.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_NEAR (3.0, result.getResult(), 0.1);
+
+    ASSERT_EQ (-1.0, groove_math::Reducer<groove_math::DistinctCount, tu_int64>(-1.0).reduce(
+        std::vector<groove_math::Int64Span>{}).getResult());
+}
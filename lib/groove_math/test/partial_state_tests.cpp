@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <groove_iterator/range_iterator_template.h>
+#include <groove_math/partial_state.h>
+#include <groove_math/reducer_traits.h>
+#include <groove_math/reducer_template.h>
+
+static std::shared_ptr<Iterator<double>>
+make_input(std::initializer_list<double> values)
+{
+    auto range = std::make_shared<std::vector<double>>(values);
+    return std::make_shared<groove_iterator::RangeIterator<std::vector<double>>>(
+        range, range->cbegin(), range->cend());
+}
+
+TEST(PartialState, CompensatedSumKeepsSmallAddends)
+{
+    groove_math::CompensatedSum sum;
+    sum.add(1e16);
+    sum.add(1.0);
+    sum.add(-1e16);
+    ASSERT_DOUBLE_EQ (1.0, sum.value());
+}
+
+TEST(PartialState, MergedStatesMatchSerialReduction)
+{
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(0.1 * i + 1e8);
+    }
+
+    groove_math::Reducer<groove_math::Variance> reducer(0.0);
+
+    std::vector<groove_math::ValueSpan> spans = {
+        {values.data(), static_cast<tu_int64>(values.size()), {}},
+    };
+    auto serial = reducer.reduce(spans).getResult();
+
+    // accumulate three uneven partitions independently, then merge them out of order
+    auto first = reducer.init();
+    auto second = reducer.init();
+    auto third = reducer.init();
+    reducer.accumulate(first, std::vector<groove_math::ValueSpan>{{values.data(), 10, {}}});
+    reducer.accumulate(second, std::vector<groove_math::ValueSpan>{{values.data() + 10, 700, {}}});
+    reducer.accumulate(third, std::vector<groove_math::ValueSpan>{{values.data() + 710, 290, {}}});
+    reducer.merge(third, first);
+    reducer.merge(third, second);
+    auto merged = reducer.finalize(third);
+
+    ASSERT_NEAR (serial, merged, 1e-9 * serial);
+    // the population variance of 0.1 * i for i in [0, 1000) is 0.01 * (1000^2 - 1) / 12
+    ASSERT_NEAR (0.01 * (1000.0 * 1000.0 - 1.0) / 12.0, merged, 1e-6);
+}
+
+TEST(PartialState, EmptyStateFinalizesToIdentity)
+{
+    groove_math::Reducer<groove_math::Average> reducer(-1.0);
+    auto state = reducer.init();
+    reducer.merge(state, reducer.init());
+    ASSERT_DOUBLE_EQ (-1.0, reducer.finalize(state));
+}
+
+TEST(VarianceFunction, Reduce)
+{
+    groove_math::Reducer<groove_math::Variance> reducer(0.0);
+    auto result = reducer.reduce(make_input({1.0, 2.0, 1.0, 2.0}));
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ (0.25, result.getResult());
+}
+
+TEST(StdDevFunction, Reduce)
+{
+    groove_math::Reducer<groove_math::StdDev> reducer(0.0);
+    auto result = reducer.reduce(make_input({2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}));
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ (2.0, result.getResult());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <groove_iterator/range_iterator_template.h>
+#include <groove_math/quantile_sketch.h>
+#include <groove_math/reducer_traits.h>
+#include <groove_math/reducer_template.h>
+
+TEST(QuantileSketch, ExactForFewValues)
+{
+    groove_math::QuantileSketch sketch;
+    for (auto value : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+        sketch.add(value);
+    }
+    ASSERT_EQ (5, sketch.getCount());
+    ASSERT_DOUBLE_EQ (1.0, sketch.quantile(0.0).getValue());
+    ASSERT_DOUBLE_EQ (3.0, sketch.quantile(0.5).getValue());
+    ASSERT_DOUBLE_EQ (5.0, sketch.quantile(1.0).getValue());
+    ASSERT_TRUE (groove_math::QuantileSketch().quantile(0.5).isEmpty());
+}
+
+TEST(QuantileSketch, MergedSketchesApproximateQuantiles)
+{
+    std::vector<double> values;
+    for (int i = 0; i < 100000; i++) {
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+    // fill four sketches from interleaved slices of the values, then merge them
+    std::vector<groove_math::QuantileSketch> sketches(4);
+    for (size_t i = 0; i < values.size(); i++) {
+        sketches[i % sketches.size()].add(values[i]);
+    }
+    groove_math::QuantileSketch merged;
+    for (const auto &sketch : sketches) {
+        merged.merge(sketch);
+    }
+
+    ASSERT_EQ (100000, merged.getCount());
+    ASSERT_NEAR (50000.0, merged.quantile(0.5).getValue(), 500.0);
+    ASSERT_NEAR (95000.0, merged.quantile(0.95).getValue(), 300.0);
+    ASSERT_NEAR (99000.0, merged.quantile(0.99).getValue(), 150.0);
+    ASSERT_NEAR (99900.0, merged.quantile(0.999).getValue(), 50.0);
+}
+
+TEST(QuantileSketch, RoundTripsThroughBytes)
+{
+    groove_math::QuantileSketch sketch(50.0);
+    for (int i = 0; i < 10000; i++) {
+        sketch.add(i * 0.5);
+    }
+
+    auto fromBytesResult = groove_math::QuantileSketch::fromBytes(sketch.toBytes());
+    ASSERT_TRUE (fromBytesResult.isResult());
+    auto parsed = fromBytesResult.getResult();
+    ASSERT_EQ (sketch.getCount(), parsed.getCount());
+    ASSERT_DOUBLE_EQ (sketch.getCompression(), parsed.getCompression());
+    for (auto q : {0.0, 0.25, 0.5, 0.9, 0.99, 1.0}) {
+        ASSERT_DOUBLE_EQ (sketch.quantile(q).getValue(), parsed.quantile(q).getValue());
+    }
+
+    auto bytes = sketch.toBytes();
+    ASSERT_TRUE (groove_math::QuantileSketch::fromBytes(bytes.substr(0, bytes.size() - 1)).isStatus());
+}
+
+TEST(QuantileFunction, ReduceMasksInvalidValues)
+{
+    std::vector<double> values = {1.0, 100.0, 2.0, 3.0};
+    std::vector<tu_int8> codes = {
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_MISSING),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID),
+    };
+    groove_data::FidelitySpan fidelity;
+    fidelity.codes = codes.data();
+    fidelity.allValid = false;
+    std::vector<groove_math::ValueSpan> spans = {
+        {values.data(), static_cast<tu_int64>(values.size()), fidelity},
+    };
+
+    groove_math::Reducer<groove_math::Median> median(0.0);
+    auto result = median.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ (2.0, result.getResult());
+
+    groove_math::Reducer<groove_math::Quantile<100>> maximum(0.0);
+    result = maximum.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ (3.0, result.getResult());
+}
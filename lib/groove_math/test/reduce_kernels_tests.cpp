@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <groove_math/reduce_kernels.h>
+#include <groove_math/reducer_template.h>
+#include <groove_math/reducer_traits.h>
+
+// 150 values crosses two block boundaries and leaves a partial block at the end
+static std::vector<double>
+make_values(int count)
+{
+    std::vector<double> values;
+    for (int i = 0; i < count; i++) {
+        values.push_back(i + 1.0);
+    }
+    return values;
+}
+
+TEST(ReduceKernels, AllValid)
+{
+    auto values = make_values(150);
+    groove_math::ValueSpan span{values.data(), static_cast<tu_int64>(values.size()), {}};
+
+    ASSERT_DOUBLE_EQ (150.0 * 151.0 / 2.0, groove_math::sum_kernel(span));
+    ASSERT_EQ (150, groove_math::count_kernel(span));
+    ASSERT_DOUBLE_EQ (1.0, groove_math::minimum_kernel(span).getValue());
+    ASSERT_DOUBLE_EQ (150.0, groove_math::maximum_kernel(span).getValue());
+}
+
+TEST(ReduceKernels, MaskedByValidityBitmap)
+{
+    auto values = make_values(150);
+
+    // only odd rows are valid, and the bitmap starts at a bit offset which is not byte aligned
+    std::vector<tu_uint8> validity(32, 0);
+    const tu_int64 bitOffset = 3;
+    double expectedSum = 0.0;
+    for (int i = 0; i < 150; i++) {
+        if (i % 2 == 1) {
+            validity[(bitOffset + i) / 8] |= 1 << ((bitOffset + i) % 8);
+            expectedSum += values[i];
+        }
+    }
+    groove_data::FidelitySpan fidelity;
+    fidelity.validity = validity.data();
+    fidelity.bitOffset = bitOffset;
+    fidelity.allValid = false;
+    groove_math::ValueSpan span{values.data(), static_cast<tu_int64>(values.size()), fidelity};
+
+    ASSERT_DOUBLE_EQ (expectedSum, groove_math::sum_kernel(span));
+    ASSERT_EQ (75, groove_math::count_kernel(span));
+    ASSERT_DOUBLE_EQ (2.0, groove_math::minimum_kernel(span).getValue());
+    ASSERT_DOUBLE_EQ (150.0, groove_math::maximum_kernel(span).getValue());
+}
+
+TEST(ReduceKernels, MaskedByFidelityCodes)
+{
+    std::vector<double> values = {100.0, 2.0, 3.0, NAN, -50.0};
+    std::vector<tu_int8> codes = {
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_APPROXIMATE),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_VALID),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_MISSING),
+        static_cast<tu_int8>(groove_data::DatumFidelity::FIDELITY_UNKNOWN),
+    };
+    groove_data::FidelitySpan fidelity;
+    fidelity.codes = codes.data();
+    fidelity.allValid = false;
+    groove_math::ValueSpan span{values.data(), static_cast<tu_int64>(values.size()), fidelity};
+
+    ASSERT_DOUBLE_EQ (5.0, groove_math::sum_kernel(span));
+    ASSERT_EQ (2, groove_math::count_kernel(span));
+    ASSERT_DOUBLE_EQ (2.0, groove_math::minimum_kernel(span).getValue());
+    ASSERT_DOUBLE_EQ (3.0, groove_math::maximum_kernel(span).getValue());
+}
+
+TEST(ReduceKernels, ReduceSpans)
+{
+    auto values = make_values(10);
+    std::vector<groove_math::ValueSpan> spans = {
+        {values.data(), 4, {}},
+        {values.data() + 4, 6, {}},
+    };
+
+    groove_math::Reducer<groove_math::Average> average(0.0);
+    auto result = average.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ (5.5, result.getResult());
+
+    // a reduction over no valid values yields the identity
+    groove_math::Reducer<groove_math::Minimum> minimum(-1.0);
+    result = minimum.reduce(std::vector<groove_math::ValueSpan>{});
+    ASSERT_TRUE (result.isResult());
+    ASSERT_DOUBLE_EQ (-1.0, result.getResult());
+}
+
+TEST(ReduceKernels, SummaryMatchesSeparateKernels)
+{
+    auto values = make_values(150);
+    values[20] = NAN;
+
+    // every third row is valid, starting from a bit offset which is not byte aligned
+    std::vector<tu_uint8> validity(32, 0);
+    const tu_int64 bitOffset = 5;
+    for (int i = 0; i < 150; i++) {
+        if (i % 3 == 2) {
+            validity[(bitOffset + i) / 8] |= 1 << ((bitOffset + i) % 8);
+        }
+    }
+    groove_data::FidelitySpan fidelity;
+    fidelity.validity = validity.data();
+    fidelity.bitOffset = bitOffset;
+    fidelity.allValid = false;
+    groove_math::ValueSpan span{values.data() + 1, 149, fidelity};
+
+    auto summary = groove_math::summary_kernel(span);
+    ASSERT_EQ (groove_math::count_kernel(span), summary.count);
+    ASSERT_DOUBLE_EQ (groove_math::sum_kernel(span), summary.sum);
+    ASSERT_DOUBLE_EQ (groove_math::minimum_kernel(span).getValue(), summary.min);
+    ASSERT_DOUBLE_EQ (groove_math::maximum_kernel(span).getValue(), summary.max);
+
+    // a span with no valid values yields an empty summary
+    auto empty = groove_math::summary_kernel(span.slice(0, 0));
+    ASSERT_EQ (0, empty.count);
+    ASSERT_DOUBLE_EQ (0.0, empty.sum);
+}
+
+TEST(ReduceKernels, FusedReduceMatchesSeparateReducers)
+{
+    auto values = make_values(150);
+    std::vector<groove_math::ValueSpan> spans = {
+        {values.data(), 37, {}},
+        {values.data() + 37, 113, {}},
+    };
+
+    using Fused = std::tuple<
+        groove_math::Sum,
+        groove_math::Minimum,
+        groove_math::Maximum,
+        groove_math::SampleCount,
+        groove_math::Variance>;
+    groove_math::Reducer<Fused> fused({0.0, 0.0, 0.0, 0.0, 0.0});
+    auto result = fused.reduce(spans);
+    ASSERT_TRUE (result.isResult());
+    auto outputs = result.getResult();
+
+    ASSERT_DOUBLE_EQ (groove_math::Reducer<groove_math::Sum>(0.0).reduce(spans).getResult(), outputs[0]);
+    ASSERT_DOUBLE_EQ (1.0, outputs[1]);
+    ASSERT_DOUBLE_EQ (150.0, outputs[2]);
+    ASSERT_DOUBLE_EQ (150.0, outputs[3]);
+    ASSERT_DOUBLE_EQ (groove_math::Reducer<groove_math::Variance>(0.0).reduce(spans).getResult(), outputs[4]);
+
+    // without Variance every reducer is derived from one summary of each span
+    using Summarized = std::tuple<groove_math::Sum, groove_math::Minimum, groove_math::Maximum>;
+    static_assert(groove_math::FusedFunction<
+        double, groove_math::Sum, groove_math::Minimum, groove_math::Maximum>::supportsSummaries());
+    groove_math::Reducer<Summarized> summarized({0.0, 0.0, 0.0});
+    auto summaryOutputs = summarized.reduce(spans).getResult();
+    ASSERT_DOUBLE_EQ (outputs[0], summaryOutputs[0]);
+    ASSERT_DOUBLE_EQ (1.0, summaryOutputs[1]);
+    ASSERT_DOUBLE_EQ (150.0, summaryOutputs[2]);
+
+    // each output falls back to its own identity
+    groove_math::Reducer<Fused> empty({-1.0, -2.0, -3.0, -4.0, -5.0});
+    outputs = empty.reduce(std::vector<groove_math::ValueSpan>{}).getResult();
+    ASSERT_DOUBLE_EQ (-2.0, outputs[1]);
+    ASSERT_DOUBLE_EQ (-5.0, outputs[4]);
+}
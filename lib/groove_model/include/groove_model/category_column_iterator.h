@@ -18,14 +18,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::CategoryDoubleDatum &datum) override;
+        int getNextBatch(groove_data::CategoryDoubleDatum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::CategoryDoubleVector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::CategoryDoubleVector> m_vector;
-        tu_int64 m_curr;
+        groove_data::CategoryDoubleDatumIterator m_iterator;
     };
 
     class CategoryInt64ColumnIterator : public Iterator<groove_data::CategoryInt64Datum> {
@@ -36,14 +36,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::CategoryInt64Datum &datum) override;
+        int getNextBatch(groove_data::CategoryInt64Datum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::CategoryInt64Vector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::CategoryInt64Vector> m_vector;
-        tu_int64 m_curr;
+        groove_data::CategoryInt64DatumIterator m_iterator;
     };
 
     class CategoryStringColumnIterator : public Iterator<groove_data::CategoryStringDatum> {
@@ -54,14 +54,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::CategoryStringDatum &datum) override;
+        int getNextBatch(groove_data::CategoryStringDatum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::CategoryStringVector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::CategoryStringVector> m_vector;
-        tu_int64 m_curr;
+        groove_data::CategoryStringDatumIterator m_iterator;
     };
 }
 
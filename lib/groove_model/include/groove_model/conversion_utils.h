@@ -2,13 +2,25 @@
 #define GROOVE_MODEL_CONVERSION_UTILS_H
 
 #include <string>
+#include <string_view>
 
+#include <groove_data/compact_category.h>
 #include <groove_data/data_types.h>
 #include <tempo_utils/integer_types.h>
 #include <tempo_utils/option_template.h>
 
 namespace groove_model {
 
+    /**
+     * The first byte of the key of a category page id. The tag is followed by the order-preserving
+     * encoding of CompactCategory, so the empty category encodes as the tag alone and is distinct
+     * from an absent key, which encodes as no bytes. Page ids written before the tag was
+     * introduced use the legacy encoding, in which each segment is a big-endian u32 length
+     * followed by the segment bytes; its first byte is the high byte of a segment length, and so
+     * is never the tag for a segment which fits in a page.
+     */
+    constexpr char kCategoryKeyTag = '\xff';
+
     std::string int64_to_bytes(tu_int64 src);
 
     std::string double_to_bytes(double src);
@@ -19,6 +31,16 @@ namespace groove_model {
 
     std::string key_to_bytes(const Option<groove_data::Category> key);
 
+    std::string key_to_bytes(const Option<groove_data::CompactCategory> key);
+
+    std::string legacy_key_to_bytes(const Option<groove_data::Category> key);
+
+    bool is_legacy_category_key(std::string_view keyBytes);
+
+    bool legacy_bytes_to_category(std::string_view keyBytes, groove_data::Category &key);
+
+    bool bytes_to_category(std::string_view keyBytes, groove_data::Category &key);
+
 };
 
 #endif // GROOVE_MODEL_CONVERSION_UTILS_H
\ No newline at end of file
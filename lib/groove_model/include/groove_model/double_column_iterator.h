@@ -18,14 +18,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::DoubleDoubleDatum &datum) override;
+        int getNextBatch(groove_data::DoubleDoubleDatum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::DoubleDoubleVector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::DoubleDoubleVector> m_vector;
-        tu_int64 m_curr;
+        groove_data::DoubleDoubleDatumIterator m_iterator;
     };
 
     class DoubleInt64ColumnIterator : public Iterator<groove_data::DoubleInt64Datum> {
@@ -36,14 +36,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::DoubleInt64Datum &datum) override;
+        int getNextBatch(groove_data::DoubleInt64Datum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::DoubleInt64Vector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::DoubleInt64Vector> m_vector;
-        tu_int64 m_curr;
+        groove_data::DoubleInt64DatumIterator m_iterator;
     };
 
     class DoubleStringColumnIterator : public Iterator<groove_data::DoubleStringDatum> {
@@ -54,14 +54,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::DoubleStringDatum &datum) override;
+        int getNextBatch(groove_data::DoubleStringDatum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::DoubleStringVector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::DoubleStringVector> m_vector;
-        tu_int64 m_curr;
+        groove_data::DoubleStringDatumIterator m_iterator;
     };
 }
 
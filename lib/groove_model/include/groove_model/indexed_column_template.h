@@ -1,14 +1,22 @@
 #ifndef GROOVE_MODEL_INDEXED_COLUMN_TEMPLATE_H
 #define GROOVE_MODEL_INDEXED_COLUMN_TEMPLATE_H
 
+#include <limits>
+#include <type_traits>
+
 #include <arrow/builder.h>
 
 #include <groove_data/base_vector.h>
+#include <groove_iterator/generator_template.h>
+#include <groove_math/bucket_reducer_template.h>
 
 #include "abstract_page_cache.h"
 #include "base_column.h"
 #include "model_result.h"
 #include "model_types.h"
+#include "page_read_ahead_template.h"
+#include "page_statistics.h"
+#include "partitioned_scan.h"
 
 namespace groove_model {
 
@@ -37,6 +45,292 @@ namespace groove_model {
         {
         };
 
+        /**
+         * Returns the id of the last page starting at or before the start of the range, or the
+         * first page if every page starts after the start of the range.
+         */
+        tempo_utils::Result<PageId>
+        getPageIdForRangeStart(const RangeType &range)
+        {
+            auto searchKey = PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
+                getDatasetUrl(), getModelId(), getColumnId(), range.start);
+            auto getPageIdResult = m_pageCache->getPageIdBefore(searchKey, false);
+            if (getPageIdResult.isResult())
+                return getPageIdResult;
+            auto status = getPageIdResult.getStatus();
+            if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                return status;
+            return m_pageCache->getPageIdAfter(searchKey, false);
+        }
+
+        /**
+         * Returns the id created for the end key of the range, or an empty option if the range
+         * has no end, see page_id_follows_range.
+         */
+        Option<PageId>
+        getPageIdForRangeEnd(const RangeType &range)
+        {
+            if (range.end.isEmpty())
+                return Option<PageId>();
+            return Option<PageId>(PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
+                getDatasetUrl(), getModelId(), getColumnId(), range.end));
+        }
+
+        /**
+         * Returns the first page which may contain rows in the range. A page whose statistics
+         * show that all of its keys precede the range is skipped without being decoded.
+         */
+        tempo_utils::Result<std::shared_ptr<IndexedPage<DefType>>>
+        getFirstPageInRange(const RangeType &range)
+        {
+            auto getPageIdResult = getPageIdForRangeStart(range);
+            while (getPageIdResult.isResult()) {
+                auto pageId = getPageIdResult.getResult();
+                auto getDataResult = m_pageCache->getPageData(pageId);
+                if (getDataResult.isStatus())
+                    return getDataResult.getStatus();
+                auto pageData = getDataResult.getResult();
+                if (!pageData || pageData->size() == 0)
+                    return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+
+                auto statisticsOption = IndexedPage<DefType>::readStatistics(pageData);
+                if (!statisticsOption.isEmpty()) {
+                    auto statistics = statisticsOption.getValue();
+                    if (statistics.numRows > 0 && key_precedes_range(statistics.maxKey, range)) {
+                        getPageIdResult = m_pageCache->getPageIdAfter(pageId, true);
+                        continue;
+                    }
+                }
+
+                auto page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+                if (page == nullptr)
+                    return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+                return page;
+            }
+            return getPageIdResult.getStatus();
+        }
+
+        /**
+         * Returns the page after pageId if it may contain rows in the range, otherwise returns
+         * kPageNotFound. The page is not read if its page id shows that it starts after the end
+         * of the range, and is not decoded if its statistics show that it does.
+         */
+        tempo_utils::Result<std::shared_ptr<IndexedPage<DefType>>>
+        getNextPageInRange(const PageId &pageId, const RangeType &range, const Option<PageId> &endPageId)
+        {
+            auto getPageIdResult = m_pageCache->getPageIdAfter(pageId, true);
+            if (getPageIdResult.isStatus())
+                return getPageIdResult.getStatus();
+            auto nextPageId = getPageIdResult.getResult();
+            if (page_id_follows_range(nextPageId, endPageId, range.end_exclusive))
+                return ModelStatus::forCondition(ModelCondition::kPageNotFound);
+
+            auto getDataResult = m_pageCache->getPageData(nextPageId);
+            if (getDataResult.isStatus())
+                return getDataResult.getStatus();
+            auto pageData = getDataResult.getResult();
+            if (!pageData || pageData->size() == 0)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+
+            auto statisticsOption = IndexedPage<DefType>::readStatistics(pageData);
+            if (!statisticsOption.isEmpty()) {
+                auto statistics = statisticsOption.getValue();
+                if (statistics.numRows > 0 && key_follows_range(statistics.minKey, range))
+                    return ModelStatus::forCondition(ModelCondition::kPageNotFound);
+            }
+
+            auto page = IndexedPage<DefType>::fromBuffer(nextPageId, pageData);
+            if (page == nullptr)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+            return page;
+        }
+
+        // the arguments are taken by value because they must outlive the call which starts the
+        // coroutine
+        static groove_iterator::Generator<std::shared_ptr<VectorType>>
+        generate_vectors(std::shared_ptr<IndexedColumn<DefType>> column, RangeType range)
+        {
+            auto getIndexedPageResult = column->getFirstPageInRange(range);
+            if (getIndexedPageResult.isStatus()) {
+                auto status = getIndexedPageResult.getStatus();
+                if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                    co_return status;
+                co_return ModelStatus::ok();
+            }
+            auto page = getIndexedPageResult.getResult();
+            auto endPageId = column->getPageIdForRangeEnd(range);
+
+            auto slice = page->getVector()->slice(range);
+            bool isEmpty = slice->isEmpty();
+            co_yield std::move(slice);
+
+            while (!isEmpty) {
+                getIndexedPageResult = column->getNextPageInRange(page->getPageId(), range, endPageId);
+                if (getIndexedPageResult.isStatus()) {
+                    auto status = getIndexedPageResult.getStatus();
+                    if (status.matchesCondition(ModelCondition::kPageNotFound))
+                        break;
+                    co_return status;
+                }
+                page = getIndexedPageResult.getResult();
+
+                slice = page->getVector()->slice(range);
+                if (slice->isEmpty())
+                    break;
+                co_yield std::move(slice);
+            }
+
+            co_return ModelStatus::ok();
+        }
+
+        static groove_iterator::Generator<std::shared_ptr<VectorType>>
+        generate_read_ahead_vectors(std::shared_ptr<PageReadAhead<DefType>> pages)
+        {
+            typename PageReadAhead<DefType>::Page page;
+            while (pages->getNext(page)) {
+                co_yield std::move(page.vector);
+            }
+            co_return pages->getStatus();
+        }
+
+        static groove_iterator::Generator<std::shared_ptr<VectorType>>
+        generate_status(tempo_utils::Status status)
+        {
+            co_return status;
+        }
+
+        /**
+         * Returns the statistics of the page, read from the page metadata if the page has them,
+         * otherwise computed by decoding the page.
+         */
+        tempo_utils::Result<PageStatistics<DefType>>
+        getPageStatistics(const PageId &pageId)
+        {
+            auto getDataResult = m_pageCache->getPageData(pageId);
+            if (getDataResult.isStatus())
+                return getDataResult.getStatus();
+            auto pageData = getDataResult.getResult();
+            if (!pageData || pageData->size() == 0)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+
+            auto statisticsOption = IndexedPage<DefType>::readStatistics(pageData);
+            if (!statisticsOption.isEmpty())
+                return statisticsOption.getValue();
+
+            auto page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+            if (page == nullptr)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+            return page->getStatistics();
+        }
+
+        /**
+         * Returns the ids of the pages whose first keys are used as the partition boundaries of
+         * the range, in key order and without duplicates. If the keys are numeric, then
+         * maxPartitions - 1 keys are interpolated between the first and the last key of the range
+         * and the page containing each key is found with a single seek, so the cost does not
+         * grow with the number of pages in the range. Other keys cannot be interpolated, so the
+         * page ids of the range are walked and every page at an even step is used.
+         */
+        tempo_utils::Result<std::vector<PageId>>
+        getBoundaryPageIds(const RangeType &range, int maxPartitions)
+        {
+            std::vector<PageId> boundaryPageIds;
+
+            auto getFirstPageIdResult = getPageIdForRangeStart(range);
+            if (getFirstPageIdResult.isStatus()) {
+                auto status = getFirstPageIdResult.getStatus();
+                if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                    return status;
+                return boundaryPageIds;
+            }
+            auto firstPageId = getFirstPageIdResult.getResult();
+            auto endPageId = getPageIdForRangeEnd(range);
+
+            if constexpr (std::is_arithmetic_v<KeyType>) {
+                // the last page which starts within the range
+                auto lastSearchKey = endPageId;
+                if (lastSearchKey.isEmpty()) {
+                    KeyType largest = std::numeric_limits<KeyType>::has_infinity?
+                        std::numeric_limits<KeyType>::infinity() : std::numeric_limits<KeyType>::max();
+                    lastSearchKey = Option<PageId>(PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
+                        getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(largest)));
+                }
+                auto getLastPageIdResult = m_pageCache->getPageIdBefore(
+                    lastSearchKey.getValue(), !endPageId.isEmpty() && range.end_exclusive);
+                if (getLastPageIdResult.isStatus()) {
+                    auto status = getLastPageIdResult.getStatus();
+                    if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                        return status;
+                    return boundaryPageIds;
+                }
+                auto lastPageId = getLastPageIdResult.getResult();
+                // a range within a single page is not partitioned
+                if (!(firstPageId < lastPageId))
+                    return boundaryPageIds;
+
+                auto getFirstStatisticsResult = getPageStatistics(firstPageId);
+                if (getFirstStatisticsResult.isStatus())
+                    return getFirstStatisticsResult.getStatus();
+                auto firstStatistics = getFirstStatisticsResult.getResult();
+                auto getLastStatisticsResult = getPageStatistics(lastPageId);
+                if (getLastStatisticsResult.isStatus())
+                    return getLastStatisticsResult.getStatus();
+                auto lastStatistics = getLastStatisticsResult.getResult();
+                if (firstStatistics.numRows == 0 || lastStatistics.numRows == 0)
+                    return boundaryPageIds;
+
+                KeyType lo = firstStatistics.minKey;
+                if (!range.start.isEmpty() && lo < range.start.getValue()) {
+                    lo = range.start.getValue();
+                }
+                KeyType hi = lastStatistics.maxKey;
+                if (!range.end.isEmpty() && range.end.getValue() < hi) {
+                    hi = range.end.getValue();
+                }
+                if (!(lo < hi))
+                    return boundaryPageIds;
+
+                for (int i = 1; i < maxPartitions; i++) {
+                    // interpolated in long double so the difference of int64 keys cannot overflow
+                    auto key = static_cast<KeyType>(static_cast<long double>(lo)
+                        + (static_cast<long double>(hi) - static_cast<long double>(lo)) * i / maxPartitions);
+                    auto searchKey = PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
+                        getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(key));
+                    auto getPageIdResult = m_pageCache->getPageIdBefore(searchKey, false);
+                    if (getPageIdResult.isStatus())
+                        return getPageIdResult.getStatus();
+                    auto pageId = getPageIdResult.getResult();
+                    // the first page starts the first partition, so it is never a boundary
+                    if (!(firstPageId < pageId))
+                        continue;
+                    if (boundaryPageIds.empty() || boundaryPageIds.back() < pageId) {
+                        boundaryPageIds.push_back(pageId);
+                    }
+                }
+            } else {
+                std::vector<PageId> pageIds;
+                auto getPageIdResult = getFirstPageIdResult;
+                while (getPageIdResult.isResult()) {
+                    auto pageId = getPageIdResult.getResult();
+                    if (page_id_follows_range(pageId, endPageId, range.end_exclusive))
+                        break;
+                    pageIds.push_back(pageId);
+                    getPageIdResult = m_pageCache->getPageIdAfter(pageId, true);
+                }
+                if (getPageIdResult.isStatus()) {
+                    auto status = getPageIdResult.getStatus();
+                    if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                        return status;
+                }
+                auto numPartitions = std::min<size_t>(maxPartitions, pageIds.size());
+                for (size_t i = 1; i < numPartitions; i++) {
+                    boundaryPageIds.push_back(pageIds[i * pageIds.size() / numPartitions]);
+                }
+            }
+
+            return boundaryPageIds;
+        }
+
     public:
 
         /**
@@ -92,10 +386,8 @@ namespace groove_model {
         {
             std::forward_list<std::shared_ptr<VectorType>> vectors;
             std::vector<PageId> pageIds;
-            Option<KeyType> key = range.start;
 
-            auto getIndexedPageResult = m_pageCache->template getIndexedPage<DefType>(
-                getDatasetUrl(), getModelId(), getColumnId(), key, false);
+            auto getIndexedPageResult = getFirstPageInRange(range);
             if (getIndexedPageResult.isStatus()) {
                 auto status = getIndexedPageResult.getStatus();
                 if (!status.matchesCondition(ModelCondition::kPageNotFound))
@@ -103,6 +395,7 @@ namespace groove_model {
                 return IteratorType();
             }
             auto page = getIndexedPageResult.getResult();
+            auto endPageId = getPageIdForRangeEnd(range);
 
             auto vector = page->getVector();
             auto slice = vector->slice(range);
@@ -110,11 +403,8 @@ namespace groove_model {
             pageIds.push_back(page->getPageId());
             auto last = vectors.begin();
 
-            auto largestOption = slice->getLargest();
-            while (!largestOption.isEmpty()) {
-                auto largest = largestOption.getValue();
-                getIndexedPageResult = m_pageCache->template getIndexedPage<DefType>(
-                    getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(largest.key), true);
+            while (!slice->isEmpty()) {
+                getIndexedPageResult = getNextPageInRange(page->getPageId(), range, endPageId);
                 if (getIndexedPageResult.isStatus()) {
                     auto status = getIndexedPageResult.getStatus();
                     if (status.matchesCondition(ModelCondition::kPageNotFound))
@@ -129,7 +419,6 @@ namespace groove_model {
                     break;
                 last = vectors.insert_after(last, slice);
                 pageIds.push_back(page->getPageId());
-                largestOption = slice->getLargest();
             }
 
             return IteratorType(vectors, pageIds);
@@ -144,10 +433,8 @@ namespace groove_model {
         getVectors(const RangeType &range)
         {
             std::vector<std::shared_ptr<VectorType>> vectors;
-            Option<KeyType> key = range.start;
 
-            auto getIndexedPageResult = m_pageCache->template getIndexedPage<DefType>(
-                getDatasetUrl(), getModelId(), getColumnId(), key, false);
+            auto getIndexedPageResult = getFirstPageInRange(range);
             if (getIndexedPageResult.isStatus()) {
                 auto status = getIndexedPageResult.getStatus();
                 if (!status.matchesCondition(ModelCondition::kPageNotFound))
@@ -155,16 +442,14 @@ namespace groove_model {
                 return vectors;
             }
             auto page = getIndexedPageResult.getResult();
+            auto endPageId = getPageIdForRangeEnd(range);
 
             auto vector = page->getVector();
             auto slice = vector->slice(range);
             vectors.push_back(slice);
 
-            auto largestOption = slice->getLargest();
-            while (!largestOption.isEmpty()) {
-                auto largest = largestOption.getValue();
-                getIndexedPageResult = m_pageCache->template getIndexedPage<DefType>(
-                    getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(largest.key), true);
+            while (!slice->isEmpty()) {
+                getIndexedPageResult = getNextPageInRange(page->getPageId(), range, endPageId);
                 if (getIndexedPageResult.isStatus()) {
                     auto status = getIndexedPageResult.getStatus();
                     if (status.matchesCondition(ModelCondition::kPageNotFound))
@@ -178,12 +463,74 @@ namespace groove_model {
                 if (slice->isEmpty())
                     break;
                 vectors.push_back(slice);
-                largestOption = slice->getLargest();
             }
 
             return vectors;
         }
 
+        /**
+         * Starts a scan of the pages in the range which fetches and decodes pages on a
+         * ScanExecutor ahead of the consumer, see PageReadAhead.
+         *
+         * @param range
+         * @param options
+         * @param summarize
+         * @return
+         */
+        tempo_utils::Result<std::shared_ptr<PageReadAhead<DefType>>>
+        readAhead(
+            const RangeType &range,
+            const ReadAheadOptions &options = {},
+            typename PageReadAhead<DefType>::SummarizeFunc summarize = {})
+        {
+            Option<PageId> firstPageId;
+            auto getPageIdResult = getPageIdForRangeStart(range);
+            if (getPageIdResult.isResult()) {
+                firstPageId = Option<PageId>(getPageIdResult.getResult());
+            } else {
+                auto status = getPageIdResult.getStatus();
+                if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                    return status;
+            }
+            return PageReadAhead<DefType>::create(
+                m_pageCache, firstPageId, getPageIdForRangeEnd(range), range, options, std::move(summarize));
+        }
+
+        /**
+         * Returns a generator which yields the vectors in the range like getVectors, but each
+         * page is only fetched and decoded when the consumer asks for the next vector, so a
+         * consumer which stops early does not read the rest of the range and at most one page is
+         * held at a time. The generator keeps the column alive, and its status is the reason
+         * reading a page failed.
+         *
+         * @param range
+         * @return
+         */
+        groove_iterator::Generator<std::shared_ptr<VectorType>>
+        generateVectors(const RangeType &range)
+        {
+            return generate_vectors(this->shared_from_this(), range);
+        }
+
+        /**
+         * Returns a generator which yields the vectors in the range like getVectors, but the
+         * pages are fetched and decoded by a PageReadAhead. Each vector is yielded as soon as
+         * its page has been read, so the consumer works on one page while the following pages
+         * are read, and at most the pages allowed by the options are held ahead of it.
+         *
+         * @param range
+         * @param options
+         * @return
+         */
+        groove_iterator::Generator<std::shared_ptr<VectorType>>
+        generateVectors(const RangeType &range, const ReadAheadOptions &options)
+        {
+            auto readAheadResult = readAhead(range, options);
+            if (readAheadResult.isStatus())
+                return generate_status(readAheadResult.getStatus());
+            return generate_read_ahead_vectors(readAheadResult.getResult());
+        }
+
         /**
          *
          * @param range
@@ -209,6 +556,330 @@ namespace groove_model {
             return frames;
         }
 
+        /**
+         * Computes the summary statistics of the rows in the range. Pages which lie entirely
+         * within the range are summarized from their stored statistics without being decoded,
+         * pages which lie entirely outside of the range are skipped, and only the pages which
+         * straddle a bound of the range (or which were written without statistics) are decoded.
+         *
+         * @param range
+         * @return
+         */
+        tempo_utils::Result<PageStatistics<DefType>>
+        summarize(const RangeType &range)
+        {
+            PageStatistics<DefType> summary;
+            auto endPageId = getPageIdForRangeEnd(range);
+
+            auto getPageIdResult = getPageIdForRangeStart(range);
+            while (getPageIdResult.isResult()) {
+                auto pageId = getPageIdResult.getResult();
+                if (page_id_follows_range(pageId, endPageId, range.end_exclusive))
+                    return summary;
+                getPageIdResult = m_pageCache->getPageIdAfter(pageId, true);
+
+                auto getDataResult = m_pageCache->getPageData(pageId);
+                if (getDataResult.isStatus())
+                    return getDataResult.getStatus();
+                auto pageData = getDataResult.getResult();
+                if (!pageData || pageData->size() == 0)
+                    return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+
+                std::shared_ptr<IndexedPage<DefType>> page;
+                PageStatistics<DefType> statistics;
+                auto statisticsOption = IndexedPage<DefType>::readStatistics(pageData);
+                if (!statisticsOption.isEmpty()) {
+                    statistics = statisticsOption.getValue();
+                } else {
+                    page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+                    if (page == nullptr)
+                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+                    statistics = page->getStatistics();
+                }
+
+                if (statistics.numRows == 0 || key_precedes_range(statistics.maxKey, range))
+                    continue;
+                if (key_follows_range(statistics.minKey, range))
+                    return summary;
+                if (!key_precedes_range(statistics.minKey, range) && !key_follows_range(statistics.maxKey, range)) {
+                    summary.merge(statistics);
+                    continue;
+                }
+
+                if (page == nullptr) {
+                    page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+                    if (page == nullptr)
+                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+                }
+                summary.merge(PageStatistics<DefType>::fromVector(*page->getVector()->slice(range)));
+            }
+
+            auto status = getPageIdResult.getStatus();
+            if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                return status;
+            return summary;
+        }
+
+        /**
+         * Reduces the values of the rows in the range into the key buckets of the reducer. Pages
+         * are read in key order by a PageReadAhead, so the pages after the current one are read
+         * while its rows are accumulated, and are skipped using their stored statistics wherever
+         * possible: pages outside of the range or without valid values are never decoded, and a
+         * page which lies inside the range and inside a single bucket is accumulated from its
+         * statistics when every reducer can be derived from a summary. All other pages are
+         * decoded and their rows accumulated a chunk at a time. The reducer is either a
+         * BucketReducer over the value type of the column or a BucketHistogram, and the values
+         * are either double or int64.
+         *
+         * @tparam BucketReducerType
+         * @param range
+         * @param reducer
+         * @param options
+         * @return
+         */
+        template<typename BucketReducerType>
+        tempo_utils::Status
+        reduceBuckets(const RangeType &range, BucketReducerType &reducer, const ReadAheadOptions &options = {})
+        {
+            // the spec is copied, since the function is called from the executor
+            auto spec = reducer.getSpec();
+            auto summarize = [spec](const PageStatistics<DefType> &statistics) -> bool {
+                if (statistics.numValid == 0)
+                    return true;
+                if constexpr (BucketReducerType::supportsSummaries()) {
+                    // NaN values are excluded from the bounds, so such pages are decoded
+                    return statistics.numNaN == 0
+                        && spec.bucketStart(statistics.minKey) == spec.bucketStart(statistics.maxKey);
+                }
+                return false;
+            };
+
+            auto readAheadResult = readAhead(range, options, summarize);
+            if (readAheadResult.isStatus())
+                return readAheadResult.getStatus();
+            auto pages = readAheadResult.getResult();
+
+            typename PageReadAhead<DefType>::Page page;
+            while (pages->getNext(page)) {
+                if (page.vector != nullptr) {
+                    reducer.accumulate(page.vector->getView());
+                    continue;
+                }
+                const auto &statistics = page.statistics;
+                if constexpr (BucketReducerType::supportsSummaries()) {
+                    if (statistics.numValid > 0) {
+                        // the summary of an int64 reducer carries the exact sum of the page
+                        typename BucketReducerType::SummaryType summary;
+                        summary.count = statistics.numValid;
+                        summary.sum = statistics.sum;
+                        summary.min = statistics.minValue;
+                        summary.max = statistics.maxValue;
+                        reducer.accumulateSummary(spec.bucketStart(statistics.minKey), summary);
+                    }
+                }
+            }
+            return pages->getStatus();
+        }
+
+        /**
+         * Splits the range into at most maxPartitions disjoint subranges which together cover
+         * the range, with each boundary at the first key of a page, so each page is read by a
+         * single partition. The boundary pages are found by seeking rather than by walking the
+         * pages of the range (see getBoundaryPageIds), and only their statistics are read. A
+         * range within a single page is returned as a single partition.
+         *
+         * @param range
+         * @param maxPartitions
+         * @return
+         */
+        tempo_utils::Result<std::vector<RangeType>>
+        partitionRange(const RangeType &range, int maxPartitions)
+        {
+            TU_ASSERT (maxPartitions > 0);
+
+            auto getBoundaryPageIdsResult = getBoundaryPageIds(range, maxPartitions);
+            if (getBoundaryPageIdsResult.isStatus())
+                return getBoundaryPageIdsResult.getStatus();
+
+            std::vector<RangeType> partitions;
+            RangeType partition = range;
+            for (const auto &pageId : getBoundaryPageIdsResult.getResult()) {
+                auto getStatisticsResult = getPageStatistics(pageId);
+                if (getStatisticsResult.isStatus())
+                    return getStatisticsResult.getStatus();
+                auto statistics = getStatisticsResult.getResult();
+                if (statistics.numRows == 0)
+                    continue;
+                auto boundary = statistics.minKey;
+                // every partition must be non-empty and lie within the range
+                if (key_precedes_range(boundary, partition) || key_follows_range(boundary, range))
+                    continue;
+                if (!partition.start.isEmpty() && !(partition.start.getValue() < boundary))
+                    continue;
+                partition.end = Option<KeyType>(boundary);
+                partition.end_exclusive = true;
+                partitions.push_back(partition);
+                partition.start = Option<KeyType>(boundary);
+                partition.start_exclusive = false;
+            }
+            partition.end = range.end;
+            partition.end_exclusive = range.end_exclusive;
+            partitions.push_back(partition);
+            return partitions;
+        }
+
+        /**
+         * Returns the vectors in the range like getVectors, reading the partitions of the range
+         * in parallel on up to numThreads threads and concatenating their vectors in key order.
+         *
+         * @param range
+         * @param numThreads
+         * @return
+         */
+        tempo_utils::Result<std::vector<std::shared_ptr<VectorType>>>
+        getVectorsPartitioned(const RangeType &range, int numThreads)
+        {
+            auto partitionRangeResult = partitionRange(range, numThreads * kPartitionsPerThread);
+            if (partitionRangeResult.isStatus())
+                return partitionRangeResult.getStatus();
+            auto partitions = partitionRangeResult.getResult();
+
+            std::vector<std::vector<std::shared_ptr<VectorType>>> partitionVectors(partitions.size());
+            auto status = run_partitioned(static_cast<int>(partitions.size()), numThreads, [&](int index) -> tempo_utils::Status {
+                auto getVectorsResult = getVectors(partitions[index]);
+                if (getVectorsResult.isStatus())
+                    return getVectorsResult.getStatus();
+                partitionVectors[index] = getVectorsResult.getResult();
+                return ModelStatus::ok();
+            });
+            if (status.notOk())
+                return status;
+
+            std::vector<std::shared_ptr<VectorType>> vectors;
+            for (auto &partition : partitionVectors) {
+                vectors.insert(vectors.end(), partition.cbegin(), partition.cend());
+            }
+            return vectors;
+        }
+
+        /**
+         * Computes the summary statistics of the rows in the range like summarize, summarizing
+         * the partitions of the range in parallel on up to numThreads threads.
+         *
+         * @param range
+         * @param numThreads
+         * @return
+         */
+        tempo_utils::Result<PageStatistics<DefType>>
+        summarizePartitioned(const RangeType &range, int numThreads)
+        {
+            auto partitionRangeResult = partitionRange(range, numThreads * kPartitionsPerThread);
+            if (partitionRangeResult.isStatus())
+                return partitionRangeResult.getStatus();
+            auto partitions = partitionRangeResult.getResult();
+
+            std::vector<PageStatistics<DefType>> partitionSummaries(partitions.size());
+            auto status = run_partitioned(static_cast<int>(partitions.size()), numThreads, [&](int index) -> tempo_utils::Status {
+                auto summarizeResult = summarize(partitions[index]);
+                if (summarizeResult.isStatus())
+                    return summarizeResult.getStatus();
+                partitionSummaries[index] = summarizeResult.getResult();
+                return ModelStatus::ok();
+            });
+            if (status.notOk())
+                return status;
+
+            PageStatistics<DefType> summary;
+            for (const auto &partitionSummary : partitionSummaries) {
+                summary.merge(partitionSummary);
+            }
+            return summary;
+        }
+
+        /**
+         * Reduces the values of the rows in the range like reduceBuckets, reducing the partitions
+         * of the range in parallel on up to numThreads threads. Each partition is reduced into an
+         * empty copy of the reducer, and the copies are merged into the reducer in key order, so
+         * the result does not depend on how the partitions were scheduled.
+         *
+         * @tparam BucketReducerType
+         * @param range
+         * @param reducer
+         * @param numThreads
+         * @return
+         */
+        template<typename BucketReducerType>
+        tempo_utils::Status
+        reduceBucketsPartitioned(const RangeType &range, BucketReducerType &reducer, int numThreads)
+        {
+            auto partitionRangeResult = partitionRange(range, numThreads * kPartitionsPerThread);
+            if (partitionRangeResult.isStatus())
+                return partitionRangeResult.getStatus();
+            auto partitions = partitionRangeResult.getResult();
+
+            std::vector<BucketReducerType> partitionReducers;
+            for (size_t i = 0; i < partitions.size(); i++) {
+                partitionReducers.push_back(reducer.emptyCopy());
+            }
+            auto status = run_partitioned(static_cast<int>(partitions.size()), numThreads, [&](int index) -> tempo_utils::Status {
+                return reduceBuckets(partitions[index], partitionReducers[index]);
+            });
+            if (status.notOk())
+                return status;
+
+            for (const auto &partitionReducer : partitionReducers) {
+                reducer.merge(partitionReducer);
+            }
+            return ModelStatus::ok();
+        }
+
+        /**
+         * Returns the partial state of FunctionType over the valid values in the range. The
+         * partitions of the range are reduced in parallel on up to numThreads threads, and their
+         * states are merged in key order. The pages of each partition are read ahead, see
+         * generateVectors. FunctionType must accumulate spans of ValueType, for example
+         * Int64SumFunction for an int64 column.
+         *
+         * @tparam FunctionType
+         * @param range
+         * @param numThreads
+         * @return
+         */
+        template<typename FunctionType,
+            typename StateType = typename FunctionType::State>
+        tempo_utils::Result<StateType>
+        reducePartitioned(const RangeType &range, int numThreads)
+        {
+            auto partitionRangeResult = partitionRange(range, numThreads * kPartitionsPerThread);
+            if (partitionRangeResult.isStatus())
+                return partitionRangeResult.getStatus();
+            auto partitions = partitionRangeResult.getResult();
+
+            std::vector<StateType> partitionStates(partitions.size(), FunctionType::init());
+            auto status = run_partitioned(static_cast<int>(partitions.size()), numThreads, [&](int index) -> tempo_utils::Status {
+                // each vector is accumulated as soon as it is read, while later pages are read ahead
+                auto vectors = generateVectors(partitions[index], ReadAheadOptions());
+                std::shared_ptr<VectorType> vector;
+                std::vector<groove_math::TypedSpan<ValueType>> spans;
+                while (vectors.getNext(vector)) {
+                    spans.clear();
+                    groove_math::append_value_spans(vector->getView(), spans);
+                    for (const auto &span : spans) {
+                        FunctionType::accumulate(partitionStates[index], span);
+                    }
+                }
+                return vectors.getStatus();
+            });
+            if (status.notOk())
+                return status;
+
+            auto state = FunctionType::init();
+            for (const auto &partitionState : partitionStates) {
+                FunctionType::merge(state, partitionState);
+            }
+            return state;
+        }
+
         /**
          *
          * @param modelId
@@ -9,9 +9,41 @@
 #include "base_column.h"
 #include "model_result.h"
 #include "model_types.h"
+#include "page_statistics.h"
 
 namespace groove_model {
 
+    /**
+     * Bounds the pages written by an IndexedColumnWriter. When setValues merges an update with
+     * the pages it overlaps, the merged rows are split into a new page once the current page
+     * holds maxRows rows, or once the estimated size of its keys and values reaches maxBytes. The
+     * cost of rewriting or decoding a page therefore stays bounded as the column grows.
+     */
+    struct PageSizeOptions {
+        tu_int64 maxRows = 64 * 1024;
+        tu_int64 maxBytes = 4 * 1024 * 1024;
+    };
+
+    /**
+     * Returns the approximate number of bytes which a key or value adds to a page.
+     */
+    template <typename T>
+    tu_int64
+    estimate_encoded_size(const T &value)
+    {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return sizeof(tu_int32) + static_cast<tu_int64>(value.size());
+        } else if constexpr (std::is_same_v<T, groove_data::Category>) {
+            tu_int64 size = 0;
+            for (auto iterator = value.cbegin(); iterator != value.cend(); iterator++) {
+                size += sizeof(tu_int32) + static_cast<tu_int64>((*iterator)->size());
+            }
+            return size;
+        } else {
+            return sizeof(T);
+        }
+    }
+
     template <typename DefType,
         typename KeyType = typename DefType::KeyType,
         typename ValueType = typename DefType::ValueType,
@@ -25,17 +57,168 @@ namespace groove_model {
 
     private:
         std::shared_ptr<AbstractPageStore> m_pageStore;
+        PageSizeOptions m_options;
 
         IndexedColumnWriter(
             const tempo_utils::Url &datasetUrl,
             std::shared_ptr<const std::string> modelId,
             std::shared_ptr<const std::string> columnId,
-            std::shared_ptr<AbstractPageStore> pageStore)
+            std::shared_ptr<AbstractPageStore> pageStore,
+            const PageSizeOptions &options)
             : BaseColumn(datasetUrl, modelId, columnId),
-              m_pageStore(pageStore)
+              m_pageStore(pageStore),
+              m_options(options)
         {
         };
 
+        /**
+         * Returns true if a page with numRows rows and numBytes bytes holds less than half of
+         * both bounds of the PageSizeOptions, in which case setValues merges it with a
+         * neighbouring page which has room for its rows.
+         */
+        bool
+        isUndersized(tu_int64 numRows, tu_int64 numBytes) const
+        {
+            return numRows < m_options.maxRows / 2 && numBytes < m_options.maxBytes / 2;
+        }
+
+        /**
+         * Reads the page data and the statistics of the page. The statistics are read from the
+         * page metadata if the page has them, otherwise the page is decoded, in which case the
+         * decoded page is also returned.
+         */
+        tempo_utils::Status
+        readPage(
+            const PageId &pageId,
+            std::shared_ptr<arrow::Buffer> &pageData,
+            PageStatistics<DefType> &statistics,
+            std::shared_ptr<IndexedPage<DefType>> &page)
+        {
+            auto getDataResult = m_pageStore->getPageData(pageId);
+            if (getDataResult.isStatus())
+                return getDataResult.getStatus();
+            pageData = getDataResult.getResult();
+            if (!pageData || pageData->size() == 0)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+
+            auto statisticsOption = IndexedPage<DefType>::readStatistics(pageData);
+            if (!statisticsOption.isEmpty()) {
+                statistics = statisticsOption.getValue();
+                return ModelStatus::ok();
+            }
+            page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+            if (page == nullptr)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+            statistics = page->getStatistics();
+            return ModelStatus::ok();
+        }
+
+        /**
+         * Decodes the page data, unless readPage has already decoded it.
+         */
+        tempo_utils::Status
+        decodePage(
+            const PageId &pageId,
+            std::shared_ptr<arrow::Buffer> pageData,
+            std::shared_ptr<IndexedPage<DefType>> &page)
+        {
+            if (page != nullptr)
+                return ModelStatus::ok();
+            page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+            if (page == nullptr)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+            return ModelStatus::ok();
+        }
+
+        /**
+         * Returns the pages holding rows between smallest and largest inclusive. The pages are not
+         * sliced, so rewriting them keeps their rows outside of the range. If no page starts at or
+         * before smallest then the scan begins with the first page after it. The key bounds of
+         * each page are read from its statistics, so only the pages which overlap are decoded.
+         * If the page before the overlapping pages is undersized then it is returned as well, so
+         * that the update is merged into it, and nextPageId is set to the page after the
+         * overlapping pages if there is one.
+         */
+        tempo_utils::Result<IteratorType>
+        getOverlappingPages(const KeyType &smallest, const KeyType &largest, Option<PageId> &nextPageId)
+        {
+            std::forward_list<std::shared_ptr<VectorType>> vectors;
+            std::vector<PageId> pageIds;
+            auto last = vectors.before_begin();
+            Option<PageId> previousPageId;
+
+            auto searchKey = PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
+                getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(smallest));
+            auto getPageIdResult = m_pageStore->getPageIdBefore(searchKey, false);
+            if (getPageIdResult.isStatus()) {
+                auto status = getPageIdResult.getStatus();
+                if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                    return status;
+                getPageIdResult = m_pageStore->getPageIdAfter(searchKey, false);
+            }
+
+            while (getPageIdResult.isResult()) {
+                auto pageId = getPageIdResult.getResult();
+                std::shared_ptr<arrow::Buffer> pageData;
+                PageStatistics<DefType> statistics;
+                std::shared_ptr<IndexedPage<DefType>> page;
+                auto status = readPage(pageId, pageData, statistics, page);
+                if (status.notOk())
+                    return status;
+
+                if (statistics.numRows > 0) {
+                    if (largest < statistics.minKey) {
+                        nextPageId = Option<PageId>(pageId);
+                        break;
+                    }
+                    if (statistics.maxKey < smallest) {
+                        previousPageId = Option<PageId>(pageId);
+                    } else {
+                        status = decodePage(pageId, pageData, page);
+                        if (status.notOk())
+                            return status;
+                        last = vectors.insert_after(last, page->getVector());
+                        pageIds.push_back(pageId);
+                    }
+                }
+                getPageIdResult = m_pageStore->getPageIdAfter(pageId, true);
+            }
+            if (getPageIdResult.isStatus()) {
+                auto status = getPageIdResult.getStatus();
+                if (!status.matchesCondition(ModelCondition::kPageNotFound))
+                    return status;
+            }
+
+            // the scan may have started at the first overlapping page
+            if (previousPageId.isEmpty() && !pageIds.empty()) {
+                getPageIdResult = m_pageStore->getPageIdBefore(pageIds.front(), true);
+                if (getPageIdResult.isResult()) {
+                    previousPageId = Option<PageId>(getPageIdResult.getResult());
+                } else if (!getPageIdResult.getStatus().matchesCondition(ModelCondition::kPageNotFound)) {
+                    return getPageIdResult.getStatus();
+                }
+            }
+
+            if (!previousPageId.isEmpty()) {
+                auto pageId = previousPageId.getValue();
+                std::shared_ptr<arrow::Buffer> pageData;
+                PageStatistics<DefType> statistics;
+                std::shared_ptr<IndexedPage<DefType>> page;
+                auto status = readPage(pageId, pageData, statistics, page);
+                if (status.notOk())
+                    return status;
+                if (statistics.numRows > 0 && isUndersized(statistics.numRows, pageData->size())) {
+                    status = decodePage(pageId, pageData, page);
+                    if (status.notOk())
+                        return status;
+                    vectors.push_front(page->getVector());
+                    pageIds.insert(pageIds.begin(), pageId);
+                }
+            }
+
+            return IteratorType(vectors, pageIds);
+        };
+
     public:
 
         /**
@@ -92,6 +275,13 @@ namespace groove_model {
         };
 
         /**
+         * Merges the vector into the column. The pages holding rows in the key range of the
+         * vector are read and merged with it, where the vector replaces any row with the same key,
+         * and the merged rows are written as one or more pages bounded by the PageSizeOptions of
+         * the writer. An undersized page before the update is merged along with it, and an
+         * undersized last page of the merged rows takes the rows of the following page if they
+         * fit, so that small updates do not leave a trail of small pages. Each page is keyed by
+         * its smallest key, and the old pages are replaced in a single transaction.
          *
          * @param vector
          * @return
@@ -105,18 +295,26 @@ namespace groove_model {
 
             DatumType smallest = vector->getSmallest().getValue();
             DatumType largest = vector->getLargest().getValue();
-            RangeType range;
-            range.start = Option<KeyType>(smallest.key);
-            range.start_exclusive = false;
-            range.end = Option<KeyType>(largest.key);
-            range.end_exclusive = false;
 
             // get iterator containing all pages holding data for range
-            auto getCurrentResult = getValues(range);
+            Option<PageId> nextPageId;
+            auto getCurrentResult = getOverlappingPages(smallest.key, largest.key, nextPageId);
             if (getCurrentResult.isStatus())
                 return getCurrentResult.getStatus();
             auto current = getCurrentResult.getResult();
 
+            std::unique_ptr<AbstractPageStoreTransaction> txn(m_pageStore->startTransaction());
+            if (txn == nullptr)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "failed to start transaction");
+
+            // remove old pages from the persistent store, a new page may reuse the id of an old one
+            for (auto iterator = current.pageIdsBegin(); iterator != current.pageIdsEnd(); iterator++) {
+                auto currPageId = *iterator;
+                auto status = txn->removePage(currPageId);
+                if (status.notOk())
+                    return status;
+            }
+
             // get iterator containing updates
             auto updates = vector->iterator();
 
@@ -128,83 +326,154 @@ namespace groove_model {
 
             // set initial output state
             auto schema = vector->getSchema();
-            KeyBuilderType keyBuilder;
+            KeyBuilderType keyBuilder = make_page_key_builder<KeyBuilderType>();
             ValueBuilderType valBuilder;
-            arrow::BooleanBuilder fidBuilder;
+            std::vector<tu_int8> fidelityCodes;
+            bool hasExtendedFidelity = false;
+            tu_int64 numRows = 0;
+            tu_int64 numBytes = 0;
+
+            // a valid or approximate value is stored as-is and any other fidelity as a null value.
+            // fidelity codes are only written to the page if some row is neither valid nor missing
+            auto appendDatum = [&](const DatumType &datum) -> arrow::Status {
+                auto status = keyBuilder.Append(datum.key);
+                if (!status.ok())
+                    return status;
+                numBytes += estimate_encoded_size(datum.key);
+                switch (datum.fidelity) {
+                    case groove_data::DatumFidelity::FIDELITY_VALID:
+                        status = valBuilder.Append(datum.value);
+                        numBytes += estimate_encoded_size(datum.value);
+                        break;
+                    case groove_data::DatumFidelity::FIDELITY_APPROXIMATE:
+                        status = valBuilder.Append(datum.value);
+                        numBytes += estimate_encoded_size(datum.value);
+                        hasExtendedFidelity = true;
+                        break;
+                    case groove_data::DatumFidelity::FIDELITY_MISSING:
+                        status = valBuilder.AppendNull();
+                        break;
+                    default:
+                        status = valBuilder.AppendNull();
+                        hasExtendedFidelity = true;
+                        break;
+                }
+                fidelityCodes.push_back(static_cast<tu_int8>(datum.fidelity));
+                numRows++;
+                return status;
+            };
+
+            // writes the rows appended since the last page as a new page
+            auto writeMergedPage = [&]() -> tempo_utils::Status {
+                auto finishKeyResult = keyBuilder.Finish();
+                if (!finishKeyResult.ok())
+                    return ModelStatus::forCondition(ModelCondition::kModelInvariant, finishKeyResult.status().ToString());
+                auto finishValResult = valBuilder.Finish();
+                if (!finishValResult.ok())
+                    return ModelStatus::forCondition(ModelCondition::kModelInvariant, finishValResult.status().ToString());
+
+                // the key encoding of the page may differ from the encoding of the updates
+                auto keyField = schema->field(vector->getKeyFieldIndex())->WithType((*finishKeyResult)->type());
+                auto valField = schema->field(vector->getValFieldIndex());
+                std::vector<std::shared_ptr<arrow::Field>> fields = {keyField, valField};
+                std::vector<std::shared_ptr<arrow::Array>> columns = {*finishKeyResult, *finishValResult};
+
+                int fidFieldIndex = -1;
+                if (hasExtendedFidelity) {
+                    arrow::Int8Builder fidBuilder;
+                    auto status = fidBuilder.AppendValues(fidelityCodes);
+                    if (!status.ok())
+                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
+                    auto finishFidResult = fidBuilder.Finish();
+                    if (!finishFidResult.ok())
+                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, finishFidResult.status().ToString());
+                    fields.push_back(arrow::field("", arrow::int8()));
+                    columns.push_back(*finishFidResult);
+                    fidFieldIndex = 2;
+                }
+
+                auto table = arrow::Table::Make(arrow::schema(fields), columns, numRows);
+                auto merged = VectorType::create(table, 0, 1, fidFieldIndex);
+
+                // construct the page
+                auto pageId = PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
+                    getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(merged->getSmallest().getValue().key));
+                auto page = IndexedPage<DefType>::fromVector(pageId, merged);
+
+                // insert new page into the persistent store
+                auto status = txn->writePage(pageId, page->toBuffer());
+                if (status.notOk())
+                    return status;
+
+                // the builders are reset by Finish, so only the page state is cleared
+                fidelityCodes.clear();
+                hasExtendedFidelity = false;
+                numRows = 0;
+                numBytes = 0;
+                return ModelStatus::ok();
+            };
 
             //
-            tu_int64 numRows = 0;
             while (hasCurrent || hasupdated) {
                 arrow::Status status;
                 if (hasCurrent && (!hasupdated || currentDatum.key < updatedDatum.key)) {
-                    status = keyBuilder.Append(currentDatum.key);
-                    if (!status.ok())
-                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
-                    status = valBuilder.Append(currentDatum.value);
-                    if (!status.ok())
-                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
-                    status = fidBuilder.AppendNull();
+                    status = appendDatum(currentDatum);
                     if (!status.ok())
                         return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
-                    numRows++;
                     hasCurrent = current.getNext(currentDatum);
                 } else {
                     if (hasCurrent && currentDatum.key == updatedDatum.key) {
                         hasCurrent = current.getNext(currentDatum);
                     }
-                    status = keyBuilder.Append(updatedDatum.key);
+                    status = appendDatum(updatedDatum);
                     if (!status.ok())
                         return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
-                    status = valBuilder.Append(updatedDatum.value);
-                    if (!status.ok())
-                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
-                    status = fidBuilder.AppendNull();
-                    if (!status.ok())
-                        return ModelStatus::forCondition(ModelCondition::kModelInvariant, status.ToString());
-                    numRows++;
                     hasupdated = updates.getNext(updatedDatum);
                 }
-            }
-
-            // construct the merged vector
-            auto finishKeyResult = keyBuilder.Finish();
-            if (!finishKeyResult.ok())
-                return ModelStatus::forCondition(ModelCondition::kModelInvariant, finishKeyResult.status().ToString());
-            auto finishValResult = valBuilder.Finish();
-            if (!finishValResult.ok())
-                return ModelStatus::forCondition(ModelCondition::kModelInvariant, finishValResult.status().ToString());
-            auto finishFidResult = fidBuilder.Finish();
-            if (!finishFidResult.ok())
-                return ModelStatus::forCondition(ModelCondition::kModelInvariant, finishFidResult.status().ToString());
-            auto table = arrow::Table::Make(schema, {*finishKeyResult, *finishValResult, *finishFidResult}, numRows);
-            auto merged = VectorType::create(table, 0, 1, 2);
-
-            // construct the page
-            auto pageId = PageId::create<DefType,groove_data::CollationMode::COLLATION_INDEXED>(
-                getDatasetUrl(), getModelId(), getColumnId(), Option<KeyType>(merged->getSmallest().getValue().key));
-
-            auto page = IndexedPage<DefType>::fromVector(pageId, merged);
 
-            std::unique_ptr<AbstractPageStoreTransaction> txn(m_pageStore->startTransaction());
-            if (txn == nullptr)
-                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "failed to start transaction");
+                // split the merged rows once the page reaches its bound
+                if (numRows >= m_options.maxRows || numBytes >= m_options.maxBytes) {
+                    auto writeStatus = writeMergedPage();
+                    if (writeStatus.notOk())
+                        return writeStatus;
+                }
+            }
 
-            // remove old pages from the persistent store
-            for (auto iterator = current.pageIdsBegin(); iterator != current.pageIdsEnd(); iterator++) {
-                auto currPageId = *iterator;
-                auto status = txn->removePage(currPageId);
+            // an undersized remainder takes the rows of the following page if they fit
+            if (numRows > 0 && !nextPageId.isEmpty() && isUndersized(numRows, numBytes)) {
+                auto pageId = nextPageId.getValue();
+                std::shared_ptr<arrow::Buffer> pageData;
+                PageStatistics<DefType> statistics;
+                std::shared_ptr<IndexedPage<DefType>> page;
+                auto status = readPage(pageId, pageData, statistics, page);
                 if (status.notOk())
                     return status;
+                if (numRows + statistics.numRows <= m_options.maxRows
+                    && numBytes + static_cast<tu_int64>(pageData->size()) <= m_options.maxBytes) {
+                    status = decodePage(pageId, pageData, page);
+                    if (status.notOk())
+                        return status;
+                    status = txn->removePage(pageId);
+                    if (status.notOk())
+                        return status;
+                    auto following = page->getVector()->iterator();
+                    DatumType datum;
+                    while (following.getNext(datum)) {
+                        auto appendStatus = appendDatum(datum);
+                        if (!appendStatus.ok())
+                            return ModelStatus::forCondition(ModelCondition::kModelInvariant, appendStatus.ToString());
+                    }
+                }
             }
 
-            // insert new page into the persistent store
-            auto buffer = page->toBuffer();
-            auto status = txn->writePage(pageId, buffer);
-            if (status.notOk())
-                return status;
+            if (numRows > 0) {
+                auto status = writeMergedPage();
+                if (status.notOk())
+                    return status;
+            }
 
             // apply store changes atomically
-            status = txn->apply();
+            auto status = txn->apply();
             if (status.notOk())
                 return status;
 
@@ -216,6 +485,7 @@ namespace groove_model {
          * @param modelId
          * @param columnId
          * @param store
+         * @param options
          * @return
          */
         static std::shared_ptr<IndexedColumnWriter<DefType>>
@@ -223,10 +493,13 @@ namespace groove_model {
             const tempo_utils::Url &datasetUrl,
             std::shared_ptr<const std::string> modelId,
             std::shared_ptr<const std::string> columnId,
-            std::shared_ptr<AbstractPageStore> pageStore)
+            std::shared_ptr<AbstractPageStore> pageStore,
+            const PageSizeOptions &options = {})
         {
+            TU_ASSERT (options.maxRows > 0);
+            TU_ASSERT (options.maxBytes > 0);
             return std::shared_ptr<IndexedColumnWriter<DefType>>(
-                new IndexedColumnWriter<DefType>(datasetUrl, modelId, columnId, pageStore));
+                new IndexedColumnWriter<DefType>(datasetUrl, modelId, columnId, pageStore, options));
         };
     };
 }
@@ -11,6 +11,7 @@
 #include <groove_data/table_utils.h>
 
 #include "base_page.h"
+#include "page_statistics.h"
 
 namespace groove_model {
 
@@ -60,10 +61,10 @@ namespace groove_model {
             auto index = groove_data::search_indexed_vector(m_vector, key);
             if (index < 0)
                 return false;
-            auto datum = m_vector->getDatum(index);
-            if (datum.fidelity != groove_data::DatumFidelity::FIDELITY_VALID)
+            const auto &view = m_vector->getView();
+            if (!view.isAllValid() && view.getFidelity(index) != groove_data::DatumFidelity::FIDELITY_VALID)
                 return false;
-            value = datum.value;
+            value = view.getValue(index);
             return true;
         }
 
@@ -93,6 +94,17 @@ namespace groove_model {
             return m_vector->iterator();
         }
 
+        /**
+         * Returns true if every row in the page is FIDELITY_VALID.
+         *
+         * @return
+         */
+        bool
+        isAllValid() const
+        {
+            return m_vector->getView().isAllValid();
+        }
+
         /**
          *
          * @return
@@ -114,6 +126,19 @@ namespace groove_model {
         }
 
         /**
+         * Computes the summary statistics for the rows in the page.
+         *
+         * @return
+         */
+        PageStatistics<DefType>
+        getStatistics() const
+        {
+            return PageStatistics<DefType>::fromVector(*m_vector);
+        }
+
+        /**
+         * Serializes the page as an arrow IPC stream. The page statistics are attached to the key
+         * and value fields of the stream schema, see readStatistics.
          *
          * @return
          */
@@ -125,22 +150,27 @@ namespace groove_model {
                 return {};
             auto stream = *createBufResult;
 
+            // the fidelity column is only present when some row is neither valid nor missing
             auto vectorSchema = m_vector->getSchema();
-            auto keyField = vectorSchema->field(m_vector->getKeyFieldIndex());
-            auto valField = vectorSchema->field(m_vector->getValFieldIndex());
-            auto fidField = vectorSchema->field(m_vector->getFidFieldIndex());
-            auto schema = arrow::schema({keyField, valField, fidField});
+            auto vectorTable = m_vector->getTable();
+            std::vector<std::shared_ptr<arrow::Field>> fields;
+            std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+            fields.push_back(vectorSchema->field(m_vector->getKeyFieldIndex()));
+            columns.push_back(vectorTable->column(m_vector->getKeyFieldIndex()));
+            fields.push_back(vectorSchema->field(m_vector->getValFieldIndex()));
+            columns.push_back(vectorTable->column(m_vector->getValFieldIndex()));
+            if (m_vector->getFidFieldIndex() >= 0) {
+                fields.push_back(vectorSchema->field(m_vector->getFidFieldIndex()));
+                columns.push_back(vectorTable->column(m_vector->getFidFieldIndex()));
+            }
+            auto schema = getStatistics().annotateSchema(arrow::schema(fields), 0, 1);
 
             auto makeWriterResult = arrow::ipc::MakeStreamWriter(stream, schema);
             if (!makeWriterResult.ok())
                 return {};
             auto writer = *makeWriterResult;
 
-            auto vectorTable = m_vector->getTable();
-            auto keyArray = vectorTable->column(m_vector->getKeyFieldIndex());
-            auto valArray = vectorTable->column(m_vector->getValFieldIndex());
-            auto fidArray = vectorTable->column(m_vector->getFidFieldIndex());
-            auto table = arrow::Table::Make(schema, {keyArray, valArray, fidArray});
+            auto table = arrow::Table::Make(schema, columns);
 
             arrow::Status status;
             status = writer->WriteTable(*table);
@@ -185,10 +215,27 @@ namespace groove_model {
             auto makeTableResult = groove_data::make_table(buffer);
             if (makeTableResult.isStatus())
                 return nullptr;
-            auto vector = VectorType::create(makeTableResult.getResult(), 0, 1, 2);
+            auto table = makeTableResult.getResult();
+            auto vector = VectorType::create(table, 0, 1, table->num_columns() > 2? 2 : -1);
             return fromVector(pageId, vector);
         }
 
+        /**
+         * Reads the page statistics from the serialized page without decoding the page contents.
+         * Returns an empty option if the page was written without statistics.
+         *
+         * @param buffer
+         * @return
+         */
+        static Option<PageStatistics<DefType>>
+        readStatistics(std::shared_ptr<arrow::Buffer> buffer)
+        {
+            auto readSchemaResult = read_page_schema(buffer);
+            if (readSchemaResult.isStatus())
+                return {};
+            return PageStatistics<DefType>::fromSchema(*readSchemaResult.getResult(), 0, 1);
+        }
+
         /**
          *
          * @param pageId
@@ -201,7 +248,8 @@ namespace groove_model {
             auto makeTableResult = groove_data::make_table(bytes);
             if (makeTableResult.isStatus())
                 return nullptr;
-            auto vector = VectorType::create(makeTableResult.getResult(), 0, 1, 2);
+            auto table = makeTableResult.getResult();
+            auto vector = VectorType::create(table, 0, 1, table->num_columns() > 2? 2 : -1);
             return fromVector(pageId, vector);
         }
     };
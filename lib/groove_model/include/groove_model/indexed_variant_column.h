@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include <groove_iterator/map_iterator_template.h>
+#include <groove_iterator/pipeline_iterator_template.h>
 #include <tempo_utils/iterator_template.h>
 
 #include "column_traits.h"
@@ -140,14 +141,12 @@ namespace groove_model {
             auto getValuesResult = m_column->getValues(range);
             if (getValuesResult.isStatus())
                 return getValuesResult.getStatus();
-            auto it = new groove_iterator::MapIterator<
-                IteratorType,
-                DatumType,
-                VariantValueDatum<KeyType>>(getValuesResult.getResult(), to_variant_value);
-            auto input = std::shared_ptr<groove_iterator::MapIterator<
-                IteratorType,
-                DatumType,
-                VariantValueDatum<KeyType>>>(it);
+            // the conversion is inlined into the column iterator loop, and the pipeline is
+            // allocated together with its control block
+            auto pipeline = groove_iterator::map_inline(getValuesResult.getResult(),
+                [](const DatumType &datum) { return to_variant_value<KeyType,DatumType>(datum); });
+            auto input = std::make_shared<groove_iterator::PipelineIterator<decltype(pipeline)>>(
+                std::move(pipeline));
             return VariantValueDatumIterator<KeyType>(input);
         };
 
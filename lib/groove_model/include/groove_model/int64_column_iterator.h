@@ -18,14 +18,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::Int64DoubleDatum &datum) override;
+        int getNextBatch(groove_data::Int64DoubleDatum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::Int64DoubleVector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::Int64DoubleVector> m_vector;
-        tu_int64 m_curr;
+        groove_data::Int64DoubleDatumIterator m_iterator;
     };
 
     class Int64Int64ColumnIterator : public Iterator<groove_data::Int64Int64Datum> {
@@ -36,14 +36,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::Int64Int64Datum &datum) override;
+        int getNextBatch(groove_data::Int64Int64Datum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::Int64Int64Vector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::Int64Int64Vector> m_vector;
-        tu_int64 m_curr;
+        groove_data::Int64Int64DatumIterator m_iterator;
     };
 
     class Int64StringColumnIterator : public Iterator<groove_data::Int64StringDatum> {
@@ -54,14 +54,14 @@ namespace groove_model {
             const std::vector<PageId> &pageIds);
 
         bool getNext(groove_data::Int64StringDatum &datum) override;
+        int getNextBatch(groove_data::Int64StringDatum *batch, int batchSize);
         std::vector<PageId>::const_iterator pageIdsBegin() const;
         std::vector<PageId>::const_iterator pageIdsEnd() const;
 
     private:
         std::forward_list<std::shared_ptr<groove_data::Int64StringVector>> m_vectors;
         std::vector<PageId> m_pageIds;
-        std::shared_ptr<groove_data::Int64StringVector> m_vector;
-        tu_int64 m_curr;
+        groove_data::Int64StringDatumIterator m_iterator;
     };
 }
 
@@ -1,6 +1,8 @@
 #ifndef GROOVE_MODEL_MODEL_TYPES_H
 #define GROOVE_MODEL_MODEL_TYPES_H
 
+#include <type_traits>
+
 #include <arrow/builder.h>
 
 #include <groove_data/category_builder.h>
@@ -216,6 +218,23 @@ namespace groove_model {
         Int64String();
     };
 
+    /**
+     * Constructs the key builder used to write pages. Category keys are written dictionary encoded,
+     * all other key builders are default constructed.
+     *
+     * @tparam KeyBuilderType
+     * @return
+     */
+    template <typename KeyBuilderType>
+    inline KeyBuilderType make_page_key_builder()
+    {
+        if constexpr (std::is_constructible_v<KeyBuilderType, groove_data::CategoryEncoding>) {
+            return KeyBuilderType(groove_data::CategoryEncoding::ENCODING_DICTIONARY);
+        } else {
+            return KeyBuilderType();
+        }
+    }
+
     struct NamespaceAddress {
     public:
         NamespaceAddress() : u32(kInvalidOffsetU32) {};
@@ -6,6 +6,7 @@
 #include <absl/hash/hash.h>
 
 #include <groove_data/category.h>
+#include <groove_data/compact_category.h>
 #include <tempo_utils/integer_types.h>
 #include <tempo_utils/option_template.h>
 #include <tempo_utils/logging.h>
@@ -58,6 +59,27 @@ namespace groove_model {
         }
     }
 
+    /**
+     * Converts a page id with a category key in the legacy encoding to the current encoding. Returns
+     * false if the page id does not have a legacy category key, in which case it needs no conversion.
+     *
+     * @param legacyId
+     * @param pageId
+     * @return
+     */
+    bool convert_legacy_category_page_id(std::string_view legacyId, std::string &pageId);
+
+    /**
+     * Converts a page id with a category key in the current encoding to the legacy encoding, for
+     * lookups in stores written before the current encoding was introduced. Returns false if the
+     * page id does not have a category key.
+     *
+     * @param pageId
+     * @param legacyId
+     * @return
+     */
+    bool convert_category_page_id_to_legacy(std::string_view pageId, std::string &legacyId);
+
     class PageId {
     public:
         PageId();
@@ -87,6 +109,13 @@ namespace groove_model {
             groove_data::DataValueType valueType,
             groove_data::CollationMode collation,
             Option<groove_data::Category> key);
+        static PageId create(
+            const tempo_utils::Url &datasetUrl,
+            std::shared_ptr<const std::string> modelId,
+            std::shared_ptr<const std::string> columnId,
+            groove_data::DataValueType valueType,
+            groove_data::CollationMode collation,
+            Option<groove_data::CompactCategory> key);
         static PageId create(
             const tempo_utils::Url &datasetUrl,
             std::shared_ptr<const std::string> modelId,
@@ -185,6 +214,19 @@ namespace groove_model {
                 key_to_bytes(key));
         }
     };
+
+    /**
+     * Returns true if the page with the specified id starts after the end of a range, where
+     * endPageId is the id created for the end key of the range, or empty if the range has no
+     * end. A page id holds the first key of its page and page ids sort in key order, so this
+     * decides whether a page can be skipped without reading it.
+     *
+     * @param pageId
+     * @param endPageId
+     * @param endExclusive
+     * @return
+     */
+    bool page_id_follows_range(const PageId &pageId, const Option<PageId> &endPageId, bool endExclusive);
 }
 
 #endif // GROOVE_MODEL_PAGE_ID_H
\ No newline at end of file
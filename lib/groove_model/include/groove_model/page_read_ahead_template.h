@@ -0,0 +1,328 @@
+#ifndef GROOVE_MODEL_PAGE_READ_AHEAD_TEMPLATE_H
+#define GROOVE_MODEL_PAGE_READ_AHEAD_TEMPLATE_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include <absl/synchronization/mutex.h>
+
+#include <tempo_utils/option_template.h>
+
+#include "abstract_page_cache.h"
+#include "indexed_page_template.h"
+#include "model_result.h"
+#include "model_types.h"
+#include "page_id.h"
+#include "page_statistics.h"
+#include "scan_executor.h"
+
+namespace groove_model {
+
+    /**
+     * Bounds the pages which a PageReadAhead holds ahead of its consumer. The reader stops
+     * fetching once depth pages are waiting, or once the waiting pages hold at least maxBytes
+     * of page data. A page is always fetched when none are waiting, so a page larger than
+     * maxBytes does not stall the scan. Pages are read on the executor, or on the shared
+     * ScanExecutor if no executor is given.
+     */
+    struct ReadAheadOptions {
+        int depth = 4;
+        tu_int64 maxBytes = 64 * 1024 * 1024;
+        std::shared_ptr<ScanExecutor> executor;
+    };
+
+    /**
+     * Scans the pages of an indexed column which overlap a range. The pages are fetched from the
+     * page cache and decoded on a ScanExecutor, up to the bounds of the options, while the consumer
+     * processes the pages already returned, so the I/O and decode of later pages overlaps with the
+     * work done on earlier ones. Pages are returned in key order and sliced to the range, pages
+     * whose statistics show they lie before the range are skipped without being decoded, and the
+     * scan stops at the first page whose id shows that it starts after the range, without reading
+     * it. If a summarize function is given, then a page which lies entirely within the range and
+     * for which the function returns true is returned with its statistics and without being
+     * decoded. The reader reads one page per executor job, and when the consumer is waiting and no
+     * job is reading it reads the next page itself, so the scan makes progress however busy the
+     * executor is. The page cache is read from the executor, which the RocksDbStore and the
+     * DatasetReader both support.
+     *
+     * @tparam DefType
+     */
+    template <typename DefType,
+        typename VectorType = typename ColumnTraits<DefType, groove_data::CollationMode::COLLATION_INDEXED>::VectorType,
+        typename RangeType = typename ColumnTraits<DefType, groove_data::CollationMode::COLLATION_INDEXED>::RangeType>
+    class PageReadAhead : public std::enable_shared_from_this<PageReadAhead<DefType>> {
+
+    public:
+        using SummarizeFunc = std::function<bool(const PageStatistics<DefType> &)>;
+
+        /**
+         * A page of the range. The vector holds the rows of the page sliced to the range, or is
+         * null if the page was summarized, in which case the statistics describe the page.
+         */
+        struct Page {
+            PageId pageId;
+            std::shared_ptr<VectorType> vector;
+            PageStatistics<DefType> statistics;
+        };
+
+        /**
+         * Waits for the next page in the range. Returns false once every page in the range has
+         * been returned, or once reading a page has failed, in which case getStatus returns the
+         * reason.
+         *
+         * @param page
+         * @return
+         */
+        bool
+        getNext(Page &page)
+        {
+            absl::MutexLock locker(&m_lock);
+            for (;;) {
+                if (!m_ready.empty()) {
+                    page = std::move(m_ready.front().page);
+                    m_readyBytes -= m_ready.front().numBytes;
+                    m_ready.pop_front();
+                    scheduleRead();
+                    return true;
+                }
+                if (m_finished)
+                    return false;
+                if (!m_reading) {
+                    // no job is reading, so read the next page on this thread rather than wait
+                    m_reading = true;
+                    m_lock.Unlock();
+                    readNextPage();
+                    m_lock.Lock();
+                    continue;
+                }
+                m_lock.Await(absl::Condition(this, &PageReadAhead::hasPageOrIdle));
+            }
+        };
+
+        tempo_utils::Status
+        getStatus()
+        {
+            absl::MutexLock locker(&m_lock);
+            return m_status;
+        };
+
+        /**
+         * Starts reading the pages of the range, beginning with firstPageId. If firstPageId is
+         * empty then the column has no pages and the read-ahead is finished immediately. The
+         * reader stops without reading a page whose id follows endPageId, the id created for
+         * the end key of the range, see page_id_follows_range.
+         *
+         * @param pageCache
+         * @param firstPageId
+         * @param endPageId
+         * @param range
+         * @param options
+         * @param summarize
+         * @return
+         */
+        static std::shared_ptr<PageReadAhead<DefType>>
+        create(
+            std::shared_ptr<AbstractPageCache> pageCache,
+            const Option<PageId> &firstPageId,
+            const Option<PageId> &endPageId,
+            const RangeType &range,
+            const ReadAheadOptions &options,
+            SummarizeFunc summarize = {})
+        {
+            TU_ASSERT (pageCache != nullptr);
+            TU_ASSERT (options.depth > 0);
+            auto readAhead = std::shared_ptr<PageReadAhead<DefType>>(
+                new PageReadAhead<DefType>(pageCache, endPageId, range, options, std::move(summarize)));
+            absl::MutexLock locker(&readAhead->m_lock);
+            if (firstPageId.isEmpty()) {
+                readAhead->m_finished = true;
+            } else {
+                readAhead->m_nextPageId = firstPageId.getValue();
+                readAhead->scheduleRead();
+            }
+            return readAhead;
+        };
+
+    private:
+        struct ReadyPage {
+            Page page;
+            tu_int64 numBytes;
+        };
+
+        std::shared_ptr<AbstractPageCache> m_pageCache;
+        Option<PageId> m_endPageId;
+        RangeType m_range;
+        ReadAheadOptions m_options;
+        SummarizeFunc m_summarize;
+        absl::Mutex m_lock;
+        std::deque<ReadyPage> m_ready ABSL_GUARDED_BY(m_lock);
+        tu_int64 m_readyBytes ABSL_GUARDED_BY(m_lock);
+        PageId m_nextPageId ABSL_GUARDED_BY(m_lock);
+        bool m_reading ABSL_GUARDED_BY(m_lock);
+        bool m_scheduled ABSL_GUARDED_BY(m_lock);
+        bool m_finished ABSL_GUARDED_BY(m_lock);
+        tempo_utils::Status m_status ABSL_GUARDED_BY(m_lock);
+
+        PageReadAhead(
+            std::shared_ptr<AbstractPageCache> pageCache,
+            const Option<PageId> &endPageId,
+            const RangeType &range,
+            const ReadAheadOptions &options,
+            SummarizeFunc summarize)
+            : m_pageCache(pageCache),
+              m_endPageId(endPageId),
+              m_range(range),
+              m_options(options),
+              m_summarize(std::move(summarize)),
+              m_readyBytes(0),
+              m_reading(false),
+              m_scheduled(false),
+              m_finished(false),
+              m_status(ModelStatus::ok())
+        {
+            if (m_options.executor == nullptr) {
+                m_options.executor = ScanExecutor::shared();
+            }
+        };
+
+        bool
+        hasPageOrIdle() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(m_lock)
+        {
+            return !m_ready.empty() || m_finished || !m_reading;
+        };
+
+        bool
+        canReadAhead() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(m_lock)
+        {
+            if (m_ready.empty())
+                return true;
+            return static_cast<int>(m_ready.size()) < m_options.depth && m_readyBytes < m_options.maxBytes;
+        };
+
+        // submits a job to read the next page, unless a page is being read, a job is already
+        // waiting to run, or the consumer is far enough behind
+        void
+        scheduleRead() ABSL_EXCLUSIVE_LOCKS_REQUIRED(m_lock)
+        {
+            if (m_finished || m_reading || m_scheduled || !canReadAhead())
+                return;
+            m_scheduled = true;
+            // the job does not keep the read-ahead alive, so a scan which is abandoned stops
+            std::weak_ptr<PageReadAhead<DefType>> weak = this->weak_from_this();
+            m_options.executor->submit([weak]() {
+                auto readAhead = weak.lock();
+                if (readAhead != nullptr) {
+                    readAhead->runScheduledRead();
+                }
+            });
+        };
+
+        void
+        runScheduledRead()
+        {
+            {
+                absl::MutexLock locker(&m_lock);
+                m_scheduled = false;
+                if (m_finished || m_reading || !canReadAhead())
+                    return;
+                m_reading = true;
+            }
+            readNextPage();
+        };
+
+        // reads the page at m_nextPageId, the caller must have set m_reading
+        void
+        readNextPage()
+        {
+            PageId pageId;
+            {
+                absl::MutexLock locker(&m_lock);
+                pageId = m_nextPageId;
+            }
+
+            Option<Page> pageOption;
+            tu_int64 numBytes = 0;
+            bool done = false;
+            auto status = readPage(pageId, pageOption, numBytes, done);
+
+            PageId nextPageId;
+            if (status.isOk() && !done) {
+                auto getPageIdResult = m_pageCache->getPageIdAfter(pageId, true);
+                if (getPageIdResult.isResult()) {
+                    nextPageId = getPageIdResult.getResult();
+                    // the next page starts after the range, so it is not read
+                    done = page_id_follows_range(nextPageId, m_endPageId, m_range.end_exclusive);
+                } else if (getPageIdResult.getStatus().matchesCondition(ModelCondition::kPageNotFound)) {
+                    done = true;
+                } else {
+                    status = getPageIdResult.getStatus();
+                }
+            }
+
+            absl::MutexLock locker(&m_lock);
+            if (!pageOption.isEmpty()) {
+                m_ready.push_back({pageOption.getValue(), numBytes});
+                m_readyBytes += numBytes;
+            }
+            if (status.notOk()) {
+                m_status = status;
+                m_finished = true;
+            } else if (done) {
+                m_finished = true;
+            } else {
+                m_nextPageId = nextPageId;
+            }
+            m_reading = false;
+            scheduleRead();
+        };
+
+        // reads a single page, setting done if no page after it can overlap the range
+        tempo_utils::Status
+        readPage(const PageId &pageId, Option<Page> &pageOption, tu_int64 &numBytes, bool &done)
+        {
+            auto getDataResult = m_pageCache->getPageData(pageId);
+            if (getDataResult.isStatus())
+                return getDataResult.getStatus();
+            auto pageData = getDataResult.getResult();
+            if (!pageData || pageData->size() == 0)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+            numBytes = pageData->size();
+
+            auto statisticsOption = IndexedPage<DefType>::readStatistics(pageData);
+            if (!statisticsOption.isEmpty()) {
+                auto statistics = statisticsOption.getValue();
+                if (statistics.numRows > 0 && key_follows_range(statistics.minKey, m_range)) {
+                    done = true;
+                    return ModelStatus::ok();
+                }
+                if (statistics.numRows == 0 || key_precedes_range(statistics.maxKey, m_range))
+                    return ModelStatus::ok();
+                bool insideRange = !key_precedes_range(statistics.minKey, m_range)
+                    && !key_follows_range(statistics.maxKey, m_range);
+                if (insideRange && m_summarize && m_summarize(statistics)) {
+                    pageOption = Option<Page>(Page{pageId, nullptr, statistics});
+                    return ModelStatus::ok();
+                }
+            }
+
+            auto page = IndexedPage<DefType>::fromBuffer(pageId, pageData);
+            if (page == nullptr)
+                return ModelStatus::forCondition(ModelCondition::kModelInvariant, "invalid page");
+            auto vector = page->getVector();
+            auto slice = vector->slice(m_range);
+            if (!slice->isEmpty()) {
+                pageOption = Option<Page>(Page{pageId, slice, {}});
+                return ModelStatus::ok();
+            }
+            // without statistics an empty slice after the start of the range ends the scan
+            auto smallestOption = vector->getSmallest();
+            if (!smallestOption.isEmpty() && key_follows_range(smallestOption.getValue().key, m_range)) {
+                done = true;
+            }
+            return ModelStatus::ok();
+        };
+    };
+}
+
+#endif // GROOVE_MODEL_PAGE_READ_AHEAD_TEMPLATE_H
@@ -0,0 +1,300 @@
+#ifndef GROOVE_MODEL_PAGE_STATISTICS_H
+#define GROOVE_MODEL_PAGE_STATISTICS_H
+
+#include <cmath>
+#include <type_traits>
+
+#include <arrow/buffer.h>
+#include <arrow/type.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <groove_data/category.h>
+#include <groove_math/reduce_kernels.h>
+#include <tempo_utils/option_template.h>
+
+#include "model_result.h"
+#include "page_traits.h"
+
+namespace groove_model {
+
+    // keys of the arrow field metadata which hold page statistics. row count and key bounds are
+    // attached to the key field, valid count, NaN count, value bounds and sum are attached to the
+    // value field. the sum of integer values is exact and is stored under its own key, so pages
+    // written with a floating point sum of integer values are not mistaken for exact ones.
+    constexpr const char *kStatisticsRowsKey = "groove.stats.rows";
+    constexpr const char *kStatisticsValidKey = "groove.stats.valid";
+    constexpr const char *kStatisticsMinKey = "groove.stats.min";
+    constexpr const char *kStatisticsMaxKey = "groove.stats.max";
+    constexpr const char *kStatisticsSumKey = "groove.stats.sum";
+    constexpr const char *kStatisticsIntegerSumKey = "groove.stats.isum";
+    constexpr const char *kStatisticsNaNKey = "groove.stats.nan";
+
+    std::string encode_statistic(tu_int64 value);
+    std::string encode_statistic(double value);
+    std::string encode_statistic(groove_math::Int128 value);
+    std::string encode_statistic(const std::string &value);
+    std::string encode_statistic(const groove_data::Category &value);
+
+    bool decode_statistic(std::string_view bytes, tu_int64 &value);
+    bool decode_statistic(std::string_view bytes, double &value);
+    bool decode_statistic(std::string_view bytes, groove_math::Int128 &value);
+    bool decode_statistic(std::string_view bytes, std::string &value);
+    bool decode_statistic(std::string_view bytes, groove_data::Category &value);
+
+    /**
+     * Reads the schema of the arrow IPC stream in the buffer. Only the schema message at the head
+     * of the stream is parsed, so this is cheap regardless of the size of the record batches.
+     *
+     * @param buffer
+     * @return
+     */
+    tempo_utils::Result<std::shared_ptr<arrow::Schema>> read_page_schema(std::shared_ptr<arrow::Buffer> buffer);
+
+    /**
+     * Returns true if key sorts before the start of the range. Compared against the key bounds
+     * of the page statistics, this decides whether a page can be skipped without decoding it.
+     */
+    template <typename KeyType, typename RangeType>
+    bool
+    key_precedes_range(const KeyType &key, const RangeType &range)
+    {
+        if (range.start.isEmpty())
+            return false;
+        auto start = range.start.getValue();
+        return key < start || (range.start_exclusive && key == start);
+    }
+
+    /**
+     * Returns true if key sorts after the end of the range.
+     */
+    template <typename KeyType, typename RangeType>
+    bool
+    key_follows_range(const KeyType &key, const RangeType &range)
+    {
+        if (range.end.isEmpty())
+            return false;
+        auto end = range.end.getValue();
+        return end < key || (range.end_exclusive && key == end);
+    }
+
+    /**
+     * Summary statistics for the rows of a page or a dataset frame vector. Only rows with
+     * FIDELITY_VALID contribute to the value bounds and the sum, and the sum is only maintained for
+     * numeric values. The sum of integer values is kept exactly in 128 bits, which cannot overflow
+     * for fewer than 2^64 values. NaN values are counted in numValid and numNaN but are excluded
+     * from the value bounds, since they do not order against other values. The statistics are
+     * stored as metadata on the key and value fields of the arrow schema, which allows them to be
+     * read without decoding any record batches.
+     *
+     * @tparam DefType
+     */
+    template <typename DefType,
+        typename KeyType = typename DefType::KeyType,
+        typename ValueType = typename DefType::ValueType,
+        typename DatumType = typename PageTraits<DefType, groove_data::CollationMode::COLLATION_INDEXED>::DatumType,
+        typename VectorType = typename PageTraits<DefType, groove_data::CollationMode::COLLATION_INDEXED>::VectorType>
+    struct PageStatistics {
+        using SumType = std::conditional_t<std::is_integral_v<ValueType>, groove_math::Int128, double>;
+
+        tu_int64 numRows = 0;
+        tu_int64 numValid = 0;
+        tu_int64 numNaN = 0;
+        KeyType minKey = {};
+        KeyType maxKey = {};
+        ValueType minValue = {};
+        ValueType maxValue = {};
+        SumType sum = 0;
+
+        static constexpr bool hasSum() { return std::is_arithmetic_v<ValueType>; }
+        static constexpr bool hasNaN() { return std::is_floating_point_v<ValueType>; }
+        static constexpr const char *sumKey()
+        {
+            return std::is_integral_v<ValueType>? kStatisticsIntegerSumKey : kStatisticsSumKey;
+        }
+
+        /**
+         * Returns the number of valid values which contribute to the value bounds.
+         *
+         * @return
+         */
+        tu_int64 numBounded() const { return numValid - numNaN; }
+
+        /**
+         *
+         * @param datum
+         */
+        void
+        update(const DatumType &datum)
+        {
+            if (numRows == 0 || datum.key < minKey)
+                minKey = datum.key;
+            if (numRows == 0 || maxKey < datum.key)
+                maxKey = datum.key;
+            numRows++;
+            if (datum.fidelity != groove_data::DatumFidelity::FIDELITY_VALID)
+                return;
+            if constexpr (hasSum()) {
+                sum += static_cast<SumType>(datum.value);
+            }
+            if constexpr (hasNaN()) {
+                if (std::isnan(datum.value)) {
+                    numValid++;
+                    numNaN++;
+                    return;
+                }
+            }
+            if (numBounded() == 0 || datum.value < minValue)
+                minValue = datum.value;
+            if (numBounded() == 0 || maxValue < datum.value)
+                maxValue = datum.value;
+            numValid++;
+        }
+
+        /**
+         *
+         * @param other
+         */
+        void
+        merge(const PageStatistics &other)
+        {
+            if (other.numRows > 0) {
+                if (numRows == 0 || other.minKey < minKey)
+                    minKey = other.minKey;
+                if (numRows == 0 || maxKey < other.maxKey)
+                    maxKey = other.maxKey;
+                numRows += other.numRows;
+            }
+            if (other.numBounded() > 0) {
+                if (numBounded() == 0 || other.minValue < minValue)
+                    minValue = other.minValue;
+                if (numBounded() == 0 || maxValue < other.maxValue)
+                    maxValue = other.maxValue;
+            }
+            numValid += other.numValid;
+            numNaN += other.numNaN;
+            sum += other.sum;
+        }
+
+        /**
+         * Returns a copy of the schema with the statistics attached to the key and value fields.
+         *
+         * @param schema
+         * @param keyFieldIndex
+         * @param valFieldIndex
+         * @return
+         */
+        std::shared_ptr<arrow::Schema>
+        annotateSchema(std::shared_ptr<arrow::Schema> schema, int keyFieldIndex, int valFieldIndex) const
+        {
+            TU_ASSERT (schema != nullptr);
+
+            std::vector<std::string> keyKeys = {kStatisticsRowsKey};
+            std::vector<std::string> keyValues = {encode_statistic(numRows)};
+            if (numRows > 0) {
+                keyKeys.insert(keyKeys.end(), {kStatisticsMinKey, kStatisticsMaxKey});
+                keyValues.insert(keyValues.end(), {encode_statistic(minKey), encode_statistic(maxKey)});
+            }
+            std::vector<std::string> valKeys = {kStatisticsValidKey};
+            std::vector<std::string> valValues = {encode_statistic(numValid)};
+            if (numBounded() > 0) {
+                valKeys.insert(valKeys.end(), {kStatisticsMinKey, kStatisticsMaxKey});
+                valValues.insert(valValues.end(), {encode_statistic(minValue), encode_statistic(maxValue)});
+            }
+            if (numNaN > 0) {
+                valKeys.push_back(kStatisticsNaNKey);
+                valValues.push_back(encode_statistic(numNaN));
+            }
+            if (numValid > 0) {
+                if constexpr (hasSum()) {
+                    valKeys.push_back(sumKey());
+                    valValues.push_back(encode_statistic(sum));
+                }
+            }
+
+            auto fields = schema->fields();
+            fields[keyFieldIndex] = fields[keyFieldIndex]->WithMergedMetadata(
+                arrow::key_value_metadata(keyKeys, keyValues));
+            fields[valFieldIndex] = fields[valFieldIndex]->WithMergedMetadata(
+                arrow::key_value_metadata(valKeys, valValues));
+            return arrow::schema(fields, schema->metadata());
+        }
+
+        /**
+         * Reads the statistics attached to the key and value fields of the schema. Returns an
+         * empty option if the schema does not carry complete statistics.
+         *
+         * @param schema
+         * @param keyFieldIndex
+         * @param valFieldIndex
+         * @return
+         */
+        static Option<PageStatistics>
+        fromSchema(const arrow::Schema &schema, int keyFieldIndex, int valFieldIndex)
+        {
+            if (keyFieldIndex < 0 || schema.num_fields() <= keyFieldIndex)
+                return {};
+            if (valFieldIndex < 0 || schema.num_fields() <= valFieldIndex)
+                return {};
+            auto keyMetadata = schema.field(keyFieldIndex)->metadata();
+            auto valMetadata = schema.field(valFieldIndex)->metadata();
+            if (keyMetadata == nullptr || valMetadata == nullptr)
+                return {};
+
+            auto decode = [](const arrow::KeyValueMetadata &metadata, const char *key, auto &value) {
+                auto index = metadata.FindKey(key);
+                return index >= 0 && decode_statistic(metadata.value(index), value);
+            };
+
+            PageStatistics statistics;
+            if (!decode(*keyMetadata, kStatisticsRowsKey, statistics.numRows))
+                return {};
+            if (statistics.numRows > 0) {
+                if (!decode(*keyMetadata, kStatisticsMinKey, statistics.minKey))
+                    return {};
+                if (!decode(*keyMetadata, kStatisticsMaxKey, statistics.maxKey))
+                    return {};
+            }
+            if (!decode(*valMetadata, kStatisticsValidKey, statistics.numValid))
+                return {};
+            // the NaN count is omitted when there are no NaN values
+            if (valMetadata->FindKey(kStatisticsNaNKey) >= 0) {
+                if (!decode(*valMetadata, kStatisticsNaNKey, statistics.numNaN))
+                    return {};
+                if (statistics.numNaN < 0 || statistics.numValid < statistics.numNaN)
+                    return {};
+            }
+            if (statistics.numBounded() > 0) {
+                if (!decode(*valMetadata, kStatisticsMinKey, statistics.minValue))
+                    return {};
+                if (!decode(*valMetadata, kStatisticsMaxKey, statistics.maxValue))
+                    return {};
+            }
+            if (statistics.numValid > 0) {
+                if constexpr (hasSum()) {
+                    if (!decode(*valMetadata, sumKey(), statistics.sum))
+                        return {};
+                }
+            }
+            return Option<PageStatistics>(statistics);
+        }
+
+        /**
+         *
+         * @param vector
+         * @return
+         */
+        static PageStatistics
+        fromVector(const VectorType &vector)
+        {
+            PageStatistics statistics;
+            auto iterator = vector.iterator();
+            DatumType datum;
+            while (iterator.getNext(datum)) {
+                statistics.update(datum);
+            }
+            return statistics;
+        }
+    };
+}
+
+#endif // GROOVE_MODEL_PAGE_STATISTICS_H
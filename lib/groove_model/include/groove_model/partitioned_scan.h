@@ -0,0 +1,52 @@
+#ifndef GROOVE_MODEL_PARTITIONED_SCAN_H
+#define GROOVE_MODEL_PARTITIONED_SCAN_H
+
+#include <functional>
+#include <memory>
+
+#include <tempo_utils/status.h>
+
+#include "scan_executor.h"
+
+namespace groove_model {
+
+    // a range is split into this many partitions per thread, so that a thread which finishes
+    // its partitions early can take on the remaining partitions of slower threads
+    constexpr int kPartitionsPerThread = 4;
+
+    // a single scan uses at most this many threads, so that concurrent scans share the executor
+    // rather than each one claiming every worker
+    constexpr int kMaxScanThreads = 8;
+
+    /**
+     * Returns the number of threads to scan with when the caller has no preference, which is
+     * the number of hardware threads up to kMaxScanThreads.
+     *
+     * @return
+     */
+    int default_scan_threads();
+
+    /**
+     * Runs task for each index from 0 to numTasks - 1 on up to numThreads threads. One of the
+     * threads is the calling thread, and the others are jobs on the executor, or on the shared
+     * ScanExecutor if no executor is given, so no threads are started. Each thread claims the
+     * next unclaimed index when it finishes a task, so the tasks are balanced across the threads
+     * however unevenly they are sized, and since the calling thread keeps claiming tasks the run
+     * completes even if no worker of the executor is free. A single task is run on the calling
+     * thread without submitting any jobs. Once a task fails the unclaimed tasks are skipped, and
+     * the status of the failed task with the lowest index is returned.
+     *
+     * @param numTasks
+     * @param numThreads
+     * @param task
+     * @param executor
+     * @return
+     */
+    tempo_utils::Status run_partitioned(
+        int numTasks,
+        int numThreads,
+        const std::function<tempo_utils::Status(int)> &task,
+        std::shared_ptr<ScanExecutor> executor = {});
+}
+
+#endif // GROOVE_MODEL_PARTITIONED_SCAN_H
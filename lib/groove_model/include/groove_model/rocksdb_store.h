@@ -11,6 +11,16 @@
 
 namespace groove_model {
 
+    /**
+     * The meta key recording the encoding of the category keys of the pages in the store.
+     */
+    constexpr const char *kCategoryKeyEncodingMetaKey = "categoryKeyEncoding";
+
+    /**
+     * The current encoding of category keys, see kCategoryKeyTag.
+     */
+    constexpr const char *kCategoryKeyEncodingVersion = "2";
+
     class RocksDbStore : public AbstractPageStore, public std::enable_shared_from_this<RocksDbStore> {
 
     public:
@@ -98,6 +108,8 @@ namespace groove_model {
         rocksdb::Options m_options;
         rocksdb::DB *m_rocksDb;
 
+        rocksdb::Status migrateCategoryKeys();
+
         explicit RocksDbStore(const std::filesystem::path &dbPath);
         RocksDbStore(const std::filesystem::path &dbPath, const rocksdb::Options &options);
     };
@@ -0,0 +1,54 @@
+#ifndef GROOVE_MODEL_SCAN_EXECUTOR_H
+#define GROOVE_MODEL_SCAN_EXECUTOR_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <absl/synchronization/mutex.h>
+
+namespace groove_model {
+
+    /**
+     * A fixed pool of worker threads which runs the background work of column scans, such as
+     * page read-ahead and the partitions of a partitioned scan, so a scan does not start threads
+     * of its own. Jobs are run in submission order. A job may never run if every worker is busy,
+     * so a caller which waits on the result of a job must be able to do the work itself when the
+     * job has not started, as PageReadAhead and run_partitioned do. Destroying the executor
+     * drops the jobs which have not started and joins the workers.
+     */
+    class ScanExecutor {
+
+    public:
+        explicit ScanExecutor(int numWorkers);
+        ~ScanExecutor();
+
+        ScanExecutor(const ScanExecutor &other) = delete;
+        ScanExecutor &operator=(const ScanExecutor &other) = delete;
+
+        int numWorkers() const;
+
+        void submit(std::function<void()> job);
+
+        /**
+         * Returns the executor shared by every scan in the process, which has one worker per
+         * hardware thread. The shared executor is never destroyed.
+         *
+         * @return
+         */
+        static std::shared_ptr<ScanExecutor> shared();
+
+    private:
+        absl::Mutex m_lock;
+        std::deque<std::function<void()>> m_jobs ABSL_GUARDED_BY(m_lock);
+        bool m_shutdown ABSL_GUARDED_BY(m_lock);
+        std::vector<std::thread> m_workers;
+
+        bool hasJobOrShutdown() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(m_lock);
+        void runWorker();
+    };
+}
+
+#endif // GROOVE_MODEL_SCAN_EXECUTOR_H
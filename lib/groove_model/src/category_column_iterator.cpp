@@ -3,7 +3,6 @@
 #include <tempo_utils/log_stream.h>
 
 groove_model::CategoryDoubleColumnIterator::CategoryDoubleColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -11,25 +10,35 @@ groove_model::CategoryDoubleColumnIterator::CategoryDoubleColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::CategoryDoubleVector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::CategoryDoubleColumnIterator::getNext(groove_data::CategoryDoubleDatum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::CategoryDoubleColumnIterator::getNextBatch(groove_data::CategoryDoubleDatum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::CategoryDoubleColumnIterator::pageIdsBegin() const
 {
@@ -43,7 +52,6 @@ groove_model::CategoryDoubleColumnIterator::pageIdsEnd() const
 }
 
 groove_model::CategoryInt64ColumnIterator::CategoryInt64ColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -51,25 +59,35 @@ groove_model::CategoryInt64ColumnIterator::CategoryInt64ColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::CategoryInt64Vector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::CategoryInt64ColumnIterator::getNext(groove_data::CategoryInt64Datum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::CategoryInt64ColumnIterator::getNextBatch(groove_data::CategoryInt64Datum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::CategoryInt64ColumnIterator::pageIdsBegin() const
 {
@@ -83,7 +101,6 @@ groove_model::CategoryInt64ColumnIterator::pageIdsEnd() const
 }
 
 groove_model::CategoryStringColumnIterator::CategoryStringColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -91,25 +108,35 @@ groove_model::CategoryStringColumnIterator::CategoryStringColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::CategoryStringVector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::CategoryStringColumnIterator::getNext(groove_data::CategoryStringDatum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::CategoryStringColumnIterator::getNextBatch(groove_data::CategoryStringDatum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::CategoryStringColumnIterator::pageIdsBegin() const
 {
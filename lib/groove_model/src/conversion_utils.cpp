@@ -1,4 +1,8 @@
 
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+
 #include <groove_model/conversion_utils.h>
 #include <tempo_utils/big_endian.h>
 
@@ -73,6 +77,23 @@ groove_model::key_to_bytes(Option<tu_int64> key)
 
 std::string
 groove_model::key_to_bytes(const Option<groove_data::Category> key)
+{
+    if (key.isEmpty())
+        return std::string("\0");
+    groove_data::CompactCategory compact(key.getValue());
+    return absl::StrCat(std::string_view(&kCategoryKeyTag, 1), compact.getBytes());
+}
+
+std::string
+groove_model::key_to_bytes(const Option<groove_data::CompactCategory> key)
+{
+    if (key.isEmpty())
+        return std::string("\0");
+    return absl::StrCat(std::string_view(&kCategoryKeyTag, 1), key.getValue().getBytes());
+}
+
+std::string
+groove_model::legacy_key_to_bytes(const Option<groove_data::Category> key)
 {
     if (key.isEmpty())
         return std::string("\0");
@@ -96,3 +117,45 @@ groove_model::key_to_bytes(const Option<groove_data::Category> key)
     }
     return rangeKey;
 }
+
+bool
+groove_model::is_legacy_category_key(std::string_view keyBytes)
+{
+    return !keyBytes.empty() && keyBytes.front() != kCategoryKeyTag;
+}
+
+bool
+groove_model::legacy_bytes_to_category(std::string_view keyBytes, groove_data::Category &key)
+{
+    std::vector<std::string> segments;
+    while (!keyBytes.empty()) {
+        if (keyBytes.size() < 4)
+            return false;
+        union {
+            tu_uint32 size;
+            char bytes[4];
+        } src;
+        keyBytes.copy(src.bytes, 4);
+        tu_uint32 size = BE32_TO_H(src.size);
+        keyBytes.remove_prefix(4);
+        if (keyBytes.size() < size)
+            return false;
+        segments.emplace_back(keyBytes.substr(0, size));
+        keyBytes.remove_prefix(size);
+    }
+    // the legacy encoding of the empty category is a single zero length
+    if (segments.size() == 1 && segments.front().empty())
+        segments.clear();
+    key = groove_data::Category(segments);
+    return true;
+}
+
+bool
+groove_model::bytes_to_category(std::string_view keyBytes, groove_data::Category &key)
+{
+    if (keyBytes.empty() || keyBytes.front() != kCategoryKeyTag)
+        return false;
+    keyBytes.remove_prefix(1);
+    key = groove_data::CompactCategory::fromBytes(keyBytes).toCategory();
+    return true;
+}
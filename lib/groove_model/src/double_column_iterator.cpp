@@ -3,7 +3,6 @@
 #include <tempo_utils/log_stream.h>
 
 groove_model::DoubleDoubleColumnIterator::DoubleDoubleColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -11,25 +10,35 @@ groove_model::DoubleDoubleColumnIterator::DoubleDoubleColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::DoubleDoubleVector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::DoubleDoubleColumnIterator::getNext(groove_data::DoubleDoubleDatum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::DoubleDoubleColumnIterator::getNextBatch(groove_data::DoubleDoubleDatum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::DoubleDoubleColumnIterator::pageIdsBegin() const
 {
@@ -43,7 +52,6 @@ groove_model::DoubleDoubleColumnIterator::pageIdsEnd() const
 }
 
 groove_model::DoubleInt64ColumnIterator::DoubleInt64ColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -51,25 +59,35 @@ groove_model::DoubleInt64ColumnIterator::DoubleInt64ColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::DoubleInt64Vector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::DoubleInt64ColumnIterator::getNext(groove_data::DoubleInt64Datum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::DoubleInt64ColumnIterator::getNextBatch(groove_data::DoubleInt64Datum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::DoubleInt64ColumnIterator::pageIdsBegin() const
 {
@@ -83,7 +101,6 @@ groove_model::DoubleInt64ColumnIterator::pageIdsEnd() const
 }
 
 groove_model::DoubleStringColumnIterator::DoubleStringColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -91,25 +108,35 @@ groove_model::DoubleStringColumnIterator::DoubleStringColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::DoubleStringVector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::DoubleStringColumnIterator::getNext(groove_data::DoubleStringDatum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::DoubleStringColumnIterator::getNextBatch(groove_data::DoubleStringDatum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::DoubleStringColumnIterator::pageIdsBegin() const
 {
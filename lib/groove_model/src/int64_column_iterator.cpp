@@ -3,7 +3,6 @@
 #include <tempo_utils/log_stream.h>
 
 groove_model::Int64DoubleColumnIterator::Int64DoubleColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -11,25 +10,35 @@ groove_model::Int64DoubleColumnIterator::Int64DoubleColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::Int64DoubleVector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::Int64DoubleColumnIterator::getNext(groove_data::Int64DoubleDatum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::Int64DoubleColumnIterator::getNextBatch(groove_data::Int64DoubleDatum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::Int64DoubleColumnIterator::pageIdsBegin() const
 {
@@ -43,7 +52,6 @@ groove_model::Int64DoubleColumnIterator::pageIdsEnd() const
 }
 
 groove_model::Int64Int64ColumnIterator::Int64Int64ColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -51,25 +59,35 @@ groove_model::Int64Int64ColumnIterator::Int64Int64ColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::Int64Int64Vector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::Int64Int64ColumnIterator::getNext(groove_data::Int64Int64Datum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::Int64Int64ColumnIterator::getNextBatch(groove_data::Int64Int64Datum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::Int64Int64ColumnIterator::pageIdsBegin() const
 {
@@ -83,7 +101,6 @@ groove_model::Int64Int64ColumnIterator::pageIdsEnd() const
 }
 
 groove_model::Int64StringColumnIterator::Int64StringColumnIterator()
-    : m_curr(-1)
 {
 }
 
@@ -91,25 +108,35 @@ groove_model::Int64StringColumnIterator::Int64StringColumnIterator(
     const std::forward_list<std::shared_ptr<groove_data::Int64StringVector>> &vectors,
     const std::vector<PageId> &pageIds)
     : m_vectors(vectors),
-      m_pageIds(pageIds),
-      m_curr(0)
+      m_pageIds(pageIds)
 {
 }
 
 bool
 groove_model::Int64StringColumnIterator::getNext(groove_data::Int64StringDatum &datum)
 {
-    if (m_vector == nullptr || m_vector->getSize() <= m_curr) {
+    while (!m_iterator.getNext(datum)) {
         if (m_vectors.empty())
             return false;
-        m_vector = m_vectors.front();
+        m_iterator = m_vectors.front()->iterator();
         m_vectors.pop_front();
-        m_curr = 0;
     }
-    datum = m_vector->getDatum(m_curr++);
     return true;
 }
 
+int
+groove_model::Int64StringColumnIterator::getNextBatch(groove_data::Int64StringDatum *batch, int batchSize)
+{
+    int count;
+    while ((count = m_iterator.getNextBatch(batch, batchSize)) == 0) {
+        if (m_vectors.empty())
+            return 0;
+        m_iterator = m_vectors.front()->iterator();
+        m_vectors.pop_front();
+    }
+    return count;
+}
+
 std::vector<groove_model::PageId>::const_iterator
 groove_model::Int64StringColumnIterator::pageIdsBegin() const
 {
@@ -214,6 +214,20 @@ groove_model::PageId::create(
         key_to_bytes(key));
 }
 
+groove_model::PageId
+groove_model::PageId::create(
+    const tempo_utils::Url &datasetUrl,
+    std::shared_ptr<const std::string> modelId,
+    std::shared_ptr<const std::string> columnId,
+    groove_data::DataValueType valueType,
+    groove_data::CollationMode collation,
+    Option<groove_data::CompactCategory> key)
+{
+    return create(datasetUrl, modelId, columnId,
+        groove_data::DataKeyType::KEY_CATEGORY, valueType, collation,
+        key_to_bytes(key));
+}
+
 groove_model::PageId
 groove_model::PageId::create(
     const tempo_utils::Url &datasetUrl,
@@ -250,7 +264,7 @@ groove_model::PageId::fromString(std::string_view s)
         return {};
     std::pair<int,int> prefixPart;
     prefixPart.first = 0;
-    prefixPart.second = endOfPrefixPart;
+    prefixPart.second = endOfPrefixPart + 1;
 
     int endOfTypePart = s.find('\x1e', endOfPrefixPart + 1);
     if (endOfTypePart < 0)
@@ -266,4 +280,60 @@ groove_model::PageId::fromString(std::string_view s)
     keyPart.second = s.size() - keyPart.first;
 
     return PageId(std::make_shared<const std::string>(s), prefixPart, typePart, keyPart);
-}
\ No newline at end of file
+}
+
+/**
+ * Locates the key part of the page id bytes, and returns true if the page id has a category key
+ * which is not absent.
+ */
+static bool
+find_category_key(std::string_view pageId, std::string_view::size_type &keyOffset)
+{
+    auto endOfPrefixPart = pageId.find('\x1e');
+    if (endOfPrefixPart == std::string_view::npos || pageId.size() < endOfPrefixPart + 5)
+        return false;
+    if (pageId[endOfPrefixPart + 4] != '\x1e')
+        return false;
+    if (pageId[endOfPrefixPart + 2] != groove_model::key_type_to_byte(groove_data::DataKeyType::KEY_CATEGORY))
+        return false;
+    keyOffset = endOfPrefixPart + 5;
+    return keyOffset < pageId.size();
+}
+
+bool
+groove_model::convert_legacy_category_page_id(std::string_view legacyId, std::string &pageId)
+{
+    std::string_view::size_type keyOffset;
+    if (!find_category_key(legacyId, keyOffset))
+        return false;
+    auto keyBytes = legacyId.substr(keyOffset);
+    if (!is_legacy_category_key(keyBytes))
+        return false;
+    groove_data::Category key;
+    if (!legacy_bytes_to_category(keyBytes, key))
+        return false;
+    pageId = absl::StrCat(legacyId.substr(0, keyOffset), key_to_bytes(Option<groove_data::Category>(key)));
+    return true;
+}
+
+bool
+groove_model::convert_category_page_id_to_legacy(std::string_view pageId, std::string &legacyId)
+{
+    std::string_view::size_type keyOffset;
+    if (!find_category_key(pageId, keyOffset))
+        return false;
+    groove_data::Category key;
+    if (!bytes_to_category(pageId.substr(keyOffset), key))
+        return false;
+    legacyId = absl::StrCat(pageId.substr(0, keyOffset), legacy_key_to_bytes(Option<groove_data::Category>(key)));
+    return true;
+}
+
+bool
+groove_model::page_id_follows_range(const PageId &pageId, const Option<PageId> &endPageId, bool endExclusive)
+{
+    if (endPageId.isEmpty())
+        return false;
+    const auto &end = endPageId.getValue();
+    return endExclusive? end <= pageId : end < pageId;
+}
@@ -0,0 +1,140 @@
+
+#include <charconv>
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_cat.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/dictionary.h>
+#include <arrow/ipc/reader.h>
+
+#include <groove_model/page_statistics.h>
+
+std::string
+groove_model::encode_statistic(tu_int64 value)
+{
+    return absl::StrCat(value);
+}
+
+std::string
+groove_model::encode_statistic(double value)
+{
+    // the shortest representation which round-trips exactly
+    char chars[32];
+    auto result = std::to_chars(chars, chars + sizeof(chars), value);
+    return std::string(chars, result.ptr);
+}
+
+std::string
+groove_model::encode_statistic(groove_math::Int128 value)
+{
+    // absl has no support for __int128, so the decimal digits are produced least significant
+    // first. the value is never negated, so the most negative value is encoded correctly too
+    if (value == 0)
+        return "0";
+    std::string digits;
+    auto negative = value < 0;
+    while (value != 0) {
+        auto digit = static_cast<int>(value % 10);
+        digits.push_back(static_cast<char>('0' + (negative? -digit : digit)));
+        value /= 10;
+    }
+    if (negative) {
+        digits.push_back('-');
+    }
+    return std::string(digits.crbegin(), digits.crend());
+}
+
+std::string
+groove_model::encode_statistic(const std::string &value)
+{
+    return value;
+}
+
+std::string
+groove_model::encode_statistic(const groove_data::Category &value)
+{
+    // each segment is prefixed with its length, so segments may contain any character
+    std::string bytes;
+    for (auto iterator = value.cbegin(); iterator != value.cend(); iterator++) {
+        const auto &segment = **iterator;
+        absl::StrAppend(&bytes, segment.size(), ":", segment);
+    }
+    return bytes;
+}
+
+bool
+groove_model::decode_statistic(std::string_view bytes, tu_int64 &value)
+{
+    return absl::SimpleAtoi(bytes, &value);
+}
+
+bool
+groove_model::decode_statistic(std::string_view bytes, double &value)
+{
+    auto result = std::from_chars(bytes.data(), bytes.data() + bytes.size(), value);
+    return result.ec == std::errc() && result.ptr == bytes.data() + bytes.size();
+}
+
+bool
+groove_model::decode_statistic(std::string_view bytes, groove_math::Int128 &value)
+{
+    auto negative = !bytes.empty() && bytes.front() == '-';
+    if (negative) {
+        bytes.remove_prefix(1);
+    }
+    // 38 digits always fit in 128 bits, and the sum of fewer than 2^63 int64 values never
+    // needs more than that
+    if (bytes.empty() || bytes.size() > 38)
+        return false;
+    groove_math::Int128 result = 0;
+    for (auto c : bytes) {
+        if (c < '0' || '9' < c)
+            return false;
+        auto digit = c - '0';
+        result = result * 10 + (negative? -digit : digit);
+    }
+    value = result;
+    return true;
+}
+
+bool
+groove_model::decode_statistic(std::string_view bytes, std::string &value)
+{
+    value = std::string(bytes);
+    return true;
+}
+
+bool
+groove_model::decode_statistic(std::string_view bytes, groove_data::Category &value)
+{
+    std::vector<std::string> segments;
+    while (!bytes.empty()) {
+        auto colon = bytes.find(':');
+        if (colon == std::string_view::npos)
+            return false;
+        size_t size;
+        if (!absl::SimpleAtoi(bytes.substr(0, colon), &size))
+            return false;
+        bytes.remove_prefix(colon + 1);
+        if (bytes.size() < size)
+            return false;
+        segments.emplace_back(bytes.substr(0, size));
+        bytes.remove_prefix(size);
+    }
+    value = groove_data::Category(segments);
+    return true;
+}
+
+tempo_utils::Result<std::shared_ptr<arrow::Schema>>
+groove_model::read_page_schema(std::shared_ptr<arrow::Buffer> buffer)
+{
+    TU_ASSERT (buffer != nullptr);
+
+    arrow::io::BufferReader bufferReader(buffer);
+    arrow::ipc::DictionaryMemo dictionaryMemo;
+    auto readSchemaResult = arrow::ipc::ReadSchema(&bufferReader, &dictionaryMemo);
+    if (!readSchemaResult.ok())
+        return ModelStatus::forCondition(ModelCondition::kModelInvariant,
+            "{}", readSchemaResult.status().ToString());
+    return *readSchemaResult;
+}
@@ -0,0 +1,98 @@
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <absl/synchronization/mutex.h>
+
+#include <groove_model/model_result.h>
+#include <groove_model/partitioned_scan.h>
+#include <tempo_utils/log_stream.h>
+
+int
+groove_model::default_scan_threads()
+{
+    return std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, kMaxScanThreads);
+}
+
+// the state of a run is shared with its jobs, which may start after the run has returned. by
+// then every task has been claimed, so a late job returns without calling the task.
+struct PartitionedRun {
+    const std::function<tempo_utils::Status(int)> *task;
+    int numTasks;
+    std::vector<tempo_utils::Status> statuses;
+    std::atomic<int> nextTask;
+    std::atomic<bool> failed;
+    absl::Mutex lock;
+    int numFinished ABSL_GUARDED_BY(lock);
+
+    bool
+    isFinished() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock)
+    {
+        return numFinished == numTasks;
+    }
+};
+
+static void
+run_tasks(PartitionedRun *run)
+{
+    for (;;) {
+        auto index = run->nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (index >= run->numTasks)
+            return;
+        // once a task has failed the remaining tasks are claimed without being run
+        if (!run->failed.load(std::memory_order_relaxed)) {
+            run->statuses[index] = (*run->task)(index);
+            if (run->statuses[index].notOk()) {
+                run->failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        absl::MutexLock locker(&run->lock);
+        run->numFinished++;
+    }
+}
+
+tempo_utils::Status
+groove_model::run_partitioned(
+    int numTasks,
+    int numThreads,
+    const std::function<tempo_utils::Status(int)> &task,
+    std::shared_ptr<ScanExecutor> executor)
+{
+    TU_ASSERT (numTasks >= 0);
+    TU_ASSERT (numThreads > 0);
+
+    if (numTasks == 1)
+        return task(0);
+
+    auto run = std::make_shared<PartitionedRun>();
+    run->task = &task;
+    run->numTasks = numTasks;
+    run->statuses.resize(numTasks, ModelStatus::ok());
+    run->nextTask = 0;
+    run->failed = false;
+    run->numFinished = 0;
+
+    // the calling thread is one of the workers
+    if (executor == nullptr) {
+        executor = ScanExecutor::shared();
+    }
+    auto numJobs = std::min(std::min(numThreads, numTasks) - 1, executor->numWorkers());
+    for (int i = 0; i < numJobs; i++) {
+        executor->submit([run]() { run_tasks(run.get()); });
+    }
+    run_tasks(run.get());
+
+    // wait for the tasks claimed by jobs to finish
+    {
+        absl::MutexLock locker(&run->lock);
+        run->lock.Await(absl::Condition(run.get(), &PartitionedRun::isFinished));
+    }
+
+    for (const auto &status : run->statuses) {
+        if (status.notOk())
+            return status;
+    }
+    return ModelStatus::ok();
+}
@@ -28,16 +28,54 @@ groove_model::RocksDbStore::getDbPath() const
     return m_dbPath;
 }
 
+inline rocksdb::Slice
+make_slice(const std::string &bytes)
+{
+    return rocksdb::Slice(bytes.data(), bytes.size());
+}
+
 rocksdb::Status
 groove_model::RocksDbStore::open()
 {
-    return rocksdb::DB::Open(m_options, m_dbPath, &m_rocksDb);
+    auto status = rocksdb::DB::Open(m_options, m_dbPath, &m_rocksDb);
+    if (!status.ok())
+        return status;
+    return migrateCategoryKeys();
 }
 
-inline rocksdb::Slice
-make_slice(const std::string &bytes)
+/**
+ * Rewrites the ids of pages with category keys in the legacy encoding to the current encoding.
+ * The migration is applied in a single write batch together with the meta key recording the
+ * encoding, so it runs at most once per store and a store is never left partially migrated.
+ */
+rocksdb::Status
+groove_model::RocksDbStore::migrateCategoryKeys()
 {
-    return rocksdb::Slice(bytes.data(), bytes.size());
+    rocksdb::Status status;
+    auto encoding = getMeta(&status, kCategoryKeyEncodingMetaKey);
+    if (status.ok() && encoding == kCategoryKeyEncodingVersion)
+        return status;
+    if (!status.ok() && !status.IsNotFound())
+        return status;
+
+    rocksdb::WriteBatch batch;
+    auto iterator = std::unique_ptr<rocksdb::Iterator>(m_rocksDb->NewIterator(rocksdb::ReadOptions()));
+    for (iterator->Seek(make_slice(std::string("/v/"))); iterator->Valid(); iterator->Next()) {
+        auto _key = iterator->key();
+        std::string_view key(_key.data(), _key.size());
+        if (!key.starts_with("/v/"))
+            break;
+        std::string pageId;
+        if (!convert_legacy_category_page_id(key.substr(3), pageId))
+            continue;
+        batch.Delete(_key);
+        batch.Put(make_slice(absl::StrCat("/v/", pageId)), iterator->value());
+    }
+    if (!iterator->status().ok())
+        return iterator->status();
+
+    setMeta(&status, kCategoryKeyEncodingMetaKey, kCategoryKeyEncodingVersion, &batch);
+    return applyBatch(&batch);
 }
 
 bool
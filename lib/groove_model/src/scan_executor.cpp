@@ -0,0 +1,74 @@
+
+#include <algorithm>
+
+#include <groove_model/scan_executor.h>
+#include <tempo_utils/log_stream.h>
+
+groove_model::ScanExecutor::ScanExecutor(int numWorkers)
+    : m_shutdown(false)
+{
+    TU_ASSERT (numWorkers >= 0);
+    for (int i = 0; i < numWorkers; i++) {
+        m_workers.emplace_back(&ScanExecutor::runWorker, this);
+    }
+}
+
+groove_model::ScanExecutor::~ScanExecutor()
+{
+    {
+        absl::MutexLock locker(&m_lock);
+        m_shutdown = true;
+        m_jobs.clear();
+    }
+    for (auto &worker : m_workers) {
+        worker.join();
+    }
+}
+
+int
+groove_model::ScanExecutor::numWorkers() const
+{
+    return m_workers.size();
+}
+
+void
+groove_model::ScanExecutor::submit(std::function<void()> job)
+{
+    TU_ASSERT (job != nullptr);
+    absl::MutexLock locker(&m_lock);
+    if (m_shutdown)
+        return;
+    m_jobs.push_back(std::move(job));
+}
+
+std::shared_ptr<groove_model::ScanExecutor>
+groove_model::ScanExecutor::shared()
+{
+    // the executor is leaked so that no worker is joined during static destruction
+    static auto *executor = new std::shared_ptr<ScanExecutor>(
+        std::make_shared<ScanExecutor>(std::max(1, static_cast<int>(std::thread::hardware_concurrency()))));
+    return *executor;
+}
+
+bool
+groove_model::ScanExecutor::hasJobOrShutdown() const
+{
+    return !m_jobs.empty() || m_shutdown;
+}
+
+void
+groove_model::ScanExecutor::runWorker()
+{
+    for (;;) {
+        std::function<void()> job;
+        {
+            absl::MutexLock locker(&m_lock);
+            m_lock.Await(absl::Condition(this, &ScanExecutor::hasJobOrShutdown));
+            if (m_shutdown)
+                return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
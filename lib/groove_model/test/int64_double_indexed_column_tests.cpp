@@ -0,0 +1,470 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <arrow/table_builder.h>
+#include <arrow/array/builder_primitive.h>
+
+#include <groove_math/bucket_reducer_template.h>
+#include <groove_math/sum_function.h>
+#include <groove_model/column_traits.h>
+#include <groove_model/indexed_column_template.h>
+#include <groove_model/indexed_column_writer_template.h>
+#include <groove_model/page_traits.h>
+#include <groove_model/rocksdb_store.h>
+#include <groove_model/scan_executor.h>
+#include <tempo_utils/tempdir_maker.h>
+
+class Int64DoubleIndexedColumnTest : public ::testing::Test {
+protected:
+    tempo_utils::Url datasetUrl;
+    std::shared_ptr<const std::string> columnId;
+    std::shared_ptr<groove_data::Int64DoubleVector> vector;
+
+    void SetUp() override {
+        datasetUrl = tempo_utils::Url::fromString("test://dataset");
+        columnId = std::make_shared<const std::string>("dbl");
+
+        auto keyField = arrow::field("", arrow::int64());
+        auto dblField = arrow::field(*columnId, arrow::float64());
+        auto emptyField = arrow::field("", arrow::boolean());
+        auto schema = arrow::schema({keyField, dblField, emptyField});
+        TU_ASSERT (schema != nullptr);
+
+        // keys -3 through 9 with value equal to the key, except key 4 which is missing
+        arrow::Int64Builder keyBuilder;
+        arrow::DoubleBuilder dblBuilder;
+        arrow::BooleanBuilder emptyBuilder;
+        for (tu_int64 key = -3; key < 10; key++) {
+            TU_ASSERT (keyBuilder.Append(key).ok());
+            if (key == 4) {
+                TU_ASSERT (dblBuilder.AppendNull().ok());
+            } else {
+                TU_ASSERT (dblBuilder.Append(key).ok());
+            }
+            TU_ASSERT (emptyBuilder.Append(false).ok());
+        }
+        auto buildKeyResult = keyBuilder.Finish();
+        TU_ASSERT (buildKeyResult.ok());
+        auto buildDblResult = dblBuilder.Finish();
+        TU_ASSERT (buildDblResult.ok());
+        auto buildEmptyResult = emptyBuilder.Finish();
+        TU_ASSERT (buildEmptyResult.ok());
+
+        auto table = arrow::Table::Make(schema, {*buildKeyResult, *buildDblResult, *buildEmptyResult}, 13);
+        vector = groove_data::Int64DoubleVector::create(table, 0, 1, 2);
+    }
+
+    // writes keys 0-9, 20-29, 40-49 and 60-69 as four separate pages, with value equal to the key
+    void writeSeparatePages(
+        std::shared_ptr<const std::string> modelId,
+        std::shared_ptr<groove_model::RocksDbStore> pageStore)
+    {
+        auto writer = groove_model::IndexedColumnWriter<groove_model::Int64Double>::create(
+            datasetUrl, modelId, columnId, pageStore);
+        auto schema = arrow::schema({
+            arrow::field("", arrow::int64()), arrow::field(*columnId, arrow::float64())});
+        for (tu_int64 start = 0; start < 80; start += 20) {
+            arrow::Int64Builder keyBuilder;
+            arrow::DoubleBuilder dblBuilder;
+            for (tu_int64 key = start; key < start + 10; key++) {
+                TU_ASSERT (keyBuilder.Append(key).ok());
+                TU_ASSERT (dblBuilder.Append(key).ok());
+            }
+            auto table = arrow::Table::Make(schema, {*keyBuilder.Finish(), *dblBuilder.Finish()}, 10);
+            auto status = writer->setValues(groove_data::Int64DoubleVector::create(table, 0, 1, -1));
+            TU_ASSERT (status.isOk());
+        }
+    }
+};
+
+TEST_F(Int64DoubleIndexedColumnTest, TestReduceBuckets)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    auto modelId = std::make_shared<const std::string>("test");
+    auto writer = IndexedColumnWriter<Int64Double>::create(datasetUrl, modelId, columnId, pageStore);
+    auto status = writer->setValues(vector);
+    ASSERT_TRUE(status.isOk());
+
+    auto column = IndexedColumn<Int64Double>::create(datasetUrl, modelId, columnId, pageStore);
+
+    // buckets of width 5 aligned on 0, so the page straddles buckets and is decoded
+    groove_data::Int64Range range;
+    range.start = Option<tu_int64>(-2);
+    range.start_exclusive = false;
+    groove_math::BucketReducer<tu_int64, double, groove_math::Sum, groove_math::Maximum, groove_math::SampleCount>
+        reducer({0, 5}, {0.0, 0.0, 0.0});
+    status = column->reduceBuckets(range, reducer);
+    ASSERT_TRUE (status.isOk());
+
+    auto rows = reducer.finalize();
+    ASSERT_EQ (3, rows.size());
+    ASSERT_EQ (-5, rows[0].start);
+    ASSERT_EQ (0, rows[0].end);
+    ASSERT_EQ (std::vector<double>({-3.0, -1.0, 2.0}), rows[0].values);
+    ASSERT_EQ (0, rows[1].start);
+    ASSERT_EQ (std::vector<double>({6.0, 3.0, 4.0}), rows[1].values);
+    ASSERT_EQ (5, rows[2].start);
+    ASSERT_EQ (std::vector<double>({35.0, 9.0, 5.0}), rows[2].values);
+
+    // a single bucket covering the whole page is accumulated from the page statistics
+    groove_math::BucketReducer<tu_int64, double, groove_math::Average, groove_math::Minimum>
+        wide({-50, 100}, {0.0, 0.0});
+    status = column->reduceBuckets(groove_data::Int64Range(), wide);
+    ASSERT_TRUE (status.isOk());
+
+    rows = wide.finalize();
+    ASSERT_EQ (1, rows.size());
+    ASSERT_EQ (-50, rows[0].start);
+    ASSERT_DOUBLE_EQ (35.0 / 12.0, rows[0].values[0]);
+    ASSERT_DOUBLE_EQ (-3.0, rows[0].values[1]);
+
+    // a histogram per bucket with bins [0, 2), [2, 4) and [4, 6)
+    groove_math::BucketHistogram<tu_int64> histograms({0, 5}, groove_math::Histogram::equiWidth(0.0, 2.0, 3));
+    status = column->reduceBuckets(range, histograms);
+    ASSERT_TRUE (status.isOk());
+
+    auto histogramRows = histograms.finalize();
+    ASSERT_EQ (3, histogramRows.size());
+    ASSERT_EQ (2, histogramRows[0].histogram.getUnderflow());
+    ASSERT_EQ (0, histogramRows[0].histogram.getCount(0));
+    ASSERT_EQ (2, histogramRows[1].histogram.getCount(0));
+    ASSERT_EQ (2, histogramRows[1].histogram.getCount(1));
+    ASSERT_EQ (1, histogramRows[2].histogram.getCount(2));
+    ASSERT_EQ (4, histogramRows[2].histogram.getOverflow());
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
+
+TEST_F(Int64DoubleIndexedColumnTest, TestReadAheadMatchesSerialScan)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    auto modelId = std::make_shared<const std::string>("test");
+    writeSeparatePages(modelId, pageStore);
+
+    auto column = IndexedColumn<Int64Double>::create(datasetUrl, modelId, columnId, pageStore);
+
+    groove_data::Int64Range range;
+    range.start = Option<tu_int64>(5);
+    range.start_exclusive = false;
+    range.end = Option<tu_int64>(45);
+    range.end_exclusive = true;
+
+    // a depth of one page makes the reader wait on the consumer between pages
+    ReadAheadOptions options;
+    options.depth = 1;
+    auto readAheadResult = column->readAhead(range, options);
+    ASSERT_TRUE (readAheadResult.isResult());
+    auto pages = readAheadResult.getResult();
+
+    std::vector<tu_int64> keys;
+    PageReadAhead<Int64Double>::Page page;
+    int numPages = 0;
+    while (pages->getNext(page)) {
+        numPages++;
+        ASSERT_TRUE (page.vector != nullptr);
+        groove_data::Int64DoubleDatum datum;
+        auto iterator = page.vector->iterator();
+        while (iterator.getNext(datum)) {
+            ASSERT_DOUBLE_EQ (datum.key, datum.value);
+            keys.push_back(datum.key);
+        }
+    }
+    ASSERT_TRUE (pages->getStatus().isOk());
+    ASSERT_EQ (3, numPages);
+    ASSERT_EQ (25, keys.size());
+    ASSERT_EQ (5, keys.front());
+    ASSERT_EQ (44, keys.back());
+
+    auto getSerialResult = column->getVectors(range);
+    ASSERT_TRUE (getSerialResult.isResult());
+    auto serial = getSerialResult.getResult();
+
+    // the read-ahead generator yields each vector as soon as its page has been read
+    auto prefetched = column->generateVectors(range, ReadAheadOptions());
+    std::shared_ptr<groove_data::Int64DoubleVector> vector;
+    size_t numPrefetched = 0;
+    while (prefetched.getNext(vector)) {
+        ASSERT_LT (numPrefetched, serial.size());
+        ASSERT_EQ (serial[numPrefetched]->getSize(), vector->getSize());
+        numPrefetched++;
+    }
+    ASSERT_TRUE (prefetched.getStatus().isOk());
+    ASSERT_EQ (serial.size(), numPrefetched);
+
+    // the generator fetches each page when the next vector is requested
+    auto generated = column->generateVectors(range);
+    size_t numGenerated = 0;
+    while (generated.getNext(vector)) {
+        ASSERT_LT (numGenerated, serial.size());
+        ASSERT_EQ (serial[numGenerated]->getSize(), vector->getSize());
+        numGenerated++;
+    }
+    ASSERT_TRUE (generated.getStatus().isOk());
+    ASSERT_EQ (serial.size(), numGenerated);
+
+    // an executor without workers never runs the reader, so the consumer reads every page,
+    // and the page inside the range is summarized without being decoded
+    ReadAheadOptions inlineOptions;
+    inlineOptions.executor = std::make_shared<ScanExecutor>(0);
+    readAheadResult = column->readAhead(range, inlineOptions, [](const PageStatistics<Int64Double> &) {
+        return true;
+    });
+    ASSERT_TRUE (readAheadResult.isResult());
+    pages = readAheadResult.getResult();
+    std::vector<tu_int64> pageSizes;
+    while (pages->getNext(page)) {
+        pageSizes.push_back(page.vector != nullptr? page.vector->getSize() : page.statistics.numRows);
+        if (page.vector == nullptr) {
+            ASSERT_EQ (20, page.statistics.minKey);
+        }
+    }
+    ASSERT_TRUE (pages->getStatus().isOk());
+    ASSERT_EQ (std::vector<tu_int64>({5, 10, 5}), pageSizes);
+
+    // destroying a read-ahead which still has pages to read stops the reader
+    readAheadResult = column->readAhead(groove_data::Int64Range(), options);
+    ASSERT_TRUE (readAheadResult.isResult());
+    ASSERT_TRUE (readAheadResult.getResult()->getNext(page));
+    readAheadResult = column->readAhead(range, options);
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
+
+TEST_F(Int64DoubleIndexedColumnTest, TestPartitionedScanMatchesSerialScan)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    auto modelId = std::make_shared<const std::string>("test");
+    writeSeparatePages(modelId, pageStore);
+
+    auto column = IndexedColumn<Int64Double>::create(datasetUrl, modelId, columnId, pageStore);
+
+    groove_data::Int64Range range;
+    range.start = Option<tu_int64>(5);
+    range.start_exclusive = true;
+    range.end = Option<tu_int64>(60);
+    range.end_exclusive = true;
+
+    // the page starting at 60 is excluded by the range, so the boundaries are 20 and 40
+    auto partitionRangeResult = column->partitionRange(range, 8);
+    ASSERT_TRUE (partitionRangeResult.isResult());
+    auto partitions = partitionRangeResult.getResult();
+    ASSERT_EQ (3, partitions.size());
+    ASSERT_EQ (5, partitions[0].start.getValue());
+    ASSERT_TRUE (partitions[0].start_exclusive);
+    ASSERT_EQ (20, partitions[0].end.getValue());
+    ASSERT_TRUE (partitions[0].end_exclusive);
+    ASSERT_EQ (20, partitions[1].start.getValue());
+    ASSERT_FALSE (partitions[1].start_exclusive);
+    ASSERT_EQ (40, partitions[2].start.getValue());
+    ASSERT_EQ (60, partitions[2].end.getValue());
+    ASSERT_TRUE (partitions[2].end_exclusive);
+
+    partitionRangeResult = column->partitionRange(range, 1);
+    ASSERT_TRUE (partitionRangeResult.isResult());
+    ASSERT_EQ (1, partitionRangeResult.getResult().size());
+
+    // a range within a single page is not partitioned
+    groove_data::Int64Range pageRange;
+    pageRange.start = Option<tu_int64>(22);
+    pageRange.end = Option<tu_int64>(28);
+    partitionRangeResult = column->partitionRange(pageRange, 8);
+    ASSERT_TRUE (partitionRangeResult.isResult());
+    ASSERT_EQ (1, partitionRangeResult.getResult().size());
+
+    // an unbounded range is split at the first key of every page after the first
+    partitionRangeResult = column->partitionRange(groove_data::Int64Range(), 8);
+    ASSERT_TRUE (partitionRangeResult.isResult());
+    partitions = partitionRangeResult.getResult();
+    ASSERT_EQ (4, partitions.size());
+    ASSERT_TRUE (partitions[0].start.isEmpty());
+    ASSERT_EQ (20, partitions[0].end.getValue());
+    ASSERT_EQ (60, partitions[3].start.getValue());
+    ASSERT_TRUE (partitions[3].end.isEmpty());
+
+    auto getVectorsResult = column->getVectorsPartitioned(range, 3);
+    ASSERT_TRUE (getVectorsResult.isResult());
+    std::vector<tu_int64> keys;
+    for (const auto &vector : getVectorsResult.getResult()) {
+        groove_data::Int64DoubleDatum datum;
+        auto iterator = vector->iterator();
+        while (iterator.getNext(datum)) {
+            keys.push_back(datum.key);
+        }
+    }
+    ASSERT_EQ (24, keys.size());
+    ASSERT_TRUE (std::is_sorted(keys.cbegin(), keys.cend()));
+    ASSERT_EQ (6, keys.front());
+    ASSERT_EQ (49, keys.back());
+
+    auto summarizeResult = column->summarizePartitioned(range, 3);
+    ASSERT_TRUE (summarizeResult.isResult());
+    auto summary = summarizeResult.getResult();
+    ASSERT_EQ (24, summary.numRows);
+    ASSERT_DOUBLE_EQ (6.0 + 7.0 + 8.0 + 9.0 + 245.0 + 445.0, summary.sum);
+
+    // buckets of width 25 straddle the partition boundary at 40, and merge to the serial result
+    groove_math::BucketReducer<tu_int64, double, groove_math::Sum, groove_math::SampleCount>
+        serial({0, 25}, {0.0, 0.0});
+    ASSERT_TRUE (column->reduceBuckets(range, serial).isOk());
+    auto partitioned = serial.emptyCopy();
+    ASSERT_TRUE (column->reduceBucketsPartitioned(range, partitioned, 3).isOk());
+    auto serialRows = serial.finalize();
+    auto partitionedRows = partitioned.finalize();
+    ASSERT_EQ (2, partitionedRows.size());
+    ASSERT_EQ (serialRows.size(), partitionedRows.size());
+    for (size_t i = 0; i < serialRows.size(); i++) {
+        ASSERT_EQ (serialRows[i].start, partitionedRows[i].start);
+        ASSERT_EQ (serialRows[i].values, partitionedRows[i].values);
+    }
+
+    auto reduceResult = column->reducePartitioned<groove_math::SumFunction>(range, 3);
+    ASSERT_TRUE (reduceResult.isResult());
+    auto sumOption = groove_math::SumFunction::finalize(reduceResult.getResult());
+    ASSERT_DOUBLE_EQ (summary.sum, sumOption.getValue());
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
+
+TEST_F(Int64DoubleIndexedColumnTest, TestSetValuesSplitsPages)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    auto modelId = std::make_shared<const std::string>("test");
+    PageSizeOptions options;
+    options.maxRows = 4;
+    auto writer = IndexedColumnWriter<Int64Double>::create(datasetUrl, modelId, columnId, pageStore, options);
+
+    // the 13 rows are split into pages starting at -3, 1, 5 and 9
+    ASSERT_TRUE (writer->setValues(vector).isOk());
+    auto pageExists = [&](tu_int64 key) {
+        auto pageId = PageId::create<Int64Double,groove_data::CollationMode::COLLATION_INDEXED>(
+            datasetUrl, modelId, columnId, Option<tu_int64>(key));
+        return pageStore->pageExists(pageId).isOk();
+    };
+    ASSERT_TRUE (pageExists(-3));
+    ASSERT_TRUE (pageExists(1));
+    ASSERT_TRUE (pageExists(5));
+    ASSERT_TRUE (pageExists(9));
+    ASSERT_FALSE (pageExists(0));
+
+    // an update inside the page starting at 1 rewrites that page and keeps its other rows, and
+    // an update before the first page is written as a new page
+    auto schema = arrow::schema({arrow::field("", arrow::int64()), arrow::field(*columnId, arrow::float64())});
+    auto makeUpdate = [&](std::vector<tu_int64> keys) {
+        arrow::Int64Builder keyBuilder;
+        arrow::DoubleBuilder dblBuilder;
+        TU_ASSERT (keyBuilder.AppendValues(keys).ok());
+        for (auto key : keys) {
+            TU_ASSERT (dblBuilder.Append(key * 100).ok());
+        }
+        auto table = arrow::Table::Make(schema, {*keyBuilder.Finish(), *dblBuilder.Finish()}, keys.size());
+        return groove_data::Int64DoubleVector::create(table, 0, 1, -1);
+    };
+    ASSERT_TRUE (writer->setValues(makeUpdate({2, 3})).isOk());
+    ASSERT_TRUE (writer->setValues(makeUpdate({-10})).isOk());
+    ASSERT_TRUE (pageExists(-10));
+    ASSERT_TRUE (pageExists(1));
+
+    // an append after the undersized page starting at 9 is merged into it, and an update before
+    // the undersized page starting at -10 takes its rows
+    ASSERT_TRUE (writer->setValues(makeUpdate({10})).isOk());
+    ASSERT_TRUE (pageExists(9));
+    ASSERT_FALSE (pageExists(10));
+    ASSERT_TRUE (writer->setValues(makeUpdate({-20})).isOk());
+    ASSERT_TRUE (pageExists(-20));
+    ASSERT_FALSE (pageExists(-10));
+
+    auto column = IndexedColumn<Int64Double>::create(datasetUrl, modelId, columnId, pageStore);
+    auto getValuesResult = column->getValues(groove_data::Int64Range());
+    ASSERT_TRUE (getValuesResult.isResult());
+    auto values = getValuesResult.getResult();
+
+    std::vector<tu_int64> keys;
+    groove_data::Int64DoubleDatum datum;
+    while (values.getNext(datum)) {
+        keys.push_back(datum.key);
+        if (datum.key == 2 || datum.key == 3 || datum.key == -10 || datum.key == -20 || datum.key == 10) {
+            ASSERT_DOUBLE_EQ (datum.key * 100, datum.value);
+        } else if (datum.key != 4) {
+            ASSERT_DOUBLE_EQ (datum.key, datum.value);
+        }
+    }
+    ASSERT_EQ (std::vector<tu_int64>({-20, -10, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}), keys);
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
+
+TEST_F(Int64DoubleIndexedColumnTest, TestStatisticsExcludeNaNFromBounds)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    // the value of the first row is NaN
+    auto modelId = std::make_shared<const std::string>("test");
+    auto writer = IndexedColumnWriter<Int64Double>::create(datasetUrl, modelId, columnId, pageStore);
+    auto schema = arrow::schema({
+        arrow::field("", arrow::int64()), arrow::field(*columnId, arrow::float64())});
+    arrow::Int64Builder keyBuilder;
+    ASSERT_TRUE (keyBuilder.AppendValues({0, 1, 2}).ok());
+    arrow::DoubleBuilder dblBuilder;
+    ASSERT_TRUE (dblBuilder.AppendValues({std::nan(""), 2.0, 1.0}).ok());
+    auto table = arrow::Table::Make(schema, {*keyBuilder.Finish(), *dblBuilder.Finish()}, 3);
+    ASSERT_TRUE (writer->setValues(groove_data::Int64DoubleVector::create(table, 0, 1, -1)).isOk());
+
+    auto pageId = PageId::create<Int64Double,groove_data::CollationMode::COLLATION_INDEXED>(
+        datasetUrl, modelId, columnId, Option<tu_int64>(0));
+    auto getPageDataResult = pageStore->getPageData(pageId);
+    ASSERT_TRUE (getPageDataResult.isResult());
+    auto statisticsOption = IndexedPage<Int64Double>::readStatistics(getPageDataResult.getResult());
+    ASSERT_FALSE (statisticsOption.isEmpty());
+    auto statistics = statisticsOption.getValue();
+    ASSERT_EQ (statistics.numRows, 3);
+    ASSERT_EQ (statistics.numValid, 3);
+    ASSERT_EQ (statistics.numNaN, 1);
+    ASSERT_EQ (statistics.minValue, 1.0);
+    ASSERT_EQ (statistics.maxValue, 2.0);
+
+    // merging keeps the bounds of the values which are not NaN
+    PageStatistics<Int64Double> merged;
+    merged.update(groove_data::Int64DoubleDatum{3, std::nan(""), groove_data::DatumFidelity::FIDELITY_VALID});
+    merged.merge(statistics);
+    ASSERT_EQ (merged.numValid, 4);
+    ASSERT_EQ (merged.numNaN, 2);
+    ASSERT_EQ (merged.minValue, 1.0);
+    ASSERT_EQ (merged.maxValue, 2.0);
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
@@ -3,6 +3,9 @@
 #include <arrow/table_builder.h>
 #include <arrow/array/builder_primitive.h>
 
+#include <groove_math/bucket_reducer_template.h>
+#include <groove_math/int64_average_function.h>
+#include <groove_math/int64_sum_function.h>
 #include <groove_model/column_traits.h>
 #include <groove_model/indexed_column_template.h>
 #include <groove_model/indexed_column_writer_template.h>
@@ -104,4 +107,192 @@ TEST_F(Int64Int64IndexedColumnTest, TestSetAndGetValues)
     ASSERT_FALSE (values.getNext(datum));
 
     std::filesystem::remove_all(tempdirMaker.getTempdir());
-}
\ No newline at end of file
+}
+
+TEST_F(Int64Int64IndexedColumnTest, TestPageStatistics)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    auto modelId = std::make_shared<const std::string>("test");
+    auto writer = IndexedColumnWriter<Int64Int64>::create(datasetUrl, modelId, columnId, pageStore);
+    auto status = writer->setValues(vector);
+    ASSERT_TRUE(status.isOk());
+
+    // the statistics are readable from the stored page without decoding it
+    auto pageId = PageId::create<Int64Int64,groove_data::CollationMode::COLLATION_INDEXED>(
+        datasetUrl, modelId, columnId, Option<tu_int64>(0));
+    auto getPageDataResult = pageStore->getPageData(pageId);
+    ASSERT_TRUE (getPageDataResult.isResult());
+    auto statisticsOption = IndexedPage<Int64Int64>::readStatistics(getPageDataResult.getResult());
+    ASSERT_FALSE (statisticsOption.isEmpty());
+    auto statistics = statisticsOption.getValue();
+    ASSERT_EQ (statistics.numRows, 3);
+    ASSERT_EQ (statistics.numValid, 3);
+    ASSERT_EQ (statistics.minKey, 0);
+    ASSERT_EQ (statistics.maxKey, 2);
+    ASSERT_EQ (statistics.minValue, 4);
+    ASSERT_EQ (statistics.maxValue, 6);
+    ASSERT_TRUE (statistics.sum == 15);
+
+    auto column = IndexedColumn<Int64Int64>::create(datasetUrl, modelId, columnId, pageStore);
+
+    // a range covering the whole page is answered from the page statistics
+    groove_data::Int64Range range;
+    auto summarizeResult = column->summarize(range);
+    ASSERT_TRUE (summarizeResult.isResult());
+    auto summary = summarizeResult.getResult();
+    ASSERT_EQ (summary.numRows, 3);
+    ASSERT_TRUE (summary.sum == 15);
+
+    // a range covering part of the page decodes it
+    range.start = Option<tu_int64>(1);
+    range.end = Option<tu_int64>(2);
+    range.end_exclusive = false;
+    summarizeResult = column->summarize(range);
+    ASSERT_TRUE (summarizeResult.isResult());
+    summary = summarizeResult.getResult();
+    ASSERT_EQ (summary.numRows, 2);
+    ASSERT_EQ (summary.numValid, 2);
+    ASSERT_EQ (summary.minKey, 1);
+    ASSERT_EQ (summary.maxValue, 6);
+    ASSERT_TRUE (summary.sum == 11);
+
+    // a range after the page is empty
+    range.start = Option<tu_int64>(3);
+    range.end = {};
+    summarizeResult = column->summarize(range);
+    ASSERT_TRUE (summarizeResult.isResult());
+    ASSERT_EQ (summarizeResult.getResult().numRows, 0);
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
+
+TEST_F(Int64Int64IndexedColumnTest, TestReducePartitioned)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    // writes keys 0-9, 20-29, 40-49 and 60-69 as four separate pages, with value 2^53 plus the
+    // key, so a sum over doubles would lose the low bits of every value
+    const tu_int64 large = tu_int64(1) << 53;
+    auto modelId = std::make_shared<const std::string>("test");
+    auto writer = IndexedColumnWriter<Int64Int64>::create(datasetUrl, modelId, columnId, pageStore);
+    auto schema = arrow::schema({
+        arrow::field("", arrow::int64()), arrow::field(*columnId, arrow::int64())});
+    for (tu_int64 start = 0; start < 80; start += 20) {
+        arrow::Int64Builder keyBuilder;
+        arrow::Int64Builder i64Builder;
+        for (tu_int64 key = start; key < start + 10; key++) {
+            ASSERT_TRUE (keyBuilder.Append(key).ok());
+            ASSERT_TRUE (i64Builder.Append(large + key).ok());
+        }
+        auto table = arrow::Table::Make(schema, {*keyBuilder.Finish(), *i64Builder.Finish()}, 10);
+        ASSERT_TRUE (writer->setValues(groove_data::Int64Int64Vector::create(table, 0, 1, -1)).isOk());
+    }
+
+    auto column = IndexedColumn<Int64Int64>::create(datasetUrl, modelId, columnId, pageStore);
+
+    // keys 6-9, 20-29 and 40-49
+    groove_data::Int64Range range;
+    range.start = Option<tu_int64>(5);
+    range.start_exclusive = true;
+    range.end = Option<tu_int64>(60);
+    range.end_exclusive = true;
+    const tu_int64 keySum = 6 + 7 + 8 + 9 + 245 + 445;
+
+    auto sumResult = column->reducePartitioned<groove_math::Int64SumFunction>(range, 3);
+    ASSERT_TRUE (sumResult.isResult());
+    auto sumState = sumResult.getResult();
+    ASSERT_EQ (24, sumState.count);
+    ASSERT_TRUE (groove_math::Int64SumFunction::validate(sumState).isOk());
+    ASSERT_TRUE (sumState.sum == groove_math::Int128(large) * 24 + keySum);
+
+    // the stored page statistics carry the exact sum, so whole pages are summarized exactly
+    auto summarizeResult = column->summarizePartitioned(range, 3);
+    ASSERT_TRUE (summarizeResult.isResult());
+    auto summary = summarizeResult.getResult();
+    ASSERT_EQ (24, summary.numValid);
+    ASSERT_TRUE (summary.sum == groove_math::Int128(large) * 24 + keySum);
+
+    auto averageResult = column->reducePartitioned<groove_math::Int64AverageFunction>(range, 3);
+    ASSERT_TRUE (averageResult.isResult());
+    auto averageOption = groove_math::Int64AverageFunction::finalize(averageResult.getResult());
+    ASSERT_FALSE (averageOption.isEmpty());
+    ASSERT_DOUBLE_EQ (static_cast<double>(large) + keySum / 24.0, averageOption.getValue());
+
+    // int64 values are reduced by the int64 functions, so each bucket sum is exact and is only
+    // rounded when it is converted to double. the page of keys 40-49 lies inside the second
+    // bucket and is accumulated from the exact sum in its statistics
+    groove_math::BucketReducer<tu_int64, tu_int64, groove_math::Sum, groove_math::Minimum, groove_math::SampleCount>
+        reducer({0, 25}, {0.0, 0.0, 0.0});
+    ASSERT_TRUE (column->reduceBucketsPartitioned(range, reducer, 3).isOk());
+    auto rows = reducer.finalize();
+    ASSERT_EQ (2, rows.size());
+    ASSERT_EQ (std::vector<double>({static_cast<double>(groove_math::Int128(large) * 9 + 140),
+        static_cast<double>(large + 6), 9.0}), rows[0].values);
+    ASSERT_EQ (std::vector<double>({static_cast<double>(groove_math::Int128(large) * 15 + 580),
+        static_cast<double>(large + 25), 15.0}), rows[1].values);
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
+
+TEST_F(Int64Int64IndexedColumnTest, TestReduceBucketsSumAboveDoublePrecision)
+{
+    using namespace groove_model;
+
+    tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+    ASSERT_TRUE (tempdirMaker.isValid());
+
+    auto pageStore = RocksDbStore::create(tempdirMaker.getTempdir());
+    ASSERT_TRUE (pageStore->open().ok());
+
+    // writes keys 0-10 as a single page, with value 2^53 at key 0 and 1 at every other key.
+    // adding 1 to 2^53 in double rounds back to 2^53, but the exact sum 2^53 + 10 is a double
+    const tu_int64 large = tu_int64(1) << 53;
+    auto modelId = std::make_shared<const std::string>("test");
+    auto writer = IndexedColumnWriter<Int64Int64>::create(datasetUrl, modelId, columnId, pageStore);
+    auto schema = arrow::schema({
+        arrow::field("", arrow::int64()), arrow::field(*columnId, arrow::int64())});
+    arrow::Int64Builder keyBuilder;
+    arrow::Int64Builder i64Builder;
+    for (tu_int64 key = 0; key <= 10; key++) {
+        ASSERT_TRUE (keyBuilder.Append(key).ok());
+        ASSERT_TRUE (i64Builder.Append(key == 0? large : 1).ok());
+    }
+    auto table = arrow::Table::Make(schema, {*keyBuilder.Finish(), *i64Builder.Finish()}, 11);
+    ASSERT_TRUE (writer->setValues(groove_data::Int64Int64Vector::create(table, 0, 1, -1)).isOk());
+
+    auto column = IndexedColumn<Int64Int64>::create(datasetUrl, modelId, columnId, pageStore);
+
+    // a bucket covering the whole page is accumulated from the page statistics
+    groove_math::BucketReducer<tu_int64, tu_int64, groove_math::Sum, groove_math::Average>
+        summarized({0, 100}, {0.0, 0.0});
+    ASSERT_TRUE (column->reduceBuckets(groove_data::Int64Range(), summarized).isOk());
+    auto rows = summarized.finalize();
+    ASSERT_EQ (1, rows.size());
+    ASSERT_EQ (static_cast<double>(large + 10), rows[0].values[0]);
+    ASSERT_DOUBLE_EQ (static_cast<double>(large + 10) / 11.0, rows[0].values[1]);
+
+    // buckets which divide the page decode it and sum each run of the page exactly
+    groove_math::BucketReducer<tu_int64, tu_int64, groove_math::Sum>
+        decoded({0, 5}, {0.0});
+    ASSERT_TRUE (column->reduceBuckets(groove_data::Int64Range(), decoded).isOk());
+    rows = decoded.finalize();
+    ASSERT_EQ (3, rows.size());
+    ASSERT_EQ (static_cast<double>(large + 4), rows[0].values[0]);
+    ASSERT_EQ (5.0, rows[1].values[0]);
+    ASSERT_EQ (1.0, rows[2].values[0]);
+
+    std::filesystem::remove_all(tempdirMaker.getTempdir());
+}
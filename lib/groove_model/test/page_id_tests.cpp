@@ -1,6 +1,8 @@
 
 #include <gtest/gtest.h>
 
+#include <absl/strings/str_cat.h>
+
 #include <groove_model/page_id.h>
 
 TEST(PageId, CreatePageId)
@@ -39,4 +41,72 @@ TEST(PageId, ParsePageIdFromString)
 
     ASSERT_EQ (srcId, dstId);
     ASSERT_EQ (srcBytes, dstBytes);
-}
\ No newline at end of file
+}
+
+TEST(PageId, CategoryPageIdsOrderByKey)
+{
+    using namespace groove_data;
+    using namespace groove_model;
+
+    auto datasetUrl = tempo_utils::Url::fromString("test://dataset");
+    auto modelId = std::make_shared<const std::string>("model");
+    auto columnId = std::make_shared<const std::string>("column");
+    auto createPageId = [&](const Category &key) {
+        return PageId::create<CategoryDouble,CollationMode::COLLATION_SORTED>(
+            datasetUrl, modelId, columnId, Option<Category>(key)).getBytes();
+    };
+
+    ASSERT_LT (createPageId(Category({"a"})), createPageId(Category({"a", "b"})));
+    ASSERT_LT (createPageId(Category({"a", "b"})), createPageId(Category({"aa"})));
+    ASSERT_LT (createPageId(Category({"aa"})), createPageId(Category({"b"})));
+}
+
+TEST(PageId, EmptyCategoryKeyIsDistinctFromAbsentKey)
+{
+    using namespace groove_data;
+    using namespace groove_model;
+
+    auto datasetUrl = tempo_utils::Url::fromString("test://dataset");
+    auto modelId = std::make_shared<const std::string>("model");
+    auto columnId = std::make_shared<const std::string>("column");
+    auto absentId = PageId::create<CategoryDouble,CollationMode::COLLATION_SORTED>(
+        datasetUrl, modelId, columnId, Option<Category>());
+    auto emptyId = PageId::create<CategoryDouble,CollationMode::COLLATION_SORTED>(
+        datasetUrl, modelId, columnId, Option<Category>(Category()));
+    auto firstId = PageId::create<CategoryDouble,CollationMode::COLLATION_SORTED>(
+        datasetUrl, modelId, columnId, Option<Category>(Category({""})));
+
+    ASSERT_NE (absentId, emptyId);
+    ASSERT_LT (absentId.getBytes(), emptyId.getBytes());
+    ASSERT_LT (emptyId.getBytes(), firstId.getBytes());
+}
+
+TEST(PageId, ConvertLegacyCategoryPageId)
+{
+    using namespace groove_data;
+    using namespace groove_model;
+
+    auto datasetUrl = tempo_utils::Url::fromString("test://dataset");
+    auto modelId = std::make_shared<const std::string>("model");
+    auto columnId = std::make_shared<const std::string>("column");
+    auto pageId = PageId::create<CategoryDouble,CollationMode::COLLATION_SORTED>(
+        datasetUrl, modelId, columnId, Option<Category>(Category({"a", "b"})));
+
+    std::string legacyId;
+    ASSERT_TRUE (convert_category_page_id_to_legacy(pageId.getBytes(), legacyId));
+    std::string expected = absl::StrCat(pageId.getPrefix(), "scd\x1e",
+        std::string_view("\0\0\0\1" "a" "\0\0\0\1" "b", 10));
+    ASSERT_EQ (expected, legacyId);
+
+    std::string currentId;
+    ASSERT_TRUE (convert_legacy_category_page_id(legacyId, currentId));
+    ASSERT_EQ (pageId.getBytes(), currentId);
+
+    // a page id which is already in the current encoding needs no conversion
+    ASSERT_FALSE (convert_legacy_category_page_id(currentId, legacyId));
+
+    // page ids with other key types are never converted
+    auto int64Id = PageId::create<Int64Int64,CollationMode::COLLATION_INDEXED>(
+        datasetUrl, modelId, columnId, Option<tu_int64>(0));
+    ASSERT_FALSE (convert_legacy_category_page_id(int64Id.getBytes(), currentId));
+}
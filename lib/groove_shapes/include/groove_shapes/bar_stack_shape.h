@@ -4,7 +4,7 @@
 #include <absl/container/flat_hash_map.h>
 
 #include <groove_data/data_types.h>
-#include <groove_iterator/peek_iterator_template.h>
+#include <groove_iterator/merge_iterator_template.h>
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
 #include <groove_units/unit_dimension.h>
@@ -15,32 +15,46 @@
 
 namespace groove_shapes {
 
+    /**
+     * The values of every item at one key. Values are not keyed by item id: values[i] is the
+     * value of the item itemIds->at(i), and itemIds is shared by every datum of an iterator, so
+     * no per-row map is built. Use findItem to look up the index of an item by id. An item with
+     * no row at the key has value 0.0 and fidelity FIDELITY_MISSING, the same as a row whose
+     * value is null, and hasValue is only true for a valid or approximate value.
+     */
     struct BarStackDatum {
         groove_data::Category key;
-        absl::flat_hash_map<std::string, std::pair<double,groove_data::DatumFidelity>> values;
+        std::shared_ptr<const std::vector<std::string>> itemIds;
+        std::vector<std::pair<double,groove_data::DatumFidelity>> values;
 
         BarStackDatum();
         BarStackDatum(
             const groove_data::Category &key,
-            const absl::flat_hash_map<std::string, std::pair<double,groove_data::DatumFidelity>> &values);
+            std::shared_ptr<const std::vector<std::string>> itemIds,
+            const std::vector<std::pair<double,groove_data::DatumFidelity>> &values);
+
+        int numItems() const;
+        int findItem(const std::string &itemId) const;
+        bool hasValue(int index) const;
     };
 
+    /**
+     * Aligns the values of every item by key. The item columns are merged with a MergeIterator,
+     * so each row costs O(log K) for K items, and the values of each row are written into the
+     * buffers of the datum passed to getNext, which are reused when the same datum is passed
+     * again.
+     */
     class BarStackDatumIterator : public Iterator<BarStackDatum> {
     public:
         BarStackDatumIterator();
         BarStackDatumIterator(
-            const std::vector<
-                std::pair<
-                    std::string,
-                    groove_iterator::PeekIterator<
-                        groove_model::CategoryDoubleColumnIterator,groove_data::CategoryDoubleDatum>>> &inputs);
+            std::shared_ptr<const std::vector<std::string>> itemIds,
+            std::vector<groove_model::CategoryDoubleColumnIterator> inputs);
         bool getNext(BarStackDatum &datum) override;
     private:
-        std::vector<
-            std::pair<
-                std::string,
-                groove_iterator::PeekIterator<
-                    groove_model::CategoryDoubleColumnIterator,groove_data::CategoryDoubleDatum>>> m_inputs;
+        std::shared_ptr<const std::vector<std::string>> m_itemIds;
+        groove_iterator::MergeIterator<groove_model::CategoryDoubleColumnIterator> m_merge;
+        groove_iterator::MergeRow<groove_data::Category, groove_data::CategoryDoubleDatum> m_row;
     };
 
     class BarStackShape : public BaseShape {
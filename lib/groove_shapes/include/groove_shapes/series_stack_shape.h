@@ -4,7 +4,7 @@
 #include <absl/container/flat_hash_map.h>
 
 #include <groove_data/data_types.h>
-#include <groove_iterator/peek_iterator_template.h>
+#include <groove_iterator/merge_iterator_template.h>
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
 #include <tempo_utils/iterator_template.h>
@@ -14,34 +14,46 @@
 
 namespace groove_shapes {
 
+    /**
+     * The values of every item at one key. Values are not keyed by item id: values[i] is the
+     * value of the item itemIds->at(i), and itemIds is shared by every datum of an iterator, so
+     * no per-row map is built. Use findItem to look up the index of an item by id. An item with
+     * no row at the key has value 0.0 and fidelity FIDELITY_MISSING, the same as a row whose
+     * value is null, and hasValue is only true for a valid or approximate value.
+     */
     struct SeriesStackDatum {
         double key;
-        absl::flat_hash_map<std::string, std::pair<double,groove_data::DatumFidelity>> values;
+        std::shared_ptr<const std::vector<std::string>> itemIds;
+        std::vector<std::pair<double,groove_data::DatumFidelity>> values;
 
         SeriesStackDatum();
         SeriesStackDatum(
             double key,
-            const absl::flat_hash_map<std::string, std::pair<double,groove_data::DatumFidelity>> &values);
+            std::shared_ptr<const std::vector<std::string>> itemIds,
+            const std::vector<std::pair<double,groove_data::DatumFidelity>> &values);
+
+        int numItems() const;
+        int findItem(const std::string &itemId) const;
+        bool hasValue(int index) const;
     };
 
+    /**
+     * Aligns the values of every item by key. The item columns are merged with a MergeIterator,
+     * so each row costs O(log K) for K items, and the values of each row are written into the
+     * buffers of the datum passed to getNext, which are reused when the same datum is passed
+     * again.
+     */
     class SeriesStackDatumIterator : public Iterator<SeriesStackDatum> {
     public:
         SeriesStackDatumIterator();
         SeriesStackDatumIterator(
-            const std::vector<
-                std::pair<
-                    std::string,
-                    groove_iterator::PeekIterator<
-                        groove_model::DoubleDoubleColumnIterator,
-                        groove_data::DoubleDoubleDatum>>> &inputs);
+            std::shared_ptr<const std::vector<std::string>> itemIds,
+            std::vector<groove_model::DoubleDoubleColumnIterator> inputs);
         bool getNext(SeriesStackDatum &datum) override;
     private:
-        std::vector<
-            std::pair<
-                std::string,
-                groove_iterator::PeekIterator<
-                    groove_model::DoubleDoubleColumnIterator,
-                    groove_data::DoubleDoubleDatum>>> m_inputs;
+        std::shared_ptr<const std::vector<std::string>> m_itemIds;
+        groove_iterator::MergeIterator<groove_model::DoubleDoubleColumnIterator> m_merge;
+        groove_iterator::MergeRow<double, groove_data::DoubleDoubleDatum> m_row;
     };
 
     class SeriesStackShape : public BaseShape {
@@ -1,13 +1,18 @@
 #ifndef GROOVE_SHAPES_SUMMARY_GROUP_SHAPE_H
 #define GROOVE_SHAPES_SUMMARY_GROUP_SHAPE_H
 
+#include <type_traits>
+
 #include <absl/container/flat_hash_map.h>
 
 #include <groove_data/data_types.h>
+#include <groove_math/histogram.h>
 #include <groove_math/math_types.h>
+#include <groove_math/reduce_kernels.h>
 #include <groove_math/reducer_traits.h>
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
+#include <groove_model/partitioned_scan.h>
 #include <groove_units/unit_dimension.h>
 #include <tempo_utils/iterator_template.h>
 
@@ -44,18 +49,93 @@ namespace groove_shapes {
 
         groove_data::DataValueType getSummaryGroupColumnValueType(const std::string &itemId) const;
 
+        /**
+         * Counts the values of the item in range into histogram, which must have been
+         * constructed with the bins of the distribution to display. Counts already in the
+         * histogram are kept, so the histograms of several items or ranges can be combined.
+         *
+         * @param itemId
+         * @param range
+         * @param histogram
+         * @return
+         */
+        tempo_utils::Status getSummaryGroupHistogram(
+            const std::string &itemId,
+            const groove_data::DoubleRange &range,
+            groove_math::Histogram &histogram);
+
     private:
         absl::flat_hash_set<std::string> m_items;
         absl::flat_hash_map<
             std::string,
             std::shared_ptr<groove_model::IndexedColumn<groove_model::DoubleDouble>>> m_columns;
+        absl::flat_hash_map<
+            std::string,
+            std::shared_ptr<groove_model::IndexedColumn<groove_model::DoubleInt64>>> m_int64Columns;
 
-        tempo_utils::Result<std::shared_ptr<Iterator<double>>> getItemValues(
-            const std::string &itemId,
-            const groove_data::DoubleRange &range);
+        template <typename DefType>
+        tempo_utils::Status addItemHistogram(
+            std::shared_ptr<groove_model::IndexedColumn<DefType>> column,
+            const groove_data::DoubleRange &range,
+            groove_math::Histogram &histogram);
+
+        template <typename ValueType>
+        std::shared_ptr<groove_model::IndexedColumn<groove_model::DoubleDouble>>
+        getItemColumn(const std::string &itemId) requires (std::is_same_v<ValueType, double>)
+        {
+            auto entry = m_columns.find(itemId);
+            return entry != m_columns.cend()? entry->second : nullptr;
+        }
+
+        template <typename ValueType>
+        std::shared_ptr<groove_model::IndexedColumn<groove_model::DoubleInt64>>
+        getItemColumn(const std::string &itemId) requires (std::is_same_v<ValueType, tu_int64>)
+        {
+            auto entry = m_int64Columns.find(itemId);
+            return entry != m_int64Columns.cend()? entry->second : nullptr;
+        }
 
     public:
 
+        /**
+         * Returns the partial state of the reduction over the values of the item in range. The
+         * state can be merged with the states of other ranges, pages or agents before it is
+         * finalized, for example to combine quantile sketches. ValueType must match the value
+         * type of the item column, see getSummaryGroupColumnValueType.
+         *
+         * @tparam ReducerType
+         * @tparam ValueType
+         * @param itemId
+         * @param range
+         * @return
+         */
+        template <typename ReducerType,
+            typename ValueType = double,
+            typename FunctionType = typename groove_math::ReducerTraits<ReducerType,ValueType>::FunctionType,
+            typename StateType = typename FunctionType::State>
+        tempo_utils::Result<StateType> getSummaryGroupState(
+            const std::string &itemId,
+            const groove_data::DoubleRange &range)
+        {
+            auto column = getItemColumn<ValueType>(itemId);
+            if (column == nullptr)
+                return ShapesStatus::forCondition(ShapesCondition::kMissingItem);
+
+            // partitions of the range are reduced in parallel and their states merged in key order
+            return column->template reducePartitioned<FunctionType>(range, groove_model::default_scan_threads());
+        }
+
+        /**
+         * Returns the value of the reduction over the values of the item in range. Int64 items
+         * are reduced natively by the int64 function of ReducerType if there is one, otherwise
+         * the item must be a double item.
+         *
+         * @tparam ReducerType
+         * @param itemId
+         * @param range
+         * @param identity
+         * @return
+         */
         template <typename ReducerType,
             typename IdentityType = typename groove_math::ReducerTraits<ReducerType>::OutputType>
         tempo_utils::Result<SummaryGroupDatum> getSummaryGroupValue(
@@ -63,20 +143,95 @@ namespace groove_shapes {
             const groove_data::DoubleRange &range,
             const IdentityType &identity)
         {
-            auto getItemValuesResult = getItemValues(itemId, range);
-            if (getItemValuesResult.isStatus())
-                return getItemValuesResult.getStatus();
-            auto input = getItemValuesResult.getResult();
+            if (m_int64Columns.contains(itemId)) {
+                using Int64Traits = groove_math::ReducerTraits<ReducerType,tu_int64>;
+                if constexpr (requires { typename Int64Traits::FunctionType; }) {
+                    auto getSummaryGroupStateResult = getSummaryGroupState<ReducerType,tu_int64>(itemId, range);
+                    if (getSummaryGroupStateResult.isStatus())
+                        return getSummaryGroupStateResult.getStatus();
+                    auto state = getSummaryGroupStateResult.getResult();
+
+                    using OutputType = typename Int64Traits::OutputType;
+                    groove_math::Reducer<ReducerType,tu_int64> reducer(static_cast<OutputType>(identity));
+                    auto finalizeResult = reducer.validateAndFinalize(state);
+                    if (finalizeResult.isStatus())
+                        return finalizeResult.getStatus();
+                    auto value = static_cast<double>(finalizeResult.getResult());
+
+                    return SummaryGroupDatum(range, value, groove_data::DatumFidelity::FIDELITY_VALID);
+                } else {
+                    return ShapesStatus::forCondition(
+                        ShapesCondition::kInvalidSource, "reducer does not support int64 values");
+                }
+            }
+
+            auto getSummaryGroupStateResult = getSummaryGroupState<ReducerType>(itemId, range);
+            if (getSummaryGroupStateResult.isStatus())
+                return getSummaryGroupStateResult.getStatus();
+            auto state = getSummaryGroupStateResult.getResult();
 
             groove_math::Reducer<ReducerType> reducer(identity);
-            auto reduceResult = reducer.reduce(input);
-            if (reduceResult.isStatus())
-                return reduceResult.getStatus();
-            auto value = reduceResult.getResult();
+            auto value = reducer.finalize(state);
 
             return SummaryGroupDatum(range, value, groove_data::DatumFidelity::FIDELITY_VALID);
         }
 
+        /**
+         * Returns the value of each reducer in ReducerTypes over the values of the item in range,
+         * in the order of ReducerTypes. The values of a double item are read once and all
+         * reducers are evaluated together, which is cheaper than calling getSummaryGroupValue
+         * for each reducer. Fused reducers are double only, so an int64 item is reduced once per
+         * reducer with getSummaryGroupValue.
+         *
+         * @tparam ReducerTypes
+         * @param itemId
+         * @param range
+         * @param identities
+         * @return
+         */
+        template <typename... ReducerTypes>
+        tempo_utils::Result<std::vector<SummaryGroupDatum>> getSummaryGroupValues(
+            const std::string &itemId,
+            const groove_data::DoubleRange &range,
+            const std::array<double,sizeof...(ReducerTypes)> &identities)
+        {
+            if (m_int64Columns.contains(itemId)) {
+                std::vector<SummaryGroupDatum> data;
+                size_t index = 0;
+                tempo_utils::Status status = ShapesStatus::ok();
+                auto getValue = [&]<typename ReducerType>() {
+                    if (status.notOk())
+                        return;
+                    auto getSummaryGroupValueResult = getSummaryGroupValue<ReducerType>(
+                        itemId, range, identities[index++]);
+                    if (getSummaryGroupValueResult.isStatus()) {
+                        status = getSummaryGroupValueResult.getStatus();
+                    } else {
+                        data.push_back(getSummaryGroupValueResult.getResult());
+                    }
+                };
+                (getValue.template operator()<ReducerTypes>(), ...);
+                if (status.notOk())
+                    return status;
+                return data;
+            }
+
+            using FusedType = std::tuple<ReducerTypes...>;
+            auto getSummaryGroupStateResult = getSummaryGroupState<FusedType>(itemId, range);
+            if (getSummaryGroupStateResult.isStatus())
+                return getSummaryGroupStateResult.getStatus();
+            auto state = getSummaryGroupStateResult.getResult();
+
+            groove_math::Reducer<FusedType> reducer(identities);
+            auto values = reducer.finalize(state);
+
+            std::vector<SummaryGroupDatum> data;
+            for (auto value : values) {
+                data.emplace_back(range, value, groove_data::DatumFidelity::FIDELITY_VALID);
+            }
+            return data;
+        }
+
     };
 }
 
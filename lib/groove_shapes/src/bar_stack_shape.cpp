@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
 #include <groove_model/page_traits.h>
@@ -6,15 +8,45 @@
 #include <tempo_utils/logging.h>
 
 groove_shapes::BarStackDatum::BarStackDatum()
-    : key(), values()
+    : key(), itemIds(), values()
 {
 }
 
 groove_shapes::BarStackDatum::BarStackDatum(
     const groove_data::Category &key,
-    const absl::flat_hash_map<std::string,std::pair<double,groove_data::DatumFidelity>> &values)
-    : key(key), values(values)
+    std::shared_ptr<const std::vector<std::string>> itemIds,
+    const std::vector<std::pair<double,groove_data::DatumFidelity>> &values)
+    : key(key), itemIds(itemIds), values(values)
+{
+    TU_ASSERT (this->itemIds != nullptr);
+    TU_ASSERT (this->values.size() == this->itemIds->size());
+}
+
+int
+groove_shapes::BarStackDatum::numItems() const
+{
+    return values.size();
+}
+
+int
+groove_shapes::BarStackDatum::findItem(const std::string &itemId) const
 {
+    if (itemIds == nullptr)
+        return -1;
+    auto iterator = std::find(itemIds->cbegin(), itemIds->cend(), itemId);
+    if (iterator == itemIds->cend())
+        return -1;
+    return static_cast<int>(iterator - itemIds->cbegin());
+}
+
+bool
+groove_shapes::BarStackDatum::hasValue(int index) const
+{
+    if (index < 0 || numItems() <= index)
+        return false;
+    auto fidelity = values[index].second;
+    return fidelity == groove_data::DatumFidelity::FIDELITY_VALID
+        || fidelity == groove_data::DatumFidelity::FIDELITY_APPROXIMATE;
 }
 
 groove_shapes::BarStackShape::BarStackShape(
@@ -105,92 +137,73 @@ groove_shapes::BarStackShape::getBarStackUnits()
 tempo_utils::Result<groove_shapes::BarStackDatum>
 groove_shapes::BarStackShape::getBarStackValue(const groove_data::Category &key)
 {
-    BarStackDatum datum;
-    datum.key = key;
+    auto itemIds = std::make_shared<std::vector<std::string>>();
+    std::vector<std::pair<double,groove_data::DatumFidelity>> values;
     for (auto iterator = m_columns.cbegin(); iterator != m_columns.cend(); iterator++) {
-        auto &itemId = iterator->first;
         auto column = iterator->second;
         auto result = column->getValue(key);
         if (result.isStatus())
             return result.getStatus();
         auto value = result.getResult();
-        datum.values[itemId] = std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity};
+        itemIds->push_back(iterator->first);
+        values.push_back(std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity});
     }
-    return datum;
+    return BarStackDatum(key, itemIds, values);
 }
 
 tempo_utils::Result<groove_shapes::BarStackDatumIterator>
 groove_shapes::BarStackShape::getBarStackValues(
     const groove_data::CategoryRange &range)
 {
-    std::vector<
-        std::pair<
-            std::string,
-            groove_iterator::PeekIterator<
-                groove_model::CategoryDoubleColumnIterator,
-                groove_data::CategoryDoubleDatum>>> inputs;
+    auto itemIds = std::make_shared<std::vector<std::string>>();
+    std::vector<groove_model::CategoryDoubleColumnIterator> inputs;
 
     for (auto iterator = m_columns.cbegin(); iterator != m_columns.cend(); iterator++) {
-        auto itemId = iterator->first;
         auto column = iterator->second;
         auto result = column->getValues(range);
         if (result.isStatus())
             return result.getStatus();
-        inputs.push_back({
-            itemId,
-            groove_iterator::PeekIterator<
-                groove_model::CategoryDoubleColumnIterator,
-                groove_data::CategoryDoubleDatum>(result.getResult())
-        });
+        itemIds->push_back(iterator->first);
+        inputs.push_back(result.getResult());
     }
 
-    return BarStackDatumIterator(inputs);
+    return BarStackDatumIterator(itemIds, std::move(inputs));
 }
 
 groove_shapes::BarStackDatumIterator::BarStackDatumIterator()
+    : m_itemIds(std::make_shared<std::vector<std::string>>()),
+      m_merge(std::vector<groove_model::CategoryDoubleColumnIterator>())
 {
 }
 
 groove_shapes::BarStackDatumIterator::BarStackDatumIterator(
-    const std::vector<
-        std::pair<
-            std::string,
-            groove_iterator::PeekIterator<
-                groove_model::CategoryDoubleColumnIterator,groove_data::CategoryDoubleDatum>>> &inputs)
-    : m_inputs(inputs)
+    std::shared_ptr<const std::vector<std::string>> itemIds,
+    std::vector<groove_model::CategoryDoubleColumnIterator> inputs)
+    : m_itemIds(itemIds),
+      m_merge(std::move(inputs))
 {
+    TU_ASSERT (m_itemIds != nullptr);
+    TU_ASSERT (static_cast<int>(m_itemIds->size()) == m_merge.numInputs());
 }
 
 bool
 groove_shapes::BarStackDatumIterator::getNext(BarStackDatum &datum)
 {
-    groove_data::Category key;
-
-    // determine which inputs are ready
-    std::vector<int> ready;
-    for (int i = 0; i < m_inputs.size(); i++) {
-        auto &input = m_inputs.at(i).second;
-        groove_data::CategoryDoubleDatum peek;
-        if (input.peekNext(peek)) {
-            if (key.isEmpty() || peek.key < key) {
-                ready.clear();
-                ready.push_back(i);
-                key = peek.key;
-            } else if (peek.key == key) {
-                ready.push_back(i);
-            }
-        }
-    }
-
-    // construct the datum
-    absl::flat_hash_map<std::string,std::pair<double,groove_data::DatumFidelity>> values;
-    for (const auto &i : ready) {
-        auto &p = m_inputs.at(i);
-        groove_data::CategoryDoubleDatum value;
-        if (p.second.getNext(value)) {
-            values[p.first] = std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity};
+    if (!m_merge.getNext(m_row))
+        return false;
+
+    // write into the buffers of the datum, so a datum passed again is not reallocated
+    datum.key = m_row.key;
+    datum.itemIds = m_itemIds;
+    datum.values.resize(m_row.values.size());
+    for (size_t i = 0; i < m_row.values.size(); i++) {
+        if (m_row.present[i]) {
+            const auto &value = m_row.values[i];
+            datum.values[i] = std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity};
+        } else {
+            datum.values[i] = std::pair<double,groove_data::DatumFidelity>{
+                0.0, groove_data::DatumFidelity::FIDELITY_MISSING};
         }
     }
-    datum = BarStackDatum(key, values);
     return true;
 }
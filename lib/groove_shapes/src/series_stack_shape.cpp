@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
 #include <groove_model/page_traits.h>
@@ -6,15 +8,45 @@
 #include <tempo_utils/logging.h>
 
 groove_shapes::SeriesStackDatum::SeriesStackDatum()
-    : key{}, values()
+    : key(), itemIds(), values()
 {
 }
 
 groove_shapes::SeriesStackDatum::SeriesStackDatum(
     double key,
-    const absl::flat_hash_map<std::string, std::pair<double,groove_data::DatumFidelity>> &values)
-    : key(key), values(values)
+    std::shared_ptr<const std::vector<std::string>> itemIds,
+    const std::vector<std::pair<double,groove_data::DatumFidelity>> &values)
+    : key(key), itemIds(itemIds), values(values)
+{
+    TU_ASSERT (this->itemIds != nullptr);
+    TU_ASSERT (this->values.size() == this->itemIds->size());
+}
+
+int
+groove_shapes::SeriesStackDatum::numItems() const
+{
+    return values.size();
+}
+
+int
+groove_shapes::SeriesStackDatum::findItem(const std::string &itemId) const
 {
+    if (itemIds == nullptr)
+        return -1;
+    auto iterator = std::find(itemIds->cbegin(), itemIds->cend(), itemId);
+    if (iterator == itemIds->cend())
+        return -1;
+    return static_cast<int>(iterator - itemIds->cbegin());
+}
+
+bool
+groove_shapes::SeriesStackDatum::hasValue(int index) const
+{
+    if (index < 0 || numItems() <= index)
+        return false;
+    auto fidelity = values[index].second;
+    return fidelity == groove_data::DatumFidelity::FIDELITY_VALID
+        || fidelity == groove_data::DatumFidelity::FIDELITY_APPROXIMATE;
 }
 
 groove_shapes::SeriesStackShape::SeriesStackShape(
@@ -107,45 +139,36 @@ groove_shapes::SeriesStackShape::itemsEnd() const
 tempo_utils::Result<groove_shapes::SeriesStackDatum>
 groove_shapes::SeriesStackShape::getSeriesStackValue(double key)
 {
-    SeriesStackDatum datum;
-    datum.key = key;
+    auto itemIds = std::make_shared<std::vector<std::string>>();
+    std::vector<std::pair<double,groove_data::DatumFidelity>> values;
     for (auto iterator = m_columns.cbegin(); iterator != m_columns.cend(); iterator++) {
-        auto &itemId = iterator->first;
         auto column = iterator->second;
         auto result = column->getValue(key);
         if (result.isStatus())
             return result.getStatus();
         auto value = result.getResult();
-        datum.values[itemId] = std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity};
+        itemIds->push_back(iterator->first);
+        values.push_back(std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity});
     }
-    return datum;
+    return SeriesStackDatum(key, itemIds, values);
 }
 
 tempo_utils::Result<groove_shapes::SeriesStackDatumIterator>
 groove_shapes::SeriesStackShape::getSeriesStackValues(const groove_data::DoubleRange &range)
 {
-    std::vector<
-        std::pair<
-            std::string,
-            groove_iterator::PeekIterator<
-                groove_model::DoubleDoubleColumnIterator,
-                groove_data::DoubleDoubleDatum>>> inputs;
+    auto itemIds = std::make_shared<std::vector<std::string>>();
+    std::vector<groove_model::DoubleDoubleColumnIterator> inputs;
 
     for (auto iterator = m_columns.cbegin(); iterator != m_columns.cend(); iterator++) {
-        auto itemId = iterator->first;
         auto column = iterator->second;
         auto result = column->getValues(range);
         if (result.isStatus())
             return result.getStatus();
-        inputs.push_back({
-            itemId,
-            groove_iterator::PeekIterator<
-               groove_model::DoubleDoubleColumnIterator,
-               groove_data::DoubleDoubleDatum>(result.getResult())
-        });
+        itemIds->push_back(iterator->first);
+        inputs.push_back(result.getResult());
     }
 
-    return SeriesStackDatumIterator(inputs);
+    return SeriesStackDatumIterator(itemIds, std::move(inputs));
 }
 
 //QStringList
@@ -155,50 +178,39 @@ groove_shapes::SeriesStackShape::getSeriesStackValues(const groove_data::DoubleR
 //}
 
 groove_shapes::SeriesStackDatumIterator::SeriesStackDatumIterator()
+    : m_itemIds(std::make_shared<std::vector<std::string>>()),
+      m_merge(std::vector<groove_model::DoubleDoubleColumnIterator>())
 {
 }
 
 groove_shapes::SeriesStackDatumIterator::SeriesStackDatumIterator(
-    const std::vector<
-        std::pair<
-            std::string,
-            groove_iterator::PeekIterator<
-                groove_model::DoubleDoubleColumnIterator,
-                groove_data::DoubleDoubleDatum>>> &inputs)
-    : m_inputs(inputs)
+    std::shared_ptr<const std::vector<std::string>> itemIds,
+    std::vector<groove_model::DoubleDoubleColumnIterator> inputs)
+    : m_itemIds(itemIds),
+      m_merge(std::move(inputs))
 {
+    TU_ASSERT (m_itemIds != nullptr);
+    TU_ASSERT (static_cast<int>(m_itemIds->size()) == m_merge.numInputs());
 }
 
 bool
 groove_shapes::SeriesStackDatumIterator::getNext(SeriesStackDatum &datum)
 {
-    double key;
-
-    // determine which inputs are ready
-    std::vector<int> ready;
-    for (int i = 0; i < m_inputs.size(); i++) {
-        auto &input = m_inputs.at(i).second;
-        groove_data::DoubleDoubleDatum peek;
-        if (input.peekNext(peek)) {
-            if (i == 0 || peek.key < key) {
-                ready.clear();
-                ready.push_back(i);
-                key = peek.key;
-            } else if (peek.key == key) {
-                ready.push_back(i);
-            }
-        }
-    }
-
-    // construct the datum
-    absl::flat_hash_map<std::string,std::pair<double,groove_data::DatumFidelity>> values;
-    for (const auto &i : ready) {
-        auto &p = m_inputs.at(i);
-        groove_data::DoubleDoubleDatum value;
-        if (p.second.getNext(value)) {
-            values[p.first] = std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity};
+    if (!m_merge.getNext(m_row))
+        return false;
+
+    // write into the buffers of the datum, so a datum passed again is not reallocated
+    datum.key = m_row.key;
+    datum.itemIds = m_itemIds;
+    datum.values.resize(m_row.values.size());
+    for (size_t i = 0; i < m_row.values.size(); i++) {
+        if (m_row.present[i]) {
+            const auto &value = m_row.values[i];
+            datum.values[i] = std::pair<double,groove_data::DatumFidelity>{value.value, value.fidelity};
+        } else {
+            datum.values[i] = std::pair<double,groove_data::DatumFidelity>{
+                0.0, groove_data::DatumFidelity::FIDELITY_MISSING};
         }
     }
-    datum = SeriesStackDatum(key, values);
     return true;
 }
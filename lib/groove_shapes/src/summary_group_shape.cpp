@@ -1,5 +1,4 @@
 
-#include <groove_iterator/map_iterator_template.h>
 #include <groove_model/column_traits.h>
 #include <groove_model/model_types.h>
 #include <groove_model/page_traits.h>
@@ -40,14 +39,28 @@ groove_shapes::SummaryGroupShape::configure(const SourceDescriptor &source)
     }
 
     for (const auto &columnId : columnIds) {
-        auto getModelResult = model->getIndexedColumn<groove_model::DoubleDouble>(columnId);
-        if (getModelResult.isStatus())
-            return getModelResult.getStatus();
         auto itemId = absl::StrCat(
             source.getDatasetUrl().toString(),
             " ", source.getModelId(),
             " ", columnId);
-        m_columns[itemId] = getModelResult.getResult();
+        switch (model->getColumnDef(columnId).getValue()) {
+            case groove_data::DataValueType::VALUE_TYPE_DOUBLE: {
+                auto getColumnResult = model->getIndexedColumn<groove_model::DoubleDouble>(columnId);
+                if (getColumnResult.isStatus())
+                    return getColumnResult.getStatus();
+                m_columns[itemId] = getColumnResult.getResult();
+                break;
+            }
+            case groove_data::DataValueType::VALUE_TYPE_INT64: {
+                auto getColumnResult = model->getIndexedColumn<groove_model::DoubleInt64>(columnId);
+                if (getColumnResult.isStatus())
+                    return getColumnResult.getStatus();
+                m_int64Columns[itemId] = getColumnResult.getResult();
+                break;
+            }
+            default:
+                return ShapesStatus::forCondition(ShapesCondition::kInvalidSource, "unknown column def value type");
+        }
         m_items.insert(itemId);
     }
 
@@ -81,33 +94,64 @@ groove_shapes::SummaryGroupShape::itemsEnd() const
 groove_data::DataValueType
 groove_shapes::SummaryGroupShape::getSummaryGroupColumnValueType(const std::string &itemId) const
 {
-    // FIXME: eventually we should support different column value types
-    return groove_data::DataValueType::VALUE_TYPE_DOUBLE;
+    if (m_columns.contains(itemId))
+        return groove_data::DataValueType::VALUE_TYPE_DOUBLE;
+    if (m_int64Columns.contains(itemId))
+        return groove_data::DataValueType::VALUE_TYPE_INT64;
+    return groove_data::DataValueType::VALUE_TYPE_UNKNOWN;
 }
 
-static double map_DoubleDoubleDatum_to_double(const groove_data::DoubleDoubleDatum &datum)
+tempo_utils::Status
+groove_shapes::SummaryGroupShape::getSummaryGroupHistogram(
+    const std::string &itemId,
+    const groove_data::DoubleRange &range,
+    groove_math::Histogram &histogram)
 {
-    return datum.value;
+    TU_ASSERT (histogram.isValid());
+
+    if (m_int64Columns.contains(itemId))
+        return addItemHistogram(m_int64Columns.at(itemId), range, histogram);
+    if (m_columns.contains(itemId))
+        return addItemHistogram(m_columns.at(itemId), range, histogram);
+    return ShapesStatus::forCondition(ShapesCondition::kMissingItem);
 }
 
-tempo_utils::Result<std::shared_ptr<Iterator<double>>>
-groove_shapes::SummaryGroupShape::getItemValues(
-    const std::string &itemId,
-    const groove_data::DoubleRange &range)
+template <typename DefType>
+tempo_utils::Status
+groove_shapes::SummaryGroupShape::addItemHistogram(
+    std::shared_ptr<groove_model::IndexedColumn<DefType>> column,
+    const groove_data::DoubleRange &range,
+    groove_math::Histogram &histogram)
 {
-    if (!m_columns.contains(itemId))
-        return ShapesStatus::forCondition(ShapesCondition::kMissingItem);
-    auto column = m_columns.at(itemId);
-    auto result = column->getValues(range);
-    if (result.isStatus())
-        return result.getStatus();
-    auto input = result.getResult();
-
-    auto values = std::make_shared<
-        groove_iterator::MapIterator<
-            groove_model::DoubleDoubleColumnIterator,
-            groove_data::DoubleDoubleDatum,
-            double>>(input, map_DoubleDoubleDatum_to_double);
-
-    return std::static_pointer_cast<Iterator<double>>(values);
+    auto numThreads = groove_model::default_scan_threads();
+    auto partitionRangeResult = column->partitionRange(range, numThreads * groove_model::kPartitionsPerThread);
+    if (partitionRangeResult.isStatus())
+        return partitionRangeResult.getStatus();
+    auto partitions = partitionRangeResult.getResult();
+
+    // each partition is counted into its own histogram as its pages are read ahead
+    std::vector<groove_math::Histogram> partitionHistograms(partitions.size(), histogram.emptyCopy());
+    auto status = groove_model::run_partitioned(static_cast<int>(partitions.size()), numThreads, [&](int index) -> tempo_utils::Status {
+        auto vectors = column->generateVectors(partitions[index], groove_model::ReadAheadOptions());
+        std::shared_ptr<typename groove_model::ColumnTraits<
+            DefType, groove_data::CollationMode::COLLATION_INDEXED>::VectorType> vector;
+        std::vector<groove_math::TypedSpan<typename DefType::ValueType>> spans;
+        // int64 values are widened to double a span at a time
+        std::vector<double> buffer;
+        while (vectors.getNext(vector)) {
+            spans.clear();
+            groove_math::append_value_spans(vector->getView(), spans);
+            for (const auto &span : spans) {
+                partitionHistograms[index].add(groove_math::widen_span(span, buffer));
+            }
+        }
+        return vectors.getStatus();
+    });
+    if (status.notOk())
+        return status;
+
+    for (const auto &partitionHistogram : partitionHistograms) {
+        histogram.merge(partitionHistogram);
+    }
+    return ShapesStatus::ok();
 }
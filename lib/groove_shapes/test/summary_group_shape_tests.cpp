@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <arrow/table_builder.h>
+#include <arrow/array/builder_primitive.h>
+
+#include <groove_data/double_frame.h>
+#include <groove_model/column_traits.h>
+#include <groove_model/groove_database.h>
+#include <groove_model/indexed_column_template.h>
+#include <groove_model/page_traits.h>
+#include <groove_model/schema_column.h>
+#include <groove_model/schema_model.h>
+#include <groove_model/schema_state.h>
+#include <groove_shapes/summary_group_shape.h>
+#include <tempo_utils/tempdir_maker.h>
+
+class SummaryGroupShapeTest : public ::testing::Test {
+protected:
+    std::filesystem::path dbPath;
+    std::shared_ptr<groove_model::GrooveDatabase> db;
+    groove_model::GrooveSchema schema;
+    tempo_utils::Url datasetUrl;
+
+    // 2^53 and 2^53 + 1 widen to the same double
+    static constexpr tu_int64 kLarge = tu_int64(1) << 53;
+
+    void SetUp() override
+    {
+        auto keyField = arrow::field("", arrow::float64());
+        auto valField = arrow::field("foo1", arrow::int64());
+        auto fidField = arrow::field("", arrow::boolean());
+        auto schema_ = arrow::schema({keyField, valField, fidField});
+        TU_ASSERT (schema_ != nullptr);
+
+        arrow::DoubleBuilder keyBuilder;
+        TU_ASSERT (keyBuilder.Append(0).ok());
+        TU_ASSERT (keyBuilder.Append(1).ok());
+        TU_ASSERT (keyBuilder.Append(2).ok());
+        TU_ASSERT (keyBuilder.Append(3).ok());
+        auto buildKeyResult = keyBuilder.Finish();
+        TU_ASSERT (buildKeyResult.ok());
+
+        arrow::Int64Builder valBuilder;
+        TU_ASSERT (valBuilder.Append(kLarge).ok());
+        TU_ASSERT (valBuilder.Append(kLarge + 1).ok());
+        TU_ASSERT (valBuilder.Append(kLarge).ok());
+        TU_ASSERT (valBuilder.Append(7).ok());
+        auto buildValResult = valBuilder.Finish();
+        TU_ASSERT (buildValResult.ok());
+
+        arrow::BooleanBuilder fidBuilder;
+        TU_ASSERT (fidBuilder.Append(false).ok());
+        TU_ASSERT (fidBuilder.Append(false).ok());
+        TU_ASSERT (fidBuilder.Append(false).ok());
+        TU_ASSERT (fidBuilder.Append(false).ok());
+        auto buildFidResult = fidBuilder.Finish();
+        TU_ASSERT (buildFidResult.ok());
+
+        auto table = arrow::Table::Make(schema_, {*buildKeyResult, *buildValResult, *buildFidResult}, 4);
+        auto createFrameResult = groove_data::DoubleFrame::create(table, 0, {{1,2}});
+        ASSERT_TRUE (createFrameResult.isResult());
+        auto frame = createFrameResult.getResult();
+
+        groove_model::SchemaState state;
+
+        groove_model::SchemaModel *model;
+        TU_ASSIGN_OR_RAISE (model, state.putModel("foo",
+            groove_model::ModelKeyType::Double, groove_model::ModelKeyCollation::Indexed));
+
+        groove_model::SchemaColumn *column;
+        TU_ASSIGN_OR_RAISE (column, state.appendColumn("foo1",
+            groove_model::ColumnValueType::Int64, groove_model::ColumnValueFidelity::OnlyValidValue));
+
+        TU_RAISE_IF_NOT_OK (model->appendColumn(column));
+
+        auto toSchemaResult = state.toSchema();
+        TU_ASSERT (toSchemaResult.isResult());
+        schema = toSchemaResult.getResult();
+
+        tempo_utils::TempdirMaker tempdirMaker(std::filesystem::current_path(), "store.XXXXXXXX");
+        ASSERT_TRUE (tempdirMaker.isValid());
+        dbPath = tempdirMaker.getTempdir();
+
+        using namespace groove_model;
+        DatabaseOptions options;
+        options.modelsDirectory = dbPath;
+        db = std::make_shared<groove_model::GrooveDatabase>(options);
+        ASSERT_TRUE (db->configure().isOk());
+
+        datasetUrl = tempo_utils::Url::fromString("test:/");
+        ASSERT_TRUE (db->declareDataset(datasetUrl, schema).isOk());
+
+        std::vector<std::string> failedVectors;
+        ASSERT_TRUE (db->updateModel(datasetUrl, "foo", frame, &failedVectors).isOk());
+        ASSERT_EQ (std::vector<std::string>{}, failedVectors);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dbPath);
+    }
+};
+
+TEST_F(SummaryGroupShapeTest, ConfigureInt64Item)
+{
+    groove_shapes::SummaryGroupShape summaryGroupShape(db, "name");
+    ASSERT_TRUE (summaryGroupShape.configure(groove_shapes::SourceDescriptor(datasetUrl, "foo")).isOk());
+    ASSERT_EQ (groove_data::DataValueType::VALUE_TYPE_INT64,
+        summaryGroupShape.getSummaryGroupColumnValueType("test:/ foo foo1"));
+}
+
+TEST_F(SummaryGroupShapeTest, GetDistinctCountOfInt64Item)
+{
+    groove_shapes::SummaryGroupShape summaryGroupShape(db, "name");
+    ASSERT_TRUE (summaryGroupShape.configure(groove_shapes::SourceDescriptor(datasetUrl, "foo")).isOk());
+
+    groove_data::DoubleRange range;
+    range.start = Option<double>(0);
+    range.end = Option<double>(4);
+    auto result = summaryGroupShape.getSummaryGroupValue<groove_math::DistinctCount>(
+        "test:/ foo foo1", range, 0.0);
+    ASSERT_TRUE (result.isResult());
+    auto datum = result.getResult();
+    ASSERT_NEAR (3.0, datum.value, 0.1);
+    ASSERT_EQ (groove_data::DatumFidelity::FIDELITY_VALID, datum.fidelity);
+}
+
+TEST_F(SummaryGroupShapeTest, GetDistinctCountAndSampleCountOfInt64Item)
+{
+    groove_shapes::SummaryGroupShape summaryGroupShape(db, "name");
+    ASSERT_TRUE (summaryGroupShape.configure(groove_shapes::SourceDescriptor(datasetUrl, "foo")).isOk());
+
+    // the key 3 is excluded by the end of the range
+    groove_data::DoubleRange range;
+    range.start = Option<double>(0);
+    range.end = Option<double>(3);
+    auto result = summaryGroupShape.getSummaryGroupValues<
+        groove_math::DistinctCount,
+        groove_math::SampleCount>("test:/ foo foo1", range, {0.0, 0.0});
+    ASSERT_TRUE (result.isResult());
+    auto data = result.getResult();
+    ASSERT_EQ (2, data.size());
+    ASSERT_NEAR (2.0, data[0].value, 0.1);
+    ASSERT_EQ (3.0, data[1].value);
+}
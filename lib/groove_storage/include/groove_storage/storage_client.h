@@ -171,7 +171,7 @@ namespace groove_storage {
             const tempo_utils::Url &datasetUrl,
             const std::string &modelId,
             std::shared_ptr<groove_data::BaseFrame> frame,
-            std::shared_ptr<const arrow::Buffer> buffer,
+            std::string &&frameBytes,
             std::shared_ptr<PutDataHandler> handler);
 
         void OnDone(const grpc::Status &status) override;
@@ -180,7 +180,6 @@ namespace groove_storage {
         tempo_utils::Url m_datasetUrl;
         std::string m_modelId;
         std::shared_ptr<groove_data::BaseFrame> m_frame;
-        std::shared_ptr<const arrow::Buffer> m_buffer;
         std::shared_ptr<PutDataHandler> m_handler;
         groove_mount::PutDataRequest m_request;
         grpc::ClientContext m_context;
@@ -220,28 +220,24 @@ groove_storage::StorageClient::putData(
         valueField->set_fid_index(vector->getFidFieldIndex());
     }
 
-    // serialize table to buffer
-    auto makeBufferResult = groove_data::make_buffer(frame->getUnderlyingTable());
-    if (makeBufferResult.isStatus())
-        return StorageStatus::forCondition(StorageCondition::kStorageInvariant, makeBufferResult.getStatus().getMessage());
-    auto buffer = makeBufferResult.getResult();
-
-    // NOTE: we hold buffer reference for lifetime of this string so its ok to not copy
-    std::string frameBytes((const char *) buffer->data(), buffer->size());
-
+    // serialize table directly into the request
+    std::string *frameBytes;
     switch (frame->getFrameType()) {
         case groove_data::DataFrameType::FRAME_TYPE_CATEGORY:
-            request.set_cat(std::move(frameBytes));
+            frameBytes = request.mutable_cat();
             break;
         case groove_data::DataFrameType::FRAME_TYPE_DOUBLE:
-            request.set_dbl(std::move(frameBytes));
+            frameBytes = request.mutable_dbl();
             break;
         case groove_data::DataFrameType::FRAME_TYPE_INT64:
-            request.set_i64(std::move(frameBytes));
+            frameBytes = request.mutable_i64();
             break;
         default:
             TU_UNREACHABLE();
     }
+    auto writeStatus = groove_data::write_table(frame->getUnderlyingTable(), frameBytes);
+    if (writeStatus.notOk())
+        return StorageStatus::forCondition(StorageCondition::kStorageInvariant, writeStatus.getMessage());
 
     auto status = m_stub->PutData(&context, request, &result);
     if (!status.ok()) {
@@ -262,12 +258,12 @@ groove_storage::StorageClient::putData(
     std::shared_ptr<groove_data::BaseFrame> frame,
     std::shared_ptr<PutDataHandler> handler)
 {
-    // serialize table to buffer
-    auto makeBufferResult = groove_data::make_buffer(frame->getUnderlyingTable());
-    if (makeBufferResult.isStatus())
-        return StorageStatus::forCondition(StorageCondition::kStorageInvariant, makeBufferResult.getStatus().getMessage());
-    auto buffer = makeBufferResult.getResult();
-    new PutDataReactor(m_stub.get(), datasetUrl, modelId, frame, buffer, handler);
+    // serialize table to bytes, which are moved into the request
+    std::string frameBytes;
+    auto status = groove_data::write_table(frame->getUnderlyingTable(), &frameBytes);
+    if (status.notOk())
+        return StorageStatus::forCondition(StorageCondition::kStorageInvariant, status.getMessage());
+    new PutDataReactor(m_stub.get(), datasetUrl, modelId, frame, std::move(frameBytes), handler);
     return StorageStatus::ok();
 }
 
@@ -532,19 +528,17 @@ groove_storage::PutDataReactor::PutDataReactor(
     const tempo_utils::Url &datasetUrl,
     const std::string &modelId,
     std::shared_ptr<groove_data::BaseFrame> frame,
-    std::shared_ptr<const arrow::Buffer> buffer,
+    std::string &&frameBytes,
     std::shared_ptr<PutDataHandler> handler)
     : m_datasetUrl(datasetUrl),
       m_modelId(modelId),
       m_frame(frame),
-      m_buffer(buffer),
       m_handler(handler)
 {
     TU_ASSERT (stub != nullptr);
     TU_ASSERT (m_datasetUrl.isValid());
     TU_ASSERT (!m_modelId.empty());
     TU_ASSERT (m_frame != nullptr);
-    TU_ASSERT (m_buffer != nullptr);
     TU_ASSERT (m_handler != nullptr);
 
     m_request.set_dataset_uri(m_datasetUrl.toString());
@@ -561,9 +555,6 @@ groove_storage::PutDataReactor::PutDataReactor(
         valueField->set_fid_index(vector->getFidFieldIndex());
     }
 
-    // NOTE: we hold buffer reference for lifetime of this string so its ok to not copy
-    std::string frameBytes((const char *) buffer->data(), buffer->size());
-
     switch (frame->getFrameType()) {
         case groove_data::DataFrameType::FRAME_TYPE_CATEGORY:
             m_request.set_cat(std::move(frameBytes));
@@ -475,14 +475,18 @@ groove_storage::DataFrameStream::OnReadDone(bool ok)
     }
     auto keyFieldIndex = m_incoming.key_index();
 
+    // the frame bytes are moved out of the message rather than copied, the message is
+    // overwritten by the next read anyway. the keys come from the remote peer, so the frame
+    // is sorted on arrival rather than trusted to be sorted and unique.
     switch (m_incoming.frame_case()) {
         case groove_sync::DataFrame::kCat: {
-            auto buffer = groove_model::SharedStringBuffer::create(m_incoming.cat());
+            auto buffer = groove_model::SharedStringBuffer::create(std::move(*m_incoming.mutable_cat()));
             auto makeTableResult = groove_data::make_table(buffer);
             if (makeTableResult.isStatus())
                 break;
             auto table = makeTableResult.getResult();
-            auto createFrameResult = groove_data::CategoryFrame::create(table, keyFieldIndex, valueFields);
+            auto createFrameResult = groove_data::CategoryFrame::create(table, keyFieldIndex, valueFields,
+                groove_data::KeyOrdering::ORDERING_SORT);
             if (createFrameResult.isStatus())
                 break;
             auto frame = createFrameResult.getResult();
@@ -490,12 +494,13 @@ groove_storage::DataFrameStream::OnReadDone(bool ok)
             break;
         }
         case groove_sync::DataFrame::kDbl: {
-            auto buffer = groove_model::SharedStringBuffer::create(m_incoming.dbl());
+            auto buffer = groove_model::SharedStringBuffer::create(std::move(*m_incoming.mutable_dbl()));
             auto makeTableResult = groove_data::make_table(buffer);
             if (makeTableResult.isStatus())
                 break;
             auto table = makeTableResult.getResult();
-            auto createFrameResult = groove_data::DoubleFrame::create(table, keyFieldIndex, valueFields);
+            auto createFrameResult = groove_data::DoubleFrame::create(table, keyFieldIndex, valueFields,
+                groove_data::KeyOrdering::ORDERING_SORT);
             if (createFrameResult.isStatus())
                 break;
             auto frame = createFrameResult.getResult();
@@ -503,12 +508,13 @@ groove_storage::DataFrameStream::OnReadDone(bool ok)
             break;
         }
         case groove_sync::DataFrame::kI64: {
-            auto buffer = groove_model::SharedStringBuffer::create(m_incoming.i64());
+            auto buffer = groove_model::SharedStringBuffer::create(std::move(*m_incoming.mutable_i64()));
             auto makeTableResult = groove_data::make_table(buffer);
             if (makeTableResult.isStatus())
                 break;
             auto table = makeTableResult.getResult();
-            auto createFrameResult = groove_data::Int64Frame::create(table, keyFieldIndex, valueFields);
+            auto createFrameResult = groove_data::Int64Frame::create(table, keyFieldIndex, valueFields,
+                groove_data::KeyOrdering::ORDERING_SORT);
             if (createFrameResult.isStatus())
                 break;
             auto frame = createFrameResult.getResult();